@@ -3287,8 +3287,18 @@ void idCollisionModelManagerLocal::BuildModels( const idMapFile *mapFile ) {
 	timer.Start();
 
 	if ( !LoadCollisionModelFile( mapFile->GetName(), mapFile->GetGeometryCRC() ) ) {
+		idMapFile *fullMapFile = NULL;
+
+		// the map may have been loaded from the entity cache without brushes and patches
+		if ( !mapFile->HasPrimitiveData() ) {
+			fullMapFile = new idMapFile;
+			if ( fullMapFile->Parse( mapFile->GetName() ) ) {
+				mapFile = fullMapFile;
+			}
+		}
 
 		if ( !mapFile->GetNumEntities() ) {
+			delete fullMapFile;
 			return;
 		}
 
@@ -3315,6 +3325,8 @@ void idCollisionModelManagerLocal::BuildModels( const idMapFile *mapFile ) {
 
 		// write the collision models to a file
 		WriteCollisionModelsToFile( mapFile->GetName(), 0, numModels, mapFile->GetGeometryCRC() );
+
+		delete fullMapFile;
 	}
 
 	timer.Stop();
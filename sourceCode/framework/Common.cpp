@@ -84,6 +84,7 @@ idCVar com_asyncSound( "com_asyncSound", "1", CVAR_INTEGER|CVAR_SYSTEM, ASYNCSOU
 #endif
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL | CVAR_SYSTEM | CVAR_NOCHEAT, "force generic platform independent SIMD" );
+idCVar com_jobThreads( "com_jobThreads", "-1", CVAR_INTEGER | CVAR_SYSTEM | CVAR_INIT, "number of worker threads for parallel jobs, -1 = one per additional core", -1, MAX_JOB_THREADS );
 idCVar com_developer( "developer", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "developer mode" );
 idCVar com_allowConsole( "com_allowConsole", "0", CVAR_BOOL | CVAR_SYSTEM | CVAR_NOCHEAT, "allow toggling console with the tilde key" );
 idCVar com_speeds( "com_speeds", "0", CVAR_BOOL|CVAR_SYSTEM|CVAR_NOCHEAT, "show engine timings" );
@@ -2343,6 +2344,7 @@ void idCommonLocal::InitCommands( void ) {
 	cmdSystem->AddCommand( "showDictMemory", idDict::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by dictionaries" );
 	cmdSystem->AddCommand( "listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries" );
 	cmdSystem->AddCommand( "listDictValues", idDict::ListValues_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all values used by dictionaries" );
+	cmdSystem->AddCommand( "testDict", idDict::Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "test dictionaries" );
 	cmdSystem->AddCommand( "testSIMD", idSIMD::Test_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "test SIMD code" );
 
 	// localization
@@ -2409,6 +2411,10 @@ idCommonLocal::Frame
 */
 void idCommonLocal::Frame( void ) {
 	try {
+		// picks up com_profiler changes and writes a trace if the last frame took too long
+		profiler->EndFrame();
+
+		idScopedProfileZone profileZone( "Frame" );
 
 		// pump all the events
 		Sys_GenerateEvents();
@@ -2645,6 +2651,8 @@ void idCommonLocal::LoadGameDLL( void ) {
 	gameImport.declManager				= ::declManager;
 	gameImport.AASFileManager			= ::AASFileManager;
 	gameImport.collisionModelManager	= ::collisionModelManager;
+	gameImport.profiler					= ::profiler;
+	gameImport.parallelJobManager		= ::parallelJobManager;
 
 	gameExport							= *GetGameAPI( &gameImport );
 
@@ -2747,6 +2755,7 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline )
 		idLib::common		= common;
 		idLib::cvarSystem	= cvarSystem;
 		idLib::fileSystem	= fileSystem;
+		idLib::profiler		= profiler;
 
 		// initialize idLib
 		idLib::Init();
@@ -2803,9 +2812,15 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline )
 		// initialize processor specific SIMD implementation
 		InitSIMD();
 
+		// start the worker threads used by parallel job lists
+		parallelJobManager->Init( com_jobThreads.GetInteger() );
+
 		// init commands
 		InitCommands();
 
+		// register the profiler commands and the main thread
+		profiler->Init();
+
 #ifdef ID_WRITE_VERSION
 		config_compressor = idCompressor::AllocArithmetic();
 #endif
@@ -2883,6 +2898,12 @@ void idCommonLocal::Shutdown( void ) {
 	warningCaption.Clear();
 	errorList.Clear();
 
+	// stop the parallel job threads
+	parallelJobManager->Shutdown();
+
+	// free the profiler zones, all other threads have stopped by now
+	profiler->Shutdown();
+
 	// enable leak test
 	Mem_EnableLeakTest( "tdm_main" );
 
@@ -121,6 +121,8 @@ protected:
 
 								// Set textSource possible with compression.
 	void						SetTextLocal( const char *text, const int length );
+								// Set textSource from text that was already compressed with CompressDeclText.
+	void						SetCompressedTextLocal( const byte *compressed, const int compressedLength, const int length, const int checksum );
 
 private:
 	idDecl *					self;
@@ -146,13 +148,18 @@ private:
 	idDeclLocal *				nextInFile;				// next decl in the decl file
 };
 
+class idDeclFileScan;
+
 class idDeclFile {
 public:
 								idDeclFile();
 								idDeclFile( const char *fileName, declType_t defaultType );
 
 	void						Reload( bool force );
+	bool						NeedsReload( void ) const;
 	int							LoadAndParse();
+								// adds the declarations found by a scan of this file to the decl manager
+	void						Merge( const idDeclFileScan &scan );
 
 public:
 	idStr						fileName;
@@ -166,6 +173,55 @@ public:
 	idDeclLocal *				decls;
 };
 
+typedef struct declScanEntry_s {
+	declType_t					type;
+	const idPoolStr *			name;
+	int							sourceTextOffset;
+	int							sourceTextLength;
+	int							sourceLine;
+	int							checksum;				// checksum of the decl text
+	int							compressedOffset;		// offset in idDeclFileScan::compressedText
+	int							compressedLength;
+} declScanEntry_t;
+
+/*
+	The text of a decl file split into declarations. Scanning only reads the decl type
+	list of the manager, so several files can be scanned in parallel. The results are
+	added to the manager with idDeclFile::Merge on the main thread.
+
+	Scans are stored in the decl index files, so unchanged decl files don't have to be
+	read and scanned again on the next start.
+*/
+class idDeclFileScan {
+public:
+								idDeclFileScan( idDeclFile *file );
+								~idDeclFileScan( void );
+
+								// file system access is not thread safe, this has to be called from the main thread
+	bool						ReadFile( void );
+	void						Scan( bool quiet );
+	static void					ScanJob( void *data );
+
+	bool						ReadIndex( idFile *f );
+	void						WriteIndex( idFile *f ) const;
+
+public:
+	idDeclFile *				file;
+	idStr						fileName;
+	idStr						sourcePath;			// full path of the source file, only set when the decl index is used
+	int							timestamp;
+	int							pakChecksum;		// checksum of the pk4 holding the source file, 0 for loose files
+	char *						buffer;
+	int							length;
+	int							checksum;
+	int							numLines;
+	bool						hadDiagnostics;		// set by a quiet scan if there were warnings or errors
+	bool						fromIndex;
+	idList<declScanEntry_t>		decls;
+	idStrPool					names;
+	idList<byte>				compressedText;
+};
+
 class idDeclManagerLocal : public idDeclManager {
 	friend class idDeclLocal;
 
@@ -207,6 +263,10 @@ public:
 	virtual const idDeclSkin *		SkinByIndex( int index, bool forceParse = true );
 	virtual const idSoundShader *	SoundByIndex( int index, bool forceParse = true );
 
+	void						LoadDeclFiles( const idList<idDeclFile *> &files, const char *description, const char *indexName = NULL );
+	void						ReadDeclIndex( const char *indexName, idList<idDeclFileScan *> &scans ) const;
+	void						WriteDeclIndex( const char *indexName, const idList<idDeclFileScan *> &scans ) const;
+
 public:
 	static void					MakeNameCanonical( const char *name, char *result, int maxLength );
 	idDeclLocal *				FindTypeWithoutParsing( declType_t type, const char *name, bool makeDefault = true );
@@ -229,6 +289,8 @@ private:
 	bool						insideLevelLoad;
 
 	static idCVar				decl_show;
+	static idCVar				decl_parallelLoad;
+	static idCVar				decl_useIndex;
 
 private:
 	static void					ListDecls_f( const idCmdArgs &args );
@@ -237,6 +299,11 @@ private:
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar idDeclManagerLocal::decl_parallelLoad( "decl_parallelLoad", "1", CVAR_SYSTEM | CVAR_BOOL, "split decl files into declarations on the parallel job threads" );
+idCVar idDeclManagerLocal::decl_useIndex( "decl_useIndex", "1", CVAR_SYSTEM | CVAR_BOOL, "keep an index of the decls in each decl folder so unchanged decl files are not scanned again" );
+
+#define DECL_INDEX_ID				"DIDX"
+#define DECL_INDEX_VERSION			2
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager *		declManager = &declManagerLocal;
@@ -458,8 +525,6 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 	int i, j;
 	idBitMsg msg;
 
-	totalUncompressedLength += textLength;
-
 	msg.Init( compressed, maxCompressedSize );
 	msg.BeginWriting();
 	for ( i = 0; i < textLength; i++ ) {
@@ -472,11 +537,41 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 		}
 	}
 
-	totalCompressedLength += msg.GetSize();
-
 	return msg.GetSize();
 }
 
+/*
+================
+CompressDeclText
+
+Appends the compressed text to the given buffer and returns the compressed length.
+Only GET_HUFFMAN_FREQUENCIES touches global state, so this can be called from jobs.
+================
+*/
+static int CompressDeclText( const char *text, const int length, idList<byte> &compressed ) {
+	int offset = compressed.Num();
+
+#ifdef GET_HUFFMAN_FREQUENCIES
+	for( int i = 0; i < length; i++ ) {
+		huffmanFrequencies[((const unsigned char *)text)[i]]++;
+	}
+#endif
+
+#ifdef USE_COMPRESSED_DECLS
+	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
+	compressed.AssureSize( offset + length * maxBytesPerCode );
+	int compressedLength = HuffmanCompressText( text, length, compressed.Ptr() + offset, length * maxBytesPerCode );
+	compressed.SetNum( offset + compressedLength, false );
+#else
+	int compressedLength = length;
+	compressed.AssureSize( offset + length + 1 );
+	memcpy( compressed.Ptr() + offset, text, length );
+	compressed[offset + length] = '\0';
+#endif
+
+	return compressedLength;
+}
+
 /*
 ================
 HuffmanDecompressText
@@ -570,17 +665,31 @@ ForceReload will cause it to reload even if the timestamp hasn't changed
 */
 void idDeclFile::Reload( bool force ) {
 	// check for an unchanged timestamp
-	if ( !force && timestamp != 0 ) {
+	if ( !force && !NeedsReload() ) {
+		return;
+	}
+
+	// parse the text
+	LoadAndParse();
+}
+
+/*
+================
+idDeclFile::NeedsReload
+
+Returns true if the file was never loaded or the timestamp has changed
+================
+*/
+bool idDeclFile::NeedsReload( void ) const {
+	if ( timestamp != 0 ) {
 		ID_TIME_T	testTimeStamp;
 		fileSystem->ReadFile( fileName, NULL, &testTimeStamp );
 
 		if ( testTimeStamp == timestamp ) {
-			return;
+			return false;
 		}
 	}
-
-	// parse the text
-	LoadAndParse();
+	return true;
 }
 
 /*
@@ -593,41 +702,266 @@ This is used during both the initial load, and any reloads
 int c_savedMemory = 0;
 
 int idDeclFile::LoadAndParse() {
-	int			i, numTypes;
-	idLexer		src;
-	idToken		token;
-	int			startMarker;
-	char *		buffer;
-	int			length, size;
-	int			sourceLine;
-	idStr		name;
+	idDeclFileScan scan( this );
+
+	if ( !scan.ReadFile() ) {
+		return 0;
+	}
+
+	scan.Scan( false );
+	Merge( scan );
+
+	return checksum;
+}
+
+/*
+================
+idDeclFile::Merge
+================
+*/
+void idDeclFile::Merge( const idDeclFileScan &scan ) {
 	idDeclLocal *newDecl;
 	bool		reparse;
 
+	assert( scan.file == this );
+
+	// mark all the defs that were from the last reload of this file
+	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
+		decl->redefinedInReload = false;
+	}
+
+	checksum = scan.checksum;
+
+	fileSize = scan.length;
+
+	for ( int i = 0; i < scan.decls.Num(); i++ ) {
+		const declScanEntry_t &entry = scan.decls[i];
+
+		// look it up, possibly getting a newly created default decl
+		reparse = false;
+		newDecl = declManagerLocal.FindTypeWithoutParsing( entry.type, entry.name->c_str(), false );
+		if ( newDecl ) {
+			// update the existing copy
+			if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), entry.sourceLine,
+								declManagerLocal.GetDeclNameFromType( entry.type ), entry.name->c_str(),
+								newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+				continue;
+			}
+			if ( newDecl->declState != DS_UNPARSED ) {
+				reparse = true;
+			}
+		} else {
+			// allow it to be created as a default, then add it to the per-file list
+			newDecl = declManagerLocal.FindTypeWithoutParsing( entry.type, entry.name->c_str(), true );
+			newDecl->nextInFile = this->decls;
+			this->decls = newDecl;
+		}
+
+		newDecl->redefinedInReload = true;
+
+		newDecl->SetCompressedTextLocal( scan.compressedText.Ptr() + entry.compressedOffset, entry.compressedLength, entry.sourceTextLength, entry.checksum );
+		newDecl->sourceFile = this;
+		newDecl->sourceTextOffset = entry.sourceTextOffset;
+		newDecl->sourceTextLength = entry.sourceTextLength;
+		newDecl->sourceLine = entry.sourceLine;
+		newDecl->declState = DS_UNPARSED;
+
+		// if it is currently in use, reparse it immedaitely
+		if ( reparse ) {
+			newDecl->ParseLocal();
+		}
+	}
+
+	numLines = scan.numLines;
+
+	// any defs that weren't redefinedInReload should now be defaulted
+	for ( idDeclLocal *decl = decls ; decl ; decl = decl->nextInFile ) {
+		if ( decl->redefinedInReload == false ) {
+			decl->MakeDefault();
+			decl->sourceTextOffset = decl->sourceFile->fileSize;
+			decl->sourceTextLength = 0;
+			decl->sourceLine = decl->sourceFile->numLines;
+		}
+	}
+}
+
+/*
+====================================================================================
+
+ idDeclFileScan
+
+====================================================================================
+*/
+
+/*
+================
+idDeclFileScan::idDeclFileScan
+================
+*/
+idDeclFileScan::idDeclFileScan( idDeclFile *file ) {
+	this->file = file;
+	if ( file ) {
+		fileName = file->fileName;
+	}
+	timestamp = 0;
+	pakChecksum = 0;
+	buffer = NULL;
+	length = 0;
+	checksum = 0;
+	numLines = 0;
+	hadDiagnostics = false;
+	fromIndex = false;
+	decls.SetGranularity( 256 );
+	compressedText.SetGranularity( 65536 );
+}
+
+/*
+================
+idDeclFileScan::~idDeclFileScan
+================
+*/
+idDeclFileScan::~idDeclFileScan( void ) {
+	if ( buffer ) {
+		Mem_Free( buffer );
+	}
+	decls.Clear();
+	names.Clear();
+}
+
+/*
+================
+idDeclFileScan::ReadFile
+================
+*/
+bool idDeclFileScan::ReadFile( void ) {
 	// load the text
-	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
-	length = fileSystem->ReadFile( fileName, (void **)&buffer, &timestamp );
+	common->DPrintf( "...loading '%s'\n", file->fileName.c_str() );
+	length = fileSystem->ReadFile( file->fileName, (void **)&buffer, &file->timestamp );
 	if ( length == -1 ) {
-		common->FatalError( "couldn't load %s", fileName.c_str() );
-		return 0;
+		buffer = NULL;
+		common->FatalError( "couldn't load %s", file->fileName.c_str() );
+		return false;
 	}
+	timestamp = (int)file->timestamp;
+	return true;
+}
 
-	if ( !src.LoadMemory( buffer, length, fileName ) ) {
-		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
-		return 0;
+/*
+================
+idDeclFileScan::ReadIndex
+================
+*/
+bool idDeclFileScan::ReadIndex( idFile *f ) {
+	int i, num, type;
+	idStr name;
+
+	f->ReadString( fileName );
+	f->ReadString( sourcePath );
+	f->ReadInt( timestamp );
+	f->ReadInt( pakChecksum );
+	f->ReadInt( length );
+	f->ReadInt( checksum );
+	f->ReadInt( numLines );
+
+	f->ReadInt( num );
+	if ( num < 0 || num > f->Length() ) {
+		return false;
+	}
+	decls.SetNum( num );
+	for ( i = 0; i < num; i++ ) {
+		declScanEntry_t &entry = decls[i];
+		f->ReadInt( type );
+		if ( type < 0 || type >= declManagerLocal.GetNumDeclTypes() ) {
+			return false;
+		}
+		entry.type = (declType_t)type;
+		f->ReadString( name );
+		entry.name = names.AllocString( name );
+		f->ReadInt( entry.sourceTextOffset );
+		f->ReadInt( entry.sourceTextLength );
+		f->ReadInt( entry.sourceLine );
+		f->ReadInt( entry.checksum );
+		f->ReadInt( entry.compressedOffset );
+		f->ReadInt( entry.compressedLength );
+	}
+
+	f->ReadInt( num );
+	if ( num < 0 || num > f->Length() ) {
+		return false;
+	}
+	compressedText.SetNum( num );
+	if ( f->Read( compressedText.Ptr(), num ) != num ) {
+		return false;
 	}
 
-	// mark all the defs that were from the last reload of this file
-	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
-		decl->redefinedInReload = false;
+	for ( i = 0; i < decls.Num(); i++ ) {
+		if ( decls[i].compressedOffset < 0 || decls[i].compressedLength < 0 || decls[i].compressedOffset + decls[i].compressedLength > num ) {
+			return false;
+		}
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
+	fromIndex = true;
+	return true;
+}
 
-	checksum = MD5_BlockChecksum( buffer, length );
+/*
+================
+idDeclFileScan::WriteIndex
+================
+*/
+void idDeclFileScan::WriteIndex( idFile *f ) const {
+	f->WriteString( fileName );
+	f->WriteString( sourcePath );
+	f->WriteInt( timestamp );
+	f->WriteInt( pakChecksum );
+	f->WriteInt( length );
+	f->WriteInt( checksum );
+	f->WriteInt( numLines );
 
-	fileSize = length;
+	f->WriteInt( decls.Num() );
+	for ( int i = 0; i < decls.Num(); i++ ) {
+		const declScanEntry_t &entry = decls[i];
+		f->WriteInt( (int)entry.type );
+		f->WriteString( entry.name->c_str() );
+		f->WriteInt( entry.sourceTextOffset );
+		f->WriteInt( entry.sourceTextLength );
+		f->WriteInt( entry.sourceLine );
+		f->WriteInt( entry.checksum );
+		f->WriteInt( entry.compressedOffset );
+		f->WriteInt( entry.compressedLength );
+	}
+
+	f->WriteInt( compressedText.Num() );
+	f->Write( compressedText.Ptr(), compressedText.Num() );
+}
+
+/*
+================
+idDeclFileScan::Scan
+
+Identifies each individual declaration in the file text. A quiet scan does not
+print anything, it only flags that there were warnings or errors so the file can
+be scanned again on the main thread to report them.
+================
+*/
+void idDeclFileScan::Scan( bool quiet ) {
+	int			i, numTypes;
+	idLexer		src;
+	idToken		token;
+	int			startMarker;
+	int			size;
+	int			sourceLine;
+	idStr		name;
+
+	decls.SetNum( 0, false );
+	names.Clear();
+	compressedText.SetNum( 0, false );
+
+	src.LoadMemory( buffer, length, file->fileName );
+	src.SetFlags( DECL_LEXER_FLAGS | ( quiet ? ( LEXFL_NOWARNINGS | LEXFL_NOERRORS ) : 0 ) );
+
+	checksum = MD5_BlockChecksum( buffer, length );
 
 	// scan through, identifying each individual declaration
 	while( 1 ) {
@@ -663,13 +997,13 @@ int idDeclFile::LoadAndParse() {
 
 			} else {
 
-				if ( defaultType == DECL_MAX_TYPES ) {
+				if ( file->defaultType == DECL_MAX_TYPES ) {
 					src.Warning( "No type" );
 					continue;
 				}
 				src.UnreadToken( &token );
 				// use the default type
-				identifiedType = defaultType;
+				identifiedType = file->defaultType;
 			}
 		}
 
@@ -709,61 +1043,28 @@ int idDeclFile::LoadAndParse() {
 		src.SkipBracedSection();
 		size = src.GetFileOffset() - startMarker;
 
-		// look it up, possibly getting a newly created default decl
-		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
-		if ( newDecl ) {
-			// update the existing copy
-			if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-								name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
-				continue;
-			}
-			if ( newDecl->declState != DS_UNPARSED ) {
-				reparse = true;
-			}
-		} else {
-			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
-			newDecl->nextInFile = this->decls;
-			this->decls = newDecl;
-		}
-
-		newDecl->redefinedInReload = true;
-
-		if ( newDecl->textSource ) {
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
-		}
-
-		newDecl->SetTextLocal( buffer + startMarker, size );
-		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
-		newDecl->declState = DS_UNPARSED;
-
-		// if it is currently in use, reparse it immedaitely
-		if ( reparse ) {
-			newDecl->ParseLocal();
-		}
+		declScanEntry_t &entry = decls.Alloc();
+		entry.type = identifiedType;
+		entry.name = names.AllocString( name );
+		entry.sourceTextOffset = startMarker;
+		entry.sourceTextLength = size;
+		entry.sourceLine = sourceLine;
+		entry.checksum = MD5_BlockChecksum( buffer + startMarker, size );
+		entry.compressedOffset = compressedText.Num();
+		entry.compressedLength = CompressDeclText( buffer + startMarker, size, compressedText );
 	}
 
 	numLines = src.GetLineNum();
+	hadDiagnostics = src.HadError() || src.HadWarning();
+}
 
-	Mem_Free( buffer );
-
-	// any defs that weren't redefinedInReload should now be defaulted
-	for ( idDeclLocal *decl = decls ; decl ; decl = decl->nextInFile ) {
-		if ( decl->redefinedInReload == false ) {
-			decl->MakeDefault();
-			decl->sourceTextOffset = decl->sourceFile->fileSize;
-			decl->sourceTextLength = 0;
-			decl->sourceLine = decl->sourceFile->numLines;
-		}
-	}
-
-	return checksum;
+/*
+================
+idDeclFileScan::ScanJob
+================
+*/
+void idDeclFileScan::ScanJob( void *data ) {
+	static_cast<idDeclFileScan *>( data )->Scan( true );
 }
 
 /*
@@ -887,9 +1188,15 @@ idDeclManagerLocal::Reload
 ===================
 */
 void idDeclManagerLocal::Reload( bool force ) {
+	idList<idDeclFile *> changedFiles;
+
 	for ( int i = 0; i < loadedFiles.Num(); i++ ) {
-		loadedFiles[i]->Reload( force );
+		if ( force || loadedFiles[i]->NeedsReload() ) {
+			changedFiles.Append( loadedFiles[i] );
+		}
 	}
+
+	LoadDeclFiles( changedFiles, "reload" );
 }
 
 /*
@@ -958,6 +1265,7 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 	idDeclFolder *declFolder;
 	idFileList *fileList;
 	idDeclFile *df;
+	idList<idDeclFile *> files;
 
 	// check whether this folder / extension combination already exists
 	for ( i = 0; i < declFolders.Num(); i++ ) {
@@ -994,10 +1302,255 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 			df = new idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		files.Append( df );
 	}
 
 	fileSystem->FreeFileList( fileList );
+
+	// one index per folder / extension combination
+	idStr indexName = declFolder->folder + "_" + declFolder->extension;
+	indexName.Replace( '/', '_' );
+	indexName.Remove( "." );
+	indexName = "declcache/" + indexName + ".idx";
+
+	LoadDeclFiles( files, va( "%s/*%s", declFolder->folder.c_str(), declFolder->extension.c_str() ), indexName );
+}
+
+/*
+===================
+idDeclManagerLocal::LoadDeclFiles
+
+Reads the files on the main thread, splits them into declarations on the parallel
+job threads and merges the results in list order, so the decls end up exactly as
+if the files were loaded one after another.
+
+If an index name is given, files that did not change since the index was written
+are taken from the index. Files in pk4s are not read at all, loose files are only
+read to compare their checksum.
+===================
+*/
+void idDeclManagerLocal::LoadDeclFiles( const idList<idDeclFile *> &files, const char *description, const char *indexName ) {
+	int i, j;
+
+	if ( files.Num() == 0 ) {
+		return;
+	}
+
+	const int startTime = Sys_Milliseconds();
+	const idStr desc = description;
+	const bool parallel = decl_parallelLoad.GetBool() && parallelJobManager->GetNumThreads() > 0 && files.Num() > 1;
+	const bool useIndex = ( indexName != NULL && decl_useIndex.GetBool() );
+
+	idList<idDeclFileScan *> scans;
+	idList<idDeclFileScan *> indexScans;
+	idParallelJobList jobList( "declScan" );
+	int numFromIndex = 0;
+
+	if ( useIndex ) {
+		ReadDeclIndex( indexName, indexScans );
+	}
+
+	idHashIndex indexHash( 1024, Max( indexScans.Num(), 1 ) );
+	for ( j = 0; j < indexScans.Num(); j++ ) {
+		indexHash.Add( indexHash.GenerateKey( indexScans[j]->fileName, false ), j );
+	}
+
+	scans.SetNum( files.Num() );
+	for ( i = 0; i < files.Num(); i++ ) {
+		fileStat_t stat;
+		idDeclFileScan *indexScan = NULL;
+
+		// a file is taken from the index if its source, timestamp, length and pk4 checksum are unchanged
+		if ( useIndex && fileSystem->StatFile( files[i]->fileName, stat ) ) {
+			const int hash = indexHash.GenerateKey( files[i]->fileName, false );
+			for ( j = indexHash.First( hash ); j != -1; j = indexHash.Next( j ) ) {
+				if ( indexScans[j] && indexScans[j]->fileName.Icmp( files[i]->fileName ) == 0 ) {
+					break;
+				}
+			}
+			if ( j != -1 && indexScans[j]->sourcePath == stat.fullPath && indexScans[j]->timestamp == (int)stat.timestamp &&
+					indexScans[j]->length == stat.length && indexScans[j]->pakChecksum == stat.pakChecksum ) {
+				indexScan = indexScans[j];
+				indexScans[j] = NULL;
+			}
+		}
+
+		// zip timestamps only have a two second resolution, the pk4 checksum covers files in pk4s
+		if ( indexScan && stat.pakChecksum != 0 ) {
+			scans[i] = indexScan;
+			scans[i]->file = files[i];
+			files[i]->timestamp = stat.timestamp;
+			numFromIndex++;
+			continue;
+		}
+
+		scans[i] = new idDeclFileScan( files[i] );
+		scans[i]->sourcePath = stat.fullPath;
+		scans[i]->pakChecksum = stat.pakChecksum;
+		if ( !scans[i]->ReadFile() ) {
+			delete indexScan;
+			continue;
+		}
+
+		// loose files have to be read to compare the checksum of the text
+		if ( indexScan && indexScan->checksum == MD5_BlockChecksum( scans[i]->buffer, scans[i]->length ) ) {
+			delete scans[i];
+			scans[i] = indexScan;
+			scans[i]->file = files[i];
+			numFromIndex++;
+			continue;
+		}
+		delete indexScan;
+
+		if ( parallel ) {
+			jobList.AddJob( idDeclFileScan::ScanJob, scans[i] );
+		} else {
+			scans[i]->Scan( false );
+		}
+	}
+
+	if ( parallel ) {
+		jobList.Submit();
+		jobList.Wait();
+	}
+
+	for ( i = 0; i < files.Num(); i++ ) {
+		if ( scans[i]->buffer == NULL && !scans[i]->fromIndex ) {
+			continue;
+		}
+		// the jobs can't print, scan again to report the warnings in order
+		if ( scans[i]->hadDiagnostics ) {
+			scans[i]->Scan( false );
+		}
+		files[i]->Merge( *scans[i] );
+	}
+
+	// rewrite the index if any file was scanned or removed
+	if ( useIndex && ( numFromIndex != files.Num() || numFromIndex != indexScans.Num() ) ) {
+		WriteDeclIndex( indexName, scans );
+	}
+
+	scans.DeleteContents( true );
+	indexScans.DeleteContents( true );
+
+	if ( parallel ) {
+		common->Printf( "...%d decl files from %s in %d msec, %d from index (%.1f msec scanning on %d threads)\n", files.Num(), desc.c_str(),
+						Sys_Milliseconds() - startTime, numFromIndex, jobList.GetLastRunTime(), parallelJobManager->GetNumThreads() + 1 );
+	} else {
+		common->Printf( "...%d decl files from %s in %d msec, %d from index\n", files.Num(), desc.c_str(), Sys_Milliseconds() - startTime, numFromIndex );
+	}
+}
+
+/*
+===================
+idDeclManagerLocal::ReadDeclIndex
+
+Returns the scans stored in the index, or an empty list if the index is missing or outdated.
+===================
+*/
+void idDeclManagerLocal::ReadDeclIndex( const char *indexName, idList<idDeclFileScan *> &scans ) const {
+	char	id[4];
+	int		i, version, num, value;
+	idStr	typeName;
+
+	scans.Clear();
+
+	idFile *f = fileSystem->OpenFileRead( indexName );
+	if ( f == NULL ) {
+		return;
+	}
+
+	f->Read( id, sizeof( id ) );
+	f->ReadInt( version );
+	if ( memcmp( id, DECL_INDEX_ID, sizeof( id ) ) != 0 || version != DECL_INDEX_VERSION ) {
+		fileSystem->CloseFile( f );
+		return;
+	}
+
+	// the compressed decl text can only be used with the same huffman codes
+	f->ReadInt( value );
+#ifdef USE_COMPRESSED_DECLS
+	if ( value != maxHuffmanBits ) {
+#else
+	if ( value != 0 ) {
+#endif
+		fileSystem->CloseFile( f );
+		return;
+	}
+
+	// the decl types are stored by number
+	f->ReadInt( num );
+	if ( num != declTypes.Num() ) {
+		fileSystem->CloseFile( f );
+		return;
+	}
+	for ( i = 0; i < num; i++ ) {
+		f->ReadString( typeName );
+		if ( typeName.Cmp( declTypes[i] ? declTypes[i]->typeName.c_str() : "" ) != 0 ) {
+			fileSystem->CloseFile( f );
+			return;
+		}
+	}
+
+	num = 0;
+	f->ReadInt( num );
+	for ( i = 0; i < num; i++ ) {
+		idDeclFileScan *scan = new idDeclFileScan( NULL );
+		if ( !scan->ReadIndex( f ) ) {
+			common->Warning( "decl index %s is damaged", indexName );
+			delete scan;
+			scans.DeleteContents( true );
+			break;
+		}
+		scans.Append( scan );
+	}
+
+	fileSystem->CloseFile( f );
+}
+
+/*
+===================
+idDeclManagerLocal::WriteDeclIndex
+
+Files with warnings or errors are not indexed, so the diagnostics are printed on every load.
+===================
+*/
+void idDeclManagerLocal::WriteDeclIndex( const char *indexName, const idList<idDeclFileScan *> &scans ) const {
+	int i, num;
+
+	idFile *f = fileSystem->OpenFileWrite( indexName );
+	if ( f == NULL ) {
+		common->Warning( "couldn't write decl index %s", indexName );
+		return;
+	}
+
+	f->Write( DECL_INDEX_ID, 4 );
+	f->WriteInt( DECL_INDEX_VERSION );
+#ifdef USE_COMPRESSED_DECLS
+	f->WriteInt( maxHuffmanBits );
+#else
+	f->WriteInt( 0 );
+#endif
+
+	f->WriteInt( declTypes.Num() );
+	for ( i = 0; i < declTypes.Num(); i++ ) {
+		f->WriteString( declTypes[i] ? declTypes[i]->typeName.c_str() : "" );
+	}
+
+	num = 0;
+	for ( i = 0; i < scans.Num(); i++ ) {
+		if ( !scans[i]->hadDiagnostics && scans[i]->sourcePath.Length() ) {
+			num++;
+		}
+	}
+	f->WriteInt( num );
+	for ( i = 0; i < scans.Num(); i++ ) {
+		if ( !scans[i]->hadDiagnostics && scans[i]->sourcePath.Length() ) {
+			scans[i]->WriteIndex( f );
+		}
+	}
+
+	fileSystem->CloseFile( f );
 }
 
 /*
@@ -1886,29 +2439,34 @@ idDeclLocal::SetTextLocal
 =================
 */
 void idDeclLocal::SetTextLocal( const char *text, const int length ) {
+	idList<byte> compressed;
 
-	Mem_Free( textSource );
+	int compressedLength = CompressDeclText( text, length, compressed );
+	SetCompressedTextLocal( compressed.Ptr(), compressedLength, length, MD5_BlockChecksum( text, length ) );
+}
 
-	checksum = MD5_BlockChecksum( text, length );
+/*
+=================
+idDeclLocal::SetCompressedTextLocal
+=================
+*/
+void idDeclLocal::SetCompressedTextLocal( const byte *compressed, const int compressedLength, const int length, const int checksum ) {
 
-#ifdef GET_HUFFMAN_FREQUENCIES
-	for( int i = 0; i < length; i++ ) {
-		huffmanFrequencies[((const unsigned char *)text)[i]]++;
-	}
-#endif
+	Mem_Free( textSource );
+
+	this->checksum = checksum;
 
 #ifdef USE_COMPRESSED_DECLS
-	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
-	byte *compressed = (byte *)_alloca( length * maxBytesPerCode );
-	compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
 	textSource = (char *)Mem_Alloc( compressedLength );
 	memcpy( textSource, compressed, compressedLength );
+
+	totalUncompressedLength += length;
+	totalCompressedLength += compressedLength;
 #else
-	compressedLength = length;
 	textSource = (char *) Mem_Alloc( length + 1 );
-	memcpy( textSource, text, length );
-	textSource[length] = '\0';
+	memcpy( textSource, compressed, length + 1 );
 #endif
+	this->compressedLength = compressedLength;
 	textLength = length;
 }
 
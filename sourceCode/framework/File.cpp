@@ -1361,14 +1361,20 @@ int idFile_InZip::Seek( long offset, fsOrigin_t origin ) {
 			offset = fileSize - offset;
 		}
 		case FS_SEEK_SET: {
-			// set the file position in the zip file (also sets the current file info)
-			unzSetCurrentFileInfoPosition( z, zipFilePos );
+			// restart the file, the current file info was set when the file was opened
 			unzOpenCurrentFile( z );
 			if ( offset <= 0 ) {
 				return 0;
 			}
 		}
 		case FS_SEEK_CUR: {
+			// stored files are skipped without reading
+			if ( offset > 0 ) {
+				res = unzSkipCurrentFile( z, offset );
+				if ( res >= 0 ) {
+					return ( res == offset ) ? 0 : -1;
+				}
+			}
 			buf = (char *) _alloca16( ZIP_SEEK_BUF_SIZE );
 			for ( i = 0; i < ( offset - ZIP_SEEK_BUF_SIZE ); i += ZIP_SEEK_BUF_SIZE ) {
 				res = unzReadCurrentFile( z, buf, ZIP_SEEK_BUF_SIZE );
@@ -43,6 +43,10 @@ static bool versioned = RegisterVersionedFile("$Id: FileSystem.cpp 5918 2013-12-
 	#include "../include/curl/curl.h"
 #endif
 
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
 /*
 =============================================================================
 
@@ -128,6 +132,14 @@ in search order, fs_mod > BASE_TDM
 typedef struct fileInPack_s {
 	idStr				name;						// name of the file
 	unsigned long		pos;						// file info position in zip
+	unsigned long		offset;						// position of the local file header in zip
+	unsigned long		crc;
+	unsigned long		dosDate;
+	unsigned long		compressedSize;
+	unsigned long		uncompressedSize;
+	unsigned short		compressionMethod;			// 0 = stored
+	unsigned short		flag;
+	unsigned short		nameLength;					// length of the name in the zip headers
 	struct fileInPack_s * next;						// next file in the hash
 } fileInPack_t;
 
@@ -163,6 +175,29 @@ typedef struct {
 	idStr				gamedir;					// base
 } directory_t;
 
+typedef enum {
+	PREFETCH_PENDING,								// waiting to be opened by the main thread
+	PREFETCH_QUEUED,								// opened and buffer allocated, waiting for a prefetch job
+	PREFETCH_READING,								// being read by a prefetch job
+	PREFETCH_DONE,									// the data is ready
+	PREFETCH_FAILED,
+	PREFETCH_USED									// the data was handed out, or the file was read without it
+} prefetchState_t;
+
+typedef struct {
+	idStr				relativePath;
+	prefetchState_t		state;
+	pack_t *			pak;						// NULL for loose files
+	fileInPack_t *		pakFile;
+	idFile *			file;						// only opened for a limited number of files at a time
+	int					length;
+	ID_TIME_T			timestamp;
+	byte *				buffer;						// allocated by the main thread when the file is opened
+} prefetchFile_t;
+
+// the prefetch jobs read ahead within this window of open files
+#define MAX_PREFETCH_OPEN_FILES		32
+
 typedef struct searchpath_s {
 	pack_t *			pack;						// only one of pack / dir will be non NULL
 	directory_t *		dir;
@@ -221,6 +256,9 @@ public:
 	virtual int				GetOSMask( void );
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp );
 	virtual void			FreeFile( void *buffer );
+	virtual bool			StatFile( const char *relativePath, fileStat_t &stat );
+	virtual bool			PrefetchFile( const char *relativePath );
+	virtual void			ClearPrefetch( void );
 	virtual int				WriteFile( const char *relativePath, const void *buffer, int size, const char *basePath = "fs_modSavePath", const char *gamedir = NULL);
 	virtual void			RemoveFile( const char *relativePath );	
     virtual idFile *		OpenFileReadFlags( const char *relativePath, int searchFlags, pack_t **foundInPak = NULL, const char* gamedir = NULL );
@@ -254,6 +292,7 @@ public:
 	static void				Path_f( const idCmdArgs &args );
 	static void				TouchFile_f( const idCmdArgs &args );
 	static void				TouchFileList_f( const idCmdArgs &args );
+	static void				BenchInflate_f( const idCmdArgs &args );
 
 private:
 	friend dword 			BackgroundDownloadThread( void *parms );
@@ -274,6 +313,8 @@ private:
 	static idCVar			fs_devpath;
 	static idCVar			fs_caseSensitiveOS;
 	static idCVar			fs_searchAddons;
+	static idCVar			fs_prefetch;
+	static idCVar			fs_prefetchMemory;
 
     // taaaki: fs_game and fs_game_base have been removed as TDM is no longer a mod and these fs cvars were causing
     // confusion due to inconsistent usage. fs_mod has been added to allow for mods of TDM.
@@ -303,6 +344,29 @@ private:
 	int						dir_cache_index;
 	int						dir_cache_count;
 
+	// files read ahead by jobs on the parallel job threads, all shared state is guarded by prefetchMutex
+	idList<prefetchFile_t *> prefetchFiles;
+	idHashIndex				prefetchHash;
+	int						prefetchNextOpen;		// next file to be opened by the main thread
+	int						prefetchNextSubmit;		// next opened file to be handed to a prefetch job
+	int						prefetchNextClose;		// next file to be closed by the main thread
+	int						prefetchNextSkip;		// next file checked for data the loader moved past
+	int						prefetchNextUse;		// one past the last file handed out by ReadPrefetchedFile
+	int						prefetchNumOpen;
+	int						prefetchMemory;			// bytes read ahead that were not handed out yet
+	int						prefetchMemoryLimit;
+	idParallelJobList		prefetchJobs;			// entries are read and inflated concurrently
+	int						prefetchNumJobsRunning;	// jobs of the submitted list that did not finish yet
+	boost::mutex			prefetchMutex;
+	boost::condition_variable prefetchDone;			// a read has finished
+
+	int						prefetchNumHits;
+	int						prefetchNumWaits;		// hits that had to wait for the read to finish
+	int						prefetchNumMisses;		// read before a prefetch job got to them
+	int						prefetchNumUnused;		// read ahead, but never asked for
+	int						prefetchBytesRead;
+	int						prefetchPeakMemory;
+
 private:
 	void					ReplaceSeparators( idStr &path, char sep = PATHSEPERATOR_CHAR );
 	long					HashFileName( const char *fname ) const;
@@ -326,9 +390,16 @@ private:
 	pack_t *				GetPackForChecksum( int checksum, bool searchAddons = false );
 							// searches all the paks
 	pack_t *				FindPakForFileChecksum( const char *relativePath, int fileChecksum, bool bReference );
-	idFile_InZip *			ReadFileFromZip( pack_t *pak, fileInPack_t *pakFile, const char *relativePath );
+							// systemAlloc files inflate with calloc / free, so they can be read on other threads
+	idFile_InZip *			ReadFileFromZip( pack_t *pak, fileInPack_t *pakFile, const char *relativePath, bool systemAlloc = false );
+	bool					StatFileFlags( const char *relativePath, int searchFlags, fileStat_t &stat, pack_t **foundInPak, fileInPack_t **foundPakFile = NULL );
 	int						GetFileChecksum( idFile *file );
 	addonInfo_t *			ParseAddonDef( const char *buf, const int len );
+
+	static void				PrefetchJob( void *data );
+	bool					PrefetchRead( prefetchFile_t *pf );
+	void					UpdatePrefetch( void );
+	int						ReadPrefetchedFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp );
 	void					FollowAddonDependencies( pack_t *pak );
 
 	static size_t			CurlWriteFunction( void *ptr, size_t size, size_t nmemb, void *stream );
@@ -350,6 +421,8 @@ idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "0", CVAR_SY
 idCVar	idFileSystemLocal::fs_caseSensitiveOS( "fs_caseSensitiveOS", "1", CVAR_SYSTEM | CVAR_BOOL, "" );
 #endif
 idCVar	idFileSystemLocal::fs_searchAddons( "fs_searchAddons", "0", CVAR_SYSTEM | CVAR_BOOL, "search all addon pk4s ( disables addon functionality )" );
+idCVar	idFileSystemLocal::fs_prefetch( "fs_prefetch", "1", CVAR_SYSTEM | CVAR_BOOL, "read files ahead on the parallel job threads during level loads" );
+idCVar	idFileSystemLocal::fs_prefetchMemory( "fs_prefetchMemory", "64", CVAR_SYSTEM | CVAR_INTEGER, "maximum number of megabytes read ahead by the prefetch jobs", 1, 1024 );
 
 // greebo: Custom savepath in darkmod/fms/
 idCVar	idFileSystemLocal::fs_modSavePath( "fs_modSavePath", "", CVAR_SYSTEM | CVAR_INIT, "This is where all screenshots and savegames will be written to." );
@@ -362,7 +435,7 @@ idFileSystem *		fileSystem = &fileSystemLocal;
 idFileSystemLocal::idFileSystemLocal
 ================
 */
-idFileSystemLocal::idFileSystemLocal( void ) {
+idFileSystemLocal::idFileSystemLocal( void ) : prefetchJobs( "fs_prefetch", false ) {
 	searchPaths = NULL;
 	readCount = 0;
 	loadCount = 0;
@@ -373,6 +446,21 @@ idFileSystemLocal::idFileSystemLocal( void ) {
 	restartGamePakChecksum = 0;
 	memset( &backgroundThread, 0, sizeof( backgroundThread ) );
 	addonPaks = NULL;
+	prefetchNextOpen = 0;
+	prefetchNextSubmit = 0;
+	prefetchNextClose = 0;
+	prefetchNextSkip = 0;
+	prefetchNextUse = 0;
+	prefetchNumOpen = 0;
+	prefetchMemory = 0;
+	prefetchMemoryLimit = 0;
+	prefetchNumJobsRunning = 0;
+	prefetchNumHits = 0;
+	prefetchNumWaits = 0;
+	prefetchNumMisses = 0;
+	prefetchNumUnused = 0;
+	prefetchBytesRead = 0;
+	prefetchPeakMemory = 0;
 }
 
 /*
@@ -881,6 +969,8 @@ int idFileSystemLocal::ReadFile( const char *relativePath, void **buffer, ID_TIM
 	int			len;
 	bool		isConfig;
 
+	PROFILE_ZONE( FS_ReadFile );
+
 	if ( !searchPaths ) {
 		common->FatalError( "Filesystem call made without initialization\n" );
 	} else if ( !relativePath || !relativePath[0] ) {
@@ -931,6 +1021,16 @@ int idFileSystemLocal::ReadFile( const char *relativePath, void **buffer, ID_TIM
 		isConfig = false;
 	}
 
+	// use the data if the file was read ahead by the prefetch jobs
+	if ( buffer && prefetchFiles.Num() ) {
+		len = ReadPrefetchedFile( relativePath, (void **)buffer, timestamp );
+		if ( len >= 0 ) {
+			loadCount++;
+			loadStack++;
+			return len;
+		}
+	}
+
 	// look for it in the filesystem or pack files
     f = OpenFileRead( relativePath );
 	if ( f == NULL ) {
@@ -988,6 +1088,448 @@ void idFileSystemLocal::FreeFile( void *buffer ) {
 	Mem_Free( buffer );
 }
 
+/*
+=============
+idFileSystemLocal::StatFile
+=============
+*/
+bool idFileSystemLocal::StatFile( const char *relativePath, fileStat_t &stat ) {
+	return StatFileFlags( relativePath, FSFLAG_SEARCH_DIRS | FSFLAG_SEARCH_PAKS, stat, NULL );
+}
+
+/*
+=============
+idFileSystemLocal::StatFileFlags
+
+Searches like OpenFileReadFlags, but only looks up the pk4 directory entry
+instead of reopening the pk4, and closes a loose file right after the stat.
+=============
+*/
+bool idFileSystemLocal::StatFileFlags( const char *relativePath, int searchFlags, fileStat_t &stat, pack_t **foundInPak, fileInPack_t **foundPakFile ) {
+	searchpath_t *	search;
+	fileInPack_t *	pakFile;
+	long			hash;
+	FILE *			fp;
+
+	if ( !searchPaths ) {
+		common->FatalError( "Filesystem call made without initialization\n" );
+	} else if ( !relativePath ) {
+		common->FatalError( "idFileSystemLocal::StatFile: NULL 'relativePath' parameter passed\n" );
+	} else if ( relativePath[0] == '\0' ) {
+		return false;
+	} else if ( relativePath[0] == '/' || relativePath[0] == '\\' ) { // paths are not supposed to have a leading slash
+		relativePath++;
+	}
+
+	if ( foundInPak ) {
+		*foundInPak = NULL;
+	}
+	if ( foundPakFile ) {
+		*foundPakFile = NULL;
+	}
+
+	if ( strstr( relativePath, ".." ) || strstr( relativePath, "::" ) ) {
+		return false;
+	}
+
+	hash = HashFileName( relativePath );
+
+	for ( search = searchPaths; search; search = search->next ) {
+		if ( search->dir && ( searchFlags & FSFLAG_SEARCH_DIRS ) ) {
+			if ( serverPaks.Num() && !FileAllowedFromDir( relativePath ) ) {
+				continue;
+			}
+
+			stat.fullPath = BuildOSPath( search->dir->path, search->dir->gamedir, relativePath );
+			fp = OpenOSFileCorrectName( stat.fullPath, "rb" );
+			if ( !fp ) {
+				continue;
+			}
+			stat.timestamp = Sys_FileTimeStamp( fp );
+			stat.length = DirectFileLength( fp );
+			stat.pakChecksum = 0;
+			fclose( fp );
+			return true;
+		} else if ( search->pack && ( searchFlags & FSFLAG_SEARCH_PAKS ) ) {
+			pack_t *pak = search->pack;
+			for ( pakFile = pak->hashTable[hash]; pakFile; pakFile = pakFile->next ) {
+				// case and separator insensitive comparisons
+				if ( !FilenameCompare( pakFile->name, relativePath ) ) {
+					stat.fullPath = pak->pakFilename + "/" + relativePath;
+					stat.timestamp = Sys_DosToUnixTime( pakFile->dosDate );
+					stat.length = pakFile->uncompressedSize;
+					stat.pakChecksum = pak->checksum;
+					pak->referenced = true;
+					if ( foundInPak ) {
+						*foundInPak = pak;
+					}
+					if ( foundPakFile ) {
+						*foundPakFile = pakFile;
+					}
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+/*
+=============
+idFileSystemLocal::PrefetchFile
+
+Only looks the file up, it is opened once it gets into the read window.
+=============
+*/
+bool idFileSystemLocal::PrefetchFile( const char *relativePath ) {
+	fileStat_t stat;
+	pack_t *pak;
+	fileInPack_t *pakFile;
+
+	if ( !searchPaths ) {
+		common->FatalError( "Filesystem call made without initialization\n" );
+	}
+
+	// without worker threads the jobs would only run when their results are waited for
+	if ( !fs_prefetch.GetBool() || parallelJobManager->GetNumThreads() == 0 ) {
+		return false;
+	}
+
+	const int hash = prefetchHash.GenerateKey( relativePath, false );
+	for ( int i = prefetchHash.First( hash ); i != -1; i = prefetchHash.Next( i ) ) {
+		if ( prefetchFiles[i]->relativePath.Icmp( relativePath ) == 0 ) {
+			return true;
+		}
+	}
+
+	if ( !StatFileFlags( relativePath, FSFLAG_SEARCH_DIRS | FSFLAG_SEARCH_PAKS, stat, &pak, &pakFile ) ) {
+		return false;
+	}
+
+	prefetchFile_t *pf = new prefetchFile_t;
+	pf->relativePath = relativePath;
+	pf->state = PREFETCH_PENDING;
+	pf->pak = pak;
+	pf->pakFile = pakFile;
+	pf->file = NULL;
+	pf->length = stat.length;
+	pf->timestamp = stat.timestamp;
+	pf->buffer = NULL;
+
+	{
+		boost::mutex::scoped_lock lock( prefetchMutex );
+		const int index = prefetchFiles.Append( pf );
+		prefetchHash.Add( hash, index );
+	}
+
+	UpdatePrefetch();
+
+	return true;
+}
+
+/*
+=============
+idFileSystemLocal::UpdatePrefetch
+
+Drops the files the loader moved past, closes the files that were read, opens the next
+files in the queue and hands them to the prefetch jobs once the previous job list has finished. The main thread allocates the
+buffers here and prefetched pk4 entries inflate with calloc / free, so the prefetch jobs
+never use the idLib allocators and don't need them to be serialized.
+=============
+*/
+void idFileSystemLocal::UpdatePrefetch( void ) {
+	bool jobsRunning;
+
+	{
+		boost::mutex::scoped_lock lock( prefetchMutex );
+
+		// files are loaded in the order they were queued, so the data of the files before
+		// the last one that was handed out is not going to be used and only takes memory
+		while( prefetchNextSkip < prefetchNextUse && prefetchFiles[prefetchNextSkip]->state != PREFETCH_READING ) {
+			prefetchFile_t *pf = prefetchFiles[prefetchNextSkip++];
+			if ( pf->state == PREFETCH_DONE ) {
+				Mem_Free( pf->buffer );
+				pf->buffer = NULL;
+				prefetchMemory -= pf->length + 1;
+				prefetchNumUnused++;
+				pf->state = PREFETCH_USED;
+			} else if ( pf->state == PREFETCH_PENDING ) {
+				pf->state = PREFETCH_USED;
+			} else if ( pf->state == PREFETCH_QUEUED ) {
+				// the job skips it, the buffer is freed when the file is closed below
+				pf->state = PREFETCH_FAILED;
+			}
+		}
+
+		// files that have been read or skipped
+		while( prefetchNextClose < prefetchNextSubmit && prefetchFiles[prefetchNextClose]->state != PREFETCH_QUEUED &&
+				prefetchFiles[prefetchNextClose]->state != PREFETCH_READING ) {
+			prefetchFile_t *pf = prefetchFiles[prefetchNextClose++];
+			if ( pf->state == PREFETCH_FAILED && pf->buffer ) {
+				Mem_Free( pf->buffer );
+				pf->buffer = NULL;
+				prefetchMemory -= pf->length + 1;
+			}
+			if ( pf->file ) {
+				CloseFile( pf->file );
+				pf->file = NULL;
+				prefetchNumOpen--;
+			}
+		}
+
+		prefetchMemoryLimit = fs_prefetchMemory.GetInteger() * 1024 * 1024;
+
+		while( prefetchNextOpen < prefetchFiles.Num() && prefetchNumOpen < MAX_PREFETCH_OPEN_FILES ) {
+			prefetchFile_t *pf = prefetchFiles[prefetchNextOpen];
+			if ( pf->state != PREFETCH_PENDING ) {
+				prefetchNextOpen++;
+				continue;
+			}
+			// a file larger than the limit is only read when nothing else is buffered
+			if ( prefetchMemory > 0 && prefetchMemory + pf->length + 1 > prefetchMemoryLimit ) {
+				break;
+			}
+			prefetchNextOpen++;
+
+			if ( pf->pak ) {
+				pf->file = ReadFileFromZip( pf->pak, pf->pakFile, pf->relativePath, true );
+			} else {
+				pf->file = OpenFileReadFlags( pf->relativePath, FSFLAG_SEARCH_DIRS );
+			}
+			if ( pf->file == NULL ) {
+				pf->state = PREFETCH_FAILED;
+				continue;
+			}
+			pf->buffer = (byte *)Mem_Alloc( pf->length + 1 );
+			pf->state = PREFETCH_QUEUED;
+			prefetchMemory += pf->length + 1;
+			if ( prefetchMemory > prefetchPeakMemory ) {
+				prefetchPeakMemory = prefetchMemory;
+			}
+			prefetchNumOpen++;
+		}
+
+		jobsRunning = ( prefetchNumJobsRunning > 0 );
+	}
+
+	if ( prefetchJobs.IsSubmitted() ) {
+		if ( jobsRunning ) {
+			return;
+		}
+		prefetchJobs.Wait();
+	}
+
+	prefetchJobs.Clear();
+	{
+		boost::mutex::scoped_lock lock( prefetchMutex );
+		for ( ; prefetchNextSubmit < prefetchNextOpen; prefetchNextSubmit++ ) {
+			if ( prefetchFiles[prefetchNextSubmit]->state == PREFETCH_QUEUED ) {
+				prefetchJobs.AddJob( PrefetchJob, prefetchFiles[prefetchNextSubmit] );
+			}
+		}
+		prefetchNumJobsRunning = prefetchJobs.NumJobs();
+	}
+	if ( prefetchJobs.NumJobs() > 0 ) {
+		prefetchJobs.Submit();
+	}
+}
+
+/*
+=============
+idFileSystemLocal::ReadPrefetchedFile
+
+Returns -1 if the data of the file was not read ahead
+=============
+*/
+int idFileSystemLocal::ReadPrefetchedFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp ) {
+	int i;
+	prefetchFile_t *pf = NULL;
+
+	const int hash = prefetchHash.GenerateKey( relativePath, false );
+	for ( i = prefetchHash.First( hash ); i != -1; i = prefetchHash.Next( i ) ) {
+		if ( prefetchFiles[i]->relativePath.Icmp( relativePath ) == 0 ) {
+			pf = prefetchFiles[i];
+			break;
+		}
+	}
+	if ( pf == NULL ) {
+		return -1;
+	}
+
+	int length = -1;
+	{
+		boost::mutex::scoped_lock lock( prefetchMutex );
+
+		if ( pf->state == PREFETCH_READING ) {
+			prefetchNumWaits++;
+			while( pf->state == PREFETCH_READING ) {
+				prefetchDone.wait( lock );
+			}
+		} else if ( pf->state == PREFETCH_PENDING || pf->state == PREFETCH_QUEUED ) {
+			prefetchNumMisses++;
+		}
+
+		if ( pf->state == PREFETCH_DONE ) {
+			prefetchNumHits++;
+			*buffer = pf->buffer;
+			if ( timestamp ) {
+				*timestamp = pf->timestamp;
+			}
+			length = pf->length;
+			pf->buffer = NULL;
+			prefetchMemory -= pf->length + 1;
+		}
+
+		// no prefetch job touches the file anymore once it is marked as used
+		if ( pf->buffer ) {
+			Mem_Free( pf->buffer );
+			pf->buffer = NULL;
+			prefetchMemory -= pf->length + 1;
+		}
+		if ( pf->file ) {
+			CloseFile( pf->file );
+			pf->file = NULL;
+			prefetchNumOpen--;
+		}
+		pf->state = PREFETCH_USED;
+		if ( i + 1 > prefetchNextUse ) {
+			prefetchNextUse = i + 1;
+		}
+	}
+
+	UpdatePrefetch();
+
+	return length;
+}
+
+/*
+=============
+idFileSystemLocal::PrefetchRead
+
+Reads and inflates the whole file, this is the only file system work done by the prefetch jobs.
+Each open file has its own pak handle, so several files can be read at the same time.
+=============
+*/
+bool idFileSystemLocal::PrefetchRead( prefetchFile_t *pf ) {
+	PROFILE_ZONE( FS_PrefetchRead );
+
+	bool ok;
+	if ( pf->pak ) {
+		idFile_InZip *f = static_cast<idFile_InZip *>( pf->file );
+		ok = ( unzReadCurrentFile( f->z, pf->buffer, pf->length ) == pf->length );
+	} else {
+		idFile_Permanent *f = static_cast<idFile_Permanent *>( pf->file );
+		ok = ( (int)fread( pf->buffer, 1, pf->length, f->o ) == pf->length );
+	}
+	if ( ok ) {
+		// guarantee that it will have a trailing 0 for string operations
+		pf->buffer[pf->length] = 0;
+	}
+	return ok;
+}
+
+/*
+=============
+idFileSystemLocal::PrefetchJob
+=============
+*/
+void idFileSystemLocal::PrefetchJob( void *data ) {
+	idFileSystemLocal &fs = fileSystemLocal;
+	prefetchFile_t *pf = (prefetchFile_t *)data;
+
+	{
+		boost::mutex::scoped_lock lock( fs.prefetchMutex );
+		// the file was already used or the prefetch was cleared
+		if ( pf->state != PREFETCH_QUEUED ) {
+			fs.prefetchNumJobsRunning--;
+			return;
+		}
+		pf->state = PREFETCH_READING;
+	}
+
+	const bool ok = fs.PrefetchRead( pf );
+
+	{
+		boost::mutex::scoped_lock lock( fs.prefetchMutex );
+		if ( ok ) {
+			pf->state = PREFETCH_DONE;
+			fs.prefetchBytesRead += pf->length;
+		} else {
+			pf->state = PREFETCH_FAILED;
+		}
+		fs.prefetchNumJobsRunning--;
+	}
+	fs.prefetchDone.notify_all();
+}
+
+/*
+=============
+idFileSystemLocal::ClearPrefetch
+=============
+*/
+void idFileSystemLocal::ClearPrefetch( void ) {
+	int i, numUnused;
+
+	if ( prefetchFiles.Num() == 0 ) {
+		return;
+	}
+
+	{
+		boost::mutex::scoped_lock lock( prefetchMutex );
+
+		// the jobs that didn't start yet skip their files
+		for ( i = 0; i < prefetchFiles.Num(); i++ ) {
+			if ( prefetchFiles[i]->state == PREFETCH_QUEUED ) {
+				prefetchFiles[i]->state = PREFETCH_FAILED;
+			}
+		}
+	}
+
+	if ( prefetchJobs.IsSubmitted() ) {
+		prefetchJobs.Wait();
+	}
+
+	{
+		boost::mutex::scoped_lock lock( prefetchMutex );
+
+		numUnused = 0;
+		for ( i = 0; i < prefetchFiles.Num(); i++ ) {
+			prefetchFile_t *pf = prefetchFiles[i];
+			if ( pf->state == PREFETCH_DONE ) {
+				numUnused++;
+			}
+			if ( pf->buffer ) {
+				Mem_Free( pf->buffer );
+			}
+			if ( pf->file ) {
+				CloseFile( pf->file );
+			}
+		}
+
+		prefetchFiles.DeleteContents( true );
+		prefetchHash.Free();
+		prefetchNextOpen = 0;
+		prefetchNextSubmit = 0;
+		prefetchNextClose = 0;
+		prefetchNextSkip = 0;
+		prefetchNextUse = 0;
+		prefetchNumOpen = 0;
+		prefetchMemory = 0;
+		prefetchNumJobsRunning = 0;
+	}
+
+	common->Printf( "prefetch: %d hits (%d waited), %d misses, %d unused, %d kB read ahead, %d kB peak\n",
+					prefetchNumHits, prefetchNumWaits, prefetchNumMisses, prefetchNumUnused + numUnused, prefetchBytesRead >> 10, prefetchPeakMemory >> 10 );
+
+	prefetchNumHits = 0;
+	prefetchNumWaits = 0;
+	prefetchNumMisses = 0;
+	prefetchNumUnused = 0;
+	prefetchBytesRead = 0;
+	prefetchPeakMemory = 0;
+}
+
 /*
 ============
 idFileSystemLocal::WriteFile
@@ -1129,6 +1671,10 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 	unz_global_info gi;
 	char			filename_inzip[MAX_ZIPPED_FILE_NAME];
 	unz_file_info	file_info;
+	unz_file_info_internal file_info_internal;
+	unsigned char *	centralDir;
+	unsigned long	centralDirSize;
+	unsigned long	centralDirOffset;
 	long			hash;
 	int				fs_numHeaderLongs;
 	int *			fs_headerLongs;
@@ -1154,6 +1700,12 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 		return NULL;
 	}
 
+	// parse the file infos from a single read of the central directory instead of reading them field by field
+	if ( unzReadCentralDir( uf, &centralDir, &centralDirSize ) != UNZ_OK ) {
+		unzClose( uf );
+		return NULL;
+	}
+
 	buildBuffer = new fileInPack_t[gi.number_entry];
 	pack = new pack_t;
 	for( int i = 0; i < FILE_HASH_SIZE; i++ ) {
@@ -1173,10 +1725,11 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 
 	pack->length = len;
 
-	unzGoToFirstFile(uf);
+	centralDirOffset = 0;
 	fs_headerLongs = (int *)Mem_ClearedAlloc( gi.number_entry * sizeof(int) );
 	for ( int i = 0; i < (int)gi.number_entry; i++ ) {
-		err = unzGetCurrentFileInfo( uf, &file_info, filename_inzip, sizeof(filename_inzip), NULL, 0, NULL, 0 );
+		err = unzGetFileInfoFromCentralDir( uf, centralDir, centralDirSize, &centralDirOffset, &buildBuffer[i].pos,
+											&file_info, &file_info_internal, filename_inzip, sizeof(filename_inzip) );
 		if ( err != UNZ_OK ) {
 			break;
 		}
@@ -1187,15 +1740,22 @@ pack_t *idFileSystemLocal::LoadZipFile( const char *zipfile ) {
 		buildBuffer[i].name = filename_inzip;
 		buildBuffer[i].name.ToLower();
 		buildBuffer[i].name.BackSlashesToSlashes();
-		// store the file position in the zip
-		unzGetCurrentFileInfoPosition( uf, &buildBuffer[i].pos );
+		// keep what is needed to open the file without reading the central directory again
+		buildBuffer[i].offset = file_info_internal.offset_curfile;
+		buildBuffer[i].crc = file_info.crc;
+		buildBuffer[i].dosDate = file_info.dosDate;
+		buildBuffer[i].compressedSize = file_info.compressed_size;
+		buildBuffer[i].uncompressedSize = file_info.uncompressed_size;
+		buildBuffer[i].compressionMethod = (unsigned short)file_info.compression_method;
+		buildBuffer[i].flag = (unsigned short)file_info.flag;
+		buildBuffer[i].nameLength = (unsigned short)file_info.size_filename;
 		// add the file to the hash
 		buildBuffer[i].next = pack->hashTable[hash];
 		pack->hashTable[hash] = &buildBuffer[i];
-		// go to the next file in the zip
-		unzGoToNextFile(uf);
 	}
 
+	unzFreeCentralDir( centralDir );
+
 	// check if this is an addon pak
 	pack->addon = false;
 	confHash = HashFileName( ADDON_CONFIG );
@@ -1910,6 +2470,121 @@ void idFileSystemLocal::TouchFileList_f( const idCmdArgs &args ) {
 
 }
 
+/*
+============
+BenchInflateJob
+============
+*/
+typedef struct {
+	idFile_InZip *		file;
+	unzFile				z;
+	int					length;
+	byte *				buffer;
+	bool				ok;
+} benchInflate_t;
+
+static void BenchInflateJob( void *data ) {
+	benchInflate_t *bench = (benchInflate_t *)data;
+	bench->ok = ( unzReadCurrentFile( bench->z, bench->buffer, bench->length ) == bench->length );
+}
+
+/*
+============
+idFileSystemLocal::BenchInflate_f
+
+Reads every file of a pk4 once on the main thread and once spread over the job threads.
+Files are opened in batches on the main thread, only the reads are timed. An untimed
+pass on the main thread goes first, so both timed passes find the pk4 in the page cache.
+============
+*/
+void idFileSystemLocal::BenchInflate_f( const idCmdArgs &args ) {
+	const int BATCH_SIZE = 64;
+
+	if ( args.Argc() != 2 ) {
+		common->Printf( "Usage: fs_benchInflate <pk4>\n" );
+		return;
+	}
+
+	pack_t *pak = NULL;
+	for ( int i = 0; i < 2 && pak == NULL; i++ ) {
+		for ( searchpath_t *sp = ( i == 0 ) ? fileSystemLocal.searchPaths : fileSystemLocal.addonPaks; sp; sp = sp->next ) {
+			if ( sp->pack && ( sp->pack->pakFilename.Icmp( args.Argv( 1 ) ) == 0 || idStr( sp->pack->pakFilename ).StripPath().Icmp( args.Argv( 1 ) ) == 0 ) ) {
+				pak = sp->pack;
+				break;
+			}
+		}
+	}
+	if ( pak == NULL ) {
+		common->Printf( "fs_benchInflate: %s is not a loaded pk4\n", args.Argv( 1 ) );
+		return;
+	}
+
+	boost::int64_t compressedBytes = 0;
+	boost::int64_t uncompressedBytes = 0;
+	for ( int i = 0; i < pak->numfiles; i++ ) {
+		compressedBytes += pak->buildBuffer[i].compressedSize;
+		uncompressedBytes += pak->buildBuffer[i].uncompressedSize;
+	}
+
+	idParallelJobList jobList( "fs_benchInflate" );
+	benchInflate_t batch[BATCH_SIZE];
+	// pass 0 warms up the page cache, pass 1 is timed on the main thread and pass 2 on the job threads
+	double times[3];
+	int errors[3];
+
+	for ( int pass = 0; pass < 3; pass++ ) {
+		const bool parallel = ( pass == 2 );
+		times[pass] = 0.0;
+		errors[pass] = 0;
+
+		for ( int first = 0; first < pak->numfiles; first += BATCH_SIZE ) {
+			const int num = Min( BATCH_SIZE, pak->numfiles - first );
+			for ( int i = 0; i < num; i++ ) {
+				fileInPack_t *pakFile = &pak->buildBuffer[first + i];
+				batch[i].file = fileSystemLocal.ReadFileFromZip( pak, pakFile, pakFile->name );
+				batch[i].z = batch[i].file->z;
+				batch[i].length = pakFile->uncompressedSize;
+				batch[i].buffer = (byte *)Mem_Alloc( pakFile->uncompressedSize + 1 );
+				batch[i].ok = false;
+			}
+
+			idTimer timer;
+			timer.Start();
+			if ( parallel ) {
+				jobList.Clear();
+				for ( int i = 0; i < num; i++ ) {
+					jobList.AddJob( BenchInflateJob, &batch[i] );
+				}
+				jobList.Submit();
+				jobList.Wait();
+			} else {
+				for ( int i = 0; i < num; i++ ) {
+					BenchInflateJob( &batch[i] );
+				}
+			}
+			timer.Stop();
+			times[pass] += timer.Milliseconds();
+
+			for ( int i = 0; i < num; i++ ) {
+				// closing checks the crc of the inflated data
+				if ( unzCloseCurrentFile( batch[i].z ) != UNZ_OK || !batch[i].ok ) {
+					errors[pass]++;
+				}
+				delete batch[i].file;
+				Mem_Free( batch[i].buffer );
+			}
+		}
+	}
+
+	const float mb = uncompressedBytes / ( 1024.0f * 1024.0f );
+	common->Printf( "%s: %d files, %d kB compressed, %d kB uncompressed\n", pak->pakFilename.c_str(), pak->numfiles, (int)( compressedBytes >> 10 ), (int)( uncompressedBytes >> 10 ) );
+	common->Printf( "  1 thread:   %8.1f ms, %6.1f MB/s\n", times[1], mb * 1000.0f / Max( times[1], 0.001 ) );
+	common->Printf( "  %d threads: %8.1f ms, %6.1f MB/s, %.2fx\n", parallelJobManager->GetNumThreads() + 1, times[2], mb * 1000.0f / Max( times[2], 0.001 ), times[1] / Max( times[2], 0.001 ) );
+	if ( errors[1] || errors[2] ) {
+		common->Warning( "fs_benchInflate: %d / %d files failed to inflate", errors[1], errors[2] );
+	}
+}
+
 /*
 ================
 idFileSystemLocal::AddGameDirectory
@@ -2172,6 +2847,7 @@ void idFileSystemLocal::Startup( void ) {
 	cmdSystem->AddCommand( "path", Path_f, CMD_FL_SYSTEM, "lists search paths" );
 	cmdSystem->AddCommand( "touchFile", TouchFile_f, CMD_FL_SYSTEM, "touches a file" );
 	cmdSystem->AddCommand( "touchFileList", TouchFileList_f, CMD_FL_SYSTEM, "touches a list of files" );
+	cmdSystem->AddCommand( "fs_benchInflate", BenchInflate_f, CMD_FL_SYSTEM, "measures the inflate throughput of a pk4 on one and on all cores" );
 
 	// print the current search paths
 	Path_f( idCmdArgs() );
@@ -2433,6 +3109,8 @@ void idFileSystemLocal::Shutdown( bool reloading ) {
 	gameDLLChecksum = 0;
 	gamePakChecksum = 0;
 
+	ClearPrefetch();
+
 	ClearDirCache();
 
 	// free everything - loop through searchPaths and addonPaks
@@ -2464,6 +3142,7 @@ void idFileSystemLocal::Shutdown( bool reloading ) {
 	cmdSystem->RemoveCommand( "dir" );
 	cmdSystem->RemoveCommand( "dirtree" );
 	cmdSystem->RemoveCommand( "touchFile" );
+	cmdSystem->RemoveCommand( "fs_benchInflate" );
 
 	mapDict.Clear();
 }
@@ -2538,9 +3217,9 @@ bool idFileSystemLocal::FileAllowedFromDir( const char *path ) {
 idFileSystemLocal::ReadFileFromZip
 ===========
 */
-idFile_InZip * idFileSystemLocal::ReadFileFromZip( pack_t *pak, fileInPack_t *pakFile, const char *relativePath ) {
-	unz_s *			zfi;
-	FILE *			fp;
+idFile_InZip * idFileSystemLocal::ReadFileFromZip( pack_t *pak, fileInPack_t *pakFile, const char *relativePath, bool systemAlloc ) {
+	unz_file_info			fileInfo;
+	unz_file_info_internal	fileInfoInternal;
 	idFile_InZip *file = new idFile_InZip();
 
 	// open a new file on the pakfile
@@ -2551,25 +3230,28 @@ idFile_InZip * idFileSystemLocal::ReadFileFromZip( pack_t *pak, fileInPack_t *pa
 	} else {
 		file->name = relativePath;
 		file->fullPath = pak->pakFilename + "/" + relativePath;
-		zfi = (unz_s *)file->z;
-
-		// in case the file was new
-		fp = zfi->file;
-
-		// set the file position in the zip file (also sets the current file info)
-		unzSetCurrentFileInfoPosition( pak->handle, pakFile->pos );
 
-		// copy the file info into the unzip structure
-		memcpy( zfi, pak->handle, sizeof(unz_s) );
-
-		// we copy this back into the structure
-		zfi->file = fp;
+		// set the current file info from the pak index, the shared pak handle is not touched
+		memset( &fileInfo, 0, sizeof( fileInfo ) );
+		fileInfo.flag = pakFile->flag;
+		fileInfo.compression_method = pakFile->compressionMethod;
+		fileInfo.dosDate = pakFile->dosDate;
+		fileInfo.crc = pakFile->crc;
+		fileInfo.compressed_size = pakFile->compressedSize;
+		fileInfo.uncompressed_size = pakFile->uncompressedSize;
+		fileInfo.size_filename = pakFile->nameLength;
+		fileInfoInternal.offset_curfile = pakFile->offset;
+		unzSetCurrentFileInfo( file->z, pakFile->pos, &fileInfo, &fileInfoInternal );
 
 		// open the file in the zip
-		unzOpenCurrentFile( file->z );
+		if ( systemAlloc ) {
+			unzOpenCurrentFileSystemAlloc( file->z );
+		} else {
+			unzOpenCurrentFile( file->z );
+		}
 		file->zipFilePos = pakFile->pos;
-		file->fileSize = zfi->cur_file_info.uncompressed_size;
-        file->fileLastMod = Sys_DosToUnixTime(zfi->cur_file_info.dosDate);
+		file->fileSize = pakFile->uncompressedSize;
+        file->fileLastMod = Sys_DosToUnixTime( pakFile->dosDate );
 	}
 
 	return file;
@@ -2593,6 +3275,8 @@ idFile *idFileSystemLocal::OpenFileReadFlags( const char *relativePath, int sear
 	directory_t *	dir;
 	long			hash;
 	FILE *			fp;
+
+	PROFILE_ZONE( FS_OpenFileRead );
 	
 	if ( !searchPaths ) {
 		common->FatalError( "Filesystem call made without initialization\n" );
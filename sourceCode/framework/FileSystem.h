@@ -77,6 +77,14 @@ typedef enum {
 	FIND_ADDON
 } findFile_t;
 
+// where a file would be read from, see idFileSystem::StatFile
+typedef struct {
+	idStr				fullPath;			// OS path of a loose file, or the pk4 path followed by the relative path
+	ID_TIME_T			timestamp;
+	int					length;
+	int					pakChecksum;		// checksum of the pk4 holding the file, 0 for loose files
+} fileStat_t;
+
 typedef struct urlDownload_s {
 	idStr				url;
 	char				dlerror[ MAX_STRING_CHARS ];
@@ -180,6 +188,15 @@ public:
 	virtual int				ReadFile( const char *relativePath, void **buffer, ID_TIME_T *timestamp = NULL ) = 0;
 							// Frees the memory allocated by ReadFile.
 	virtual void			FreeFile( void *buffer ) = 0;
+							// Looks up a file in the search paths like OpenFileRead, without opening it.
+							// Files in pk4s are taken from the pk4 directory. Returns false if the file doesn't exist.
+	virtual bool			StatFile( const char *relativePath, fileStat_t &stat ) = 0;
+							// Queues a file to be read ahead by jobs on the parallel job threads, a later
+							// ReadFile of it returns the data without waiting for the disk or decompression.
+							// Files are read in the order they were queued. Returns false if the file doesn't exist.
+	virtual bool			PrefetchFile( const char *relativePath ) = 0;
+							// Frees the prefetched data that was not used and prints the prefetch statistics.
+	virtual void			ClearPrefetch( void ) = 0;
 							// Writes a complete file, will create any needed subdirectories.
 							// Returns the length of the file, or -1 on failure. 
 							// greebo: By default use the mod save path to write stuff
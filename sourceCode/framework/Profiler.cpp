@@ -0,0 +1,581 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+idCVar com_profiler( "com_profiler", "0", CVAR_BOOL | CVAR_SYSTEM, "record profiler zones, use profileTrace to write them out" );
+idCVar com_profilerSpike( "com_profilerSpike", "0", CVAR_INTEGER | CVAR_SYSTEM, "automatically write a profiler trace when a frame takes longer than this many milliseconds, 0 = never", 0, 10000 );
+
+/*
+===============================================================================
+
+	idProfilerLocal
+
+	Every thread that opens a zone gets its own ring buffer, so recording
+	never takes a lock. A zone is written to the ring buffer when it is
+	closed. Writing a trace reads the ring buffers of the other threads
+	while they may still record, the oldest part of each ring is skipped
+	so the entries that are read aren't overwritten at the same time.
+
+	The ring buffer of a thread that exits is kept, and is written to the
+	traces until a new thread takes it over.
+
+	Zone names are copied into a table the first time they are seen, the
+	ring buffers only point into that table. Each thread caches the copies
+	of the names it uses by pointer, so only new names take the lock.
+
+===============================================================================
+*/
+
+const int MAX_PROFILE_THREADS		= MAX_JOB_THREADS + 8;
+const int MAX_PROFILE_ZONES			= 65536;		// per thread, has to be a power of two
+const int MAX_PROFILE_DEPTH			= 64;
+const int MAX_PROFILE_TOTALS		= 256;			// per thread, has to be a power of two
+const int MAX_PROFILE_NAMES			= 4096;			// has to be a power of two
+const int MAX_PROFILE_NAME_CACHE	= 256;			// per thread, has to be a power of two
+const int PROFILE_SPIKE_INTERVAL	= 5;			// minimum number of seconds between automatic traces
+
+typedef struct {
+	const char *			name;
+	double					start;			// clock ticks
+	double					end;
+	int						depth;
+} profileZone_t;
+
+typedef struct {
+	const char *			name;
+	double					start;
+} openProfileZone_t;
+
+typedef struct {
+	const char *			name;			// NULL for an unused slot
+	double					ticks;
+	int						count;
+} profileTotal_t;
+
+typedef struct {
+	const char *			name;			// as passed to BeginZone
+	const char *			copy;			// in the name table
+} profileName_t;
+
+typedef struct {
+	int						threadNum;
+	char					threadName[32];
+	bool					exited;			// the ring buffer can be taken over by a new thread
+	profileZone_t *			zones;			// ring buffer of closed zones
+	volatile int			numZones;		// number of zones ever recorded
+	openProfileZone_t		stack[MAX_PROFILE_DEPTH];
+	int						depth;			// may be larger than MAX_PROFILE_DEPTH
+	profileTotal_t			totals[MAX_PROFILE_TOTALS];	// hashed by name pointer
+	int						totalsGeneration;	// the totals are cleared by the thread itself when it doesn't match
+	profileName_t			names[MAX_PROFILE_NAME_CACHE];	// hashed by name pointer
+} profileThread_t;
+
+class idProfilerLocal : public idProfiler {
+public:
+							idProfilerLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+
+	virtual void			BeginZone( const char *name );
+	virtual void			EndZone( void );
+
+	virtual void			EndFrame( void );
+
+	virtual bool			WriteTrace( const char *fileName );
+
+	virtual void			BeginZoneTotals( void );
+	virtual void			EndZoneTotals( void );
+	virtual void			GetZoneTotals( idList<profileZoneTotal_t> &totals ) const;
+
+							// called by a thread that recorded zones when it exits
+	static void				ThreadExit( profileThread_t *thread );
+
+private:
+	profileThread_t *		threads[MAX_PROFILE_THREADS];
+	int						numThreads;
+	int						threadCount;		// number of threads ever registered
+	mutable boost::mutex	threadsMutex;
+
+	char *					names[MAX_PROFILE_NAMES];	// copies of the zone names, hashed by name
+	int						numNames;
+	boost::mutex			namesMutex;
+
+	double					lastFrameEnd;
+	double					lastSpikeTrace;
+
+	volatile bool			collectTotals;
+	volatile int			totalsGeneration;
+
+	profileThread_t *		GetThread( void );
+	void					AddTotal( profileThread_t *thread, const char *name, double ticks );
+	const char *			CopyName( profileThread_t *thread, const char *name );
+
+	static void				ProfileTrace_f( const idCmdArgs &args );
+};
+
+// profiler data of the calling thread
+#ifdef _WIN32
+static __declspec( thread ) profileThread_t *	currentThread = NULL;
+#else
+static __thread profileThread_t *				currentThread = NULL;
+#endif
+
+idProfilerLocal		profilerLocal;
+idProfiler *		profiler = &profilerLocal;
+
+// calls ThreadExit when a thread other than the main thread exits
+static boost::thread_specific_ptr<profileThread_t>	threadExit( idProfilerLocal::ThreadExit );
+
+/*
+================
+idProfilerLocal::idProfilerLocal
+================
+*/
+idProfilerLocal::idProfilerLocal( void ) {
+	enabled = false;
+	numThreads = 0;
+	threadCount = 0;
+	memset( threads, 0, sizeof( threads ) );
+	numNames = 0;
+	memset( names, 0, sizeof( names ) );
+	lastFrameEnd = 0.0;
+	lastSpikeTrace = 0.0;
+	collectTotals = false;
+	totalsGeneration = 0;
+}
+
+/*
+================
+idProfilerLocal::Init
+================
+*/
+void idProfilerLocal::Init( void ) {
+	cmdSystem->AddCommand( "profileTrace", ProfileTrace_f, CMD_FL_SYSTEM, "writes the recorded profiler zones as a Chrome trace, usage: profileTrace [filename]" );
+
+	// the main thread is always the first one in the trace
+	currentThread = GetThread();
+
+	enabled = com_profiler.GetBool();
+}
+
+/*
+================
+idProfilerLocal::Shutdown
+================
+*/
+void idProfilerLocal::Shutdown( void ) {
+	enabled = false;
+
+	boost::mutex::scoped_lock lock( threadsMutex );
+	for ( int i = 0; i < numThreads; i++ ) {
+		// the ring buffers aren't allocated from the idLib heap, see GetThread
+		free( threads[i]->zones );
+		free( threads[i] );
+		threads[i] = NULL;
+	}
+	numThreads = 0;
+	threadCount = 0;
+	currentThread = NULL;
+
+	boost::mutex::scoped_lock namesLock( namesMutex );
+	for ( int i = 0; i < MAX_PROFILE_NAMES; i++ ) {
+		free( names[i] );
+		names[i] = NULL;
+	}
+	numNames = 0;
+}
+
+/*
+================
+idProfilerLocal::GetThread
+
+Threads are registered when they open their first zone and take over the
+ring buffer of an exited thread if there is one. The memory is allocated
+with malloc because the idLib heap can't be used by the sound and file
+system threads.
+================
+*/
+profileThread_t *idProfilerLocal::GetThread( void ) {
+	boost::mutex::scoped_lock lock( threadsMutex );
+
+	profileThread_t *thread = NULL;
+	for ( int i = 0; i < numThreads; i++ ) {
+		if ( threads[i]->exited ) {
+			thread = threads[i];
+			break;
+		}
+	}
+
+	if ( thread != NULL ) {
+		// the totals are merged by name anyway, so they are kept
+		thread->exited = false;
+		thread->numZones = 0;
+		thread->depth = 0;
+	} else {
+		if ( numThreads >= MAX_PROFILE_THREADS ) {
+			return NULL;
+		}
+		thread = (profileThread_t *)calloc( 1, sizeof( profileThread_t ) );
+		thread->zones = (profileZone_t *)calloc( MAX_PROFILE_ZONES, sizeof( profileZone_t ) );
+		if ( thread->zones == NULL ) {
+			free( thread );
+			return NULL;
+		}
+		threads[numThreads++] = thread;
+	}
+	thread->threadNum = threadCount++;
+
+	const int jobThread = parallelJobManager->GetThreadIndex();
+	if ( thread->threadNum == 0 ) {
+		idStr::snPrintf( thread->threadName, sizeof( thread->threadName ), "main" );
+	} else if ( jobThread > 0 ) {
+		idStr::snPrintf( thread->threadName, sizeof( thread->threadName ), "job thread %d", jobThread );
+	} else {
+		idStr::snPrintf( thread->threadName, sizeof( thread->threadName ), "thread %d", thread->threadNum );
+	}
+
+	return thread;
+}
+
+/*
+================
+idProfilerLocal::ThreadExit
+
+Called on the exiting thread, hands its ring buffer to the next new thread.
+================
+*/
+void idProfilerLocal::ThreadExit( profileThread_t *thread ) {
+	boost::mutex::scoped_lock lock( profilerLocal.threadsMutex );
+
+	// the buffers may have been freed by Shutdown
+	for ( int i = 0; i < profilerLocal.numThreads; i++ ) {
+		if ( profilerLocal.threads[i] == thread ) {
+			thread->exited = true;
+			break;
+		}
+	}
+	currentThread = NULL;
+}
+
+/*
+================
+idProfilerLocal::CopyName
+
+Returns the copy of the zone name in the name table. Names of the game module
+are freed when it is reloaded, so a cached pointer is only used if the name
+still matches.
+================
+*/
+const char *idProfilerLocal::CopyName( profileThread_t *thread, const char *name ) {
+	profileName_t &cached = thread->names[(int)( (intptr_t)name >> 3 ) & ( MAX_PROFILE_NAME_CACHE - 1 )];
+	if ( cached.name == name && idStr::Cmp( cached.copy, name ) == 0 ) {
+		return cached.copy;
+	}
+
+	boost::mutex::scoped_lock lock( namesMutex );
+
+	int slot = idStr::Hash( name ) & ( MAX_PROFILE_NAMES - 1 );
+	while ( names[slot] != NULL && idStr::Cmp( names[slot], name ) != 0 ) {
+		slot = ( slot + 1 ) & ( MAX_PROFILE_NAMES - 1 );
+	}
+	if ( names[slot] == NULL ) {
+		// keep the table at most half full
+		if ( numNames >= MAX_PROFILE_NAMES / 2 ) {
+			return "too many zone names";
+		}
+		const size_t length = strlen( name ) + 1;
+		names[slot] = (char *)malloc( length );
+		memcpy( names[slot], name, length );
+		numNames++;
+	}
+
+	cached.name = name;
+	cached.copy = names[slot];
+	return cached.copy;
+}
+
+/*
+================
+idProfilerLocal::BeginZone
+================
+*/
+void idProfilerLocal::BeginZone( const char *name ) {
+	profileThread_t *thread = currentThread;
+	if ( thread == NULL ) {
+		thread = currentThread = GetThread();
+		if ( thread == NULL ) {
+			return;
+		}
+		if ( thread->threadNum != 0 ) {
+			threadExit.reset( thread );
+		}
+	}
+
+	if ( thread->depth < MAX_PROFILE_DEPTH ) {
+		openProfileZone_t &zone = thread->stack[thread->depth];
+		zone.name = CopyName( thread, name );
+		zone.start = Sys_GetClockTicks();
+	}
+	thread->depth++;
+}
+
+/*
+================
+idProfilerLocal::EndZone
+================
+*/
+void idProfilerLocal::EndZone( void ) {
+	profileThread_t *thread = currentThread;
+	if ( thread == NULL || thread->depth <= 0 ) {
+		return;
+	}
+
+	thread->depth--;
+	if ( thread->depth >= MAX_PROFILE_DEPTH ) {
+		return;
+	}
+
+	const openProfileZone_t &open = thread->stack[thread->depth];
+	profileZone_t &zone = thread->zones[thread->numZones & ( MAX_PROFILE_ZONES - 1 )];
+	zone.name = open.name;
+	zone.start = open.start;
+	zone.end = Sys_GetClockTicks();
+	zone.depth = thread->depth;
+	thread->numZones++;
+
+	if ( collectTotals ) {
+		AddTotal( thread, zone.name, zone.end - zone.start );
+	}
+}
+
+/*
+================
+idProfilerLocal::AddTotal
+================
+*/
+void idProfilerLocal::AddTotal( profileThread_t *thread, const char *name, double ticks ) {
+	if ( thread->totalsGeneration != totalsGeneration ) {
+		memset( thread->totals, 0, sizeof( thread->totals ) );
+		thread->totalsGeneration = totalsGeneration;
+	}
+
+	// the copied names are unique
+	int slot = (int)( (intptr_t)name >> 3 ) & ( MAX_PROFILE_TOTALS - 1 );
+	for ( int i = 0; i < MAX_PROFILE_TOTALS; i++, slot = ( slot + 1 ) & ( MAX_PROFILE_TOTALS - 1 ) ) {
+		profileTotal_t &total = thread->totals[slot];
+		if ( total.name == name ) {
+			total.ticks += ticks;
+			total.count++;
+			return;
+		}
+		if ( total.name == NULL ) {
+			total.ticks = ticks;
+			total.count = 1;
+			total.name = name;
+			return;
+		}
+	}
+}
+
+/*
+================
+idProfilerLocal::EndFrame
+================
+*/
+void idProfilerLocal::EndFrame( void ) {
+	const double now = Sys_GetClockTicks();
+	const double frameTicks = now - lastFrameEnd;
+	const bool wasEnabled = enabled;
+
+	enabled = com_profiler.GetBool() || collectTotals;
+
+	if ( wasEnabled && enabled && com_profilerSpike.GetInteger() > 0 && lastFrameEnd > 0.0 ) {
+		const double ticksPerSecond = Sys_ClockTicksPerSecond();
+		if ( frameTicks * 1000.0 > com_profilerSpike.GetInteger() * ticksPerSecond && now - lastSpikeTrace > PROFILE_SPIKE_INTERVAL * ticksPerSecond ) {
+			lastSpikeTrace = now;
+			const char *fileName = va( "profiles/spike_%05d.json", idLib::frameNumber );
+			common->Printf( "frame %d took %1.1f msec\n", idLib::frameNumber, frameTicks * 1000.0 / ticksPerSecond );
+			WriteTrace( fileName );
+		}
+	}
+
+	lastFrameEnd = now;
+}
+
+/*
+================
+idProfilerLocal::WriteTrace
+================
+*/
+bool idProfilerLocal::WriteTrace( const char *fileName ) {
+	idFile *f = fileSystem->OpenFileWrite( fileName );
+	if ( f == NULL ) {
+		common->Warning( "couldn't open %s", fileName );
+		return false;
+	}
+
+	// don't read the part of the rings that may be overwritten while the trace is written
+	const int safeZones = MAX_PROFILE_ZONES - MAX_PROFILE_ZONES / 8;
+	const double ticksToMicroseconds = 1000000.0 / Sys_ClockTicksPerSecond();
+
+	boost::mutex::scoped_lock lock( threadsMutex );
+
+	// the trace starts with the oldest zone that is written
+	double base = idMath::INFINITY;
+	for ( int i = 0; i < numThreads; i++ ) {
+		const profileThread_t *thread = threads[i];
+		const int numZones = thread->numZones;
+		const int first = Max( 0, numZones - safeZones );
+		if ( first < numZones ) {
+			base = Min( base, thread->zones[first & ( MAX_PROFILE_ZONES - 1 )].start );
+		}
+	}
+
+	int numWritten = 0;
+
+	f->Printf( "{\"traceEvents\":[\n" );
+	for ( int i = 0; i < numThreads; i++ ) {
+		const profileThread_t *thread = threads[i];
+		f->Printf( "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", ( i > 0 ) ? ",\n" : "", thread->threadNum, thread->threadName );
+
+		const int numZones = thread->numZones;
+		for ( int j = Max( 0, numZones - safeZones ); j < numZones; j++ ) {
+			const profileZone_t &zone = thread->zones[j & ( MAX_PROFILE_ZONES - 1 )];
+			f->Printf( ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", zone.name,
+						thread->threadNum, ( zone.start - base ) * ticksToMicroseconds, ( zone.end - zone.start ) * ticksToMicroseconds );
+			numWritten++;
+		}
+	}
+	f->Printf( "\n],\"displayTimeUnit\":\"ms\"}\n" );
+
+	common->Printf( "wrote %d zones of %d threads to %s\n", numWritten, numThreads, f->GetFullPath() );
+
+	fileSystem->CloseFile( f );
+
+	return true;
+}
+
+/*
+================
+idProfilerLocal::BeginZoneTotals
+================
+*/
+void idProfilerLocal::BeginZoneTotals( void ) {
+	totalsGeneration++;
+	collectTotals = true;
+	enabled = true;
+}
+
+/*
+================
+idProfilerLocal::EndZoneTotals
+================
+*/
+void idProfilerLocal::EndZoneTotals( void ) {
+	collectTotals = false;
+	enabled = com_profiler.GetBool();
+}
+
+/*
+================
+SortZoneTotals
+================
+*/
+static int SortZoneTotals( const profileZoneTotal_t *a, const profileZoneTotal_t *b ) {
+	if ( a->msec > b->msec ) {
+		return -1;
+	}
+	if ( a->msec < b->msec ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+idProfilerLocal::GetZoneTotals
+
+Totals of zones with the same name are merged, even if they come from different threads.
+================
+*/
+void idProfilerLocal::GetZoneTotals( idList<profileZoneTotal_t> &totals ) const {
+	const double ticksToMsec = 1000.0 / Sys_ClockTicksPerSecond();
+
+	totals.Clear();
+
+	boost::mutex::scoped_lock lock( threadsMutex );
+
+	for ( int i = 0; i < numThreads; i++ ) {
+		const profileThread_t *thread = threads[i];
+		if ( thread->totalsGeneration != totalsGeneration ) {
+			continue;
+		}
+		for ( int j = 0; j < MAX_PROFILE_TOTALS; j++ ) {
+			const profileTotal_t &total = thread->totals[j];
+			if ( total.name == NULL ) {
+				continue;
+			}
+			int k;
+			for ( k = 0; k < totals.Num(); k++ ) {
+				if ( idStr::Cmp( totals[k].name, total.name ) == 0 ) {
+					break;
+				}
+			}
+			if ( k == totals.Num() ) {
+				profileZoneTotal_t &merged = totals.Alloc();
+				merged.name = total.name;
+				merged.msec = 0.0;
+				merged.count = 0;
+			}
+			totals[k].msec += total.ticks * ticksToMsec;
+			totals[k].count += total.count;
+		}
+	}
+
+	totals.Sort( SortZoneTotals );
+}
+
+/*
+================
+idProfilerLocal::ProfileTrace_f
+================
+*/
+void idProfilerLocal::ProfileTrace_f( const idCmdArgs &args ) {
+	if ( !profilerLocal.IsEnabled() ) {
+		common->Printf( "com_profiler is off, only zones recorded before it was turned off are written\n" );
+	}
+
+	idStr fileName;
+	if ( args.Argc() > 1 ) {
+		fileName = args.Argv( 1 );
+	} else {
+		fileName = va( "profiles/trace_%05d", idLib::frameNumber );
+	}
+	fileName.DefaultFileExtension( ".json" );
+
+	profilerLocal.WriteTrace( fileName );
+}
@@ -645,6 +645,32 @@ static void Session_TimeCmdDemo_f( const idCmdArgs &args ) {
 	sessLocal.TimeCmdDemo( args.Argv(1) );
 }
 
+/*
+================
+Session_BenchmarkCmdDemo_f
+================
+*/
+static void Session_BenchmarkCmdDemo_f( const idCmdArgs &args ) {
+	if ( args.Argc() != 2 ) {
+		common->Printf( "usage: benchmarkCmdDemo <demoName>\n" );
+		return;
+	}
+	sessLocal.BenchmarkCmdDemo( args.Argv(1), false );
+}
+
+/*
+================
+Session_BenchmarkCmdDemoQuit_f
+================
+*/
+static void Session_BenchmarkCmdDemoQuit_f( const idCmdArgs &args ) {
+	if ( args.Argc() != 2 ) {
+		common->Printf( "usage: benchmarkCmdDemoQuit <demoName>\n" );
+		return;
+	}
+	sessLocal.BenchmarkCmdDemo( args.Argv(1), true );
+}
+
 /*
 ================
 Session_Disconnect_f
@@ -1274,6 +1300,100 @@ void idSessionLocal::TimeCmdDemo( const char *demoName ) {
 	common->Printf( "%i seconds of game, replayed in %5.1f seconds\n", count / 60, sec );
 }
 
+/*
+===============
+SortTicTimes
+===============
+*/
+static int SortTicTimes( const float *a, const float *b ) {
+	if ( *a < *b ) {
+		return -1;
+	}
+	if ( *a > *b ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+===============
+idSessionLocal::BenchmarkCmdDemo
+
+Replays a command demo like timeCmdDemo, one game tic after the other as
+fast as possible, and reports the distribution of the tic times and the time
+spent in the profiler zones of the game. The report is also written to
+benchmarks/<demoName>.txt.
+
+The game doesn't need a window for this, a benchmark can be run without a
+GPU with "+set com_skipRenderer 1 +set s_noSound 1 +benchmarkCmdDemoQuit <demoName>".
+===============
+*/
+void idSessionLocal::BenchmarkCmdDemo( const char *demoName, bool quit ) {
+	StartPlayingCmdDemo( demoName );
+	if ( !cmdDemoFile ) {
+		if ( quit ) {
+			cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
+		}
+		return;
+	}
+	ClearWipe();
+	UpdateScreen();
+
+	const double ticksToMsec = 1000.0 / Sys_ClockTicksPerSecond();
+	idList<float> ticTimes;
+	ticTimes.SetGranularity( 4096 );
+
+	idLib::profiler->BeginZoneTotals();
+
+	while( cmdDemoFile ) {
+		const double start = Sys_GetClockTicks();
+		RunGameTic();
+		ticTimes.Append( ( Sys_GetClockTicks() - start ) * ticksToMsec );
+	}
+
+	idList<profileZoneTotal_t> zoneTotals;
+	idLib::profiler->GetZoneTotals( zoneTotals );
+	idLib::profiler->EndZoneTotals();
+
+	const int numTics = ticTimes.Num();
+	if ( numTics == 0 ) {
+		common->Printf( "no game tics were run\n" );
+		return;
+	}
+
+	double total = 0.0;
+	for ( int i = 0; i < numTics; i++ ) {
+		total += ticTimes[i];
+	}
+	ticTimes.Sort( SortTicTimes );
+
+	idStr report;
+	report += va( "benchmark %s: %i tics, %i seconds of game, replayed in %1.2f seconds\n", demoName, numTics, numTics / USERCMD_HZ, total * 0.001 );
+	report += va( "tic msec: average %1.3f, median %1.3f, 90%% %1.3f, 99%% %1.3f, 99.9%% %1.3f, max %1.3f\n", total / numTics,
+		ticTimes[ numTics / 2 ], ticTimes[ ( numTics - 1 ) * 90 / 100 ], ticTimes[ ( numTics - 1 ) * 99 / 100 ], ticTimes[ ( numTics - 1 ) * 999 / 1000 ], ticTimes[ numTics - 1 ] );
+	report += "zone                        msec    msec/tic   calls/tic\n";
+	for ( int i = 0; i < zoneTotals.Num(); i++ ) {
+		const profileZoneTotal_t &zone = zoneTotals[i];
+		report += va( "%-24s %10.1f %11.3f %11.1f\n", zone.name, zone.msec, zone.msec / numTics, (float)zone.count / numTics );
+	}
+
+	common->Printf( "%s", report.c_str() );
+
+	idStr reportName = "benchmarks/";
+	reportName += demoName;
+	reportName.SetFileExtension( ".txt" );
+	idFile *f = fileSystem->OpenFileWrite( reportName );
+	if ( f ) {
+		f->Write( report.c_str(), report.Length() );
+		fileSystem->CloseFile( f );
+		common->Printf( "wrote %s\n", reportName.c_str() );
+	}
+
+	if ( quit ) {
+		cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
+	}
+}
+
 /*
 ===============
 idSessionLocal::UnloadMap
@@ -2787,6 +2907,8 @@ void idSessionLocal::Init() {
 	cmdSystem->AddCommand( "writeCmdDemo", Session_WriteCmdDemo_f, CMD_FL_SYSTEM, "writes a command demo" );
 	cmdSystem->AddCommand( "playCmdDemo", Session_PlayCmdDemo_f, CMD_FL_SYSTEM, "plays back a command demo" );
 	cmdSystem->AddCommand( "timeCmdDemo", Session_TimeCmdDemo_f, CMD_FL_SYSTEM, "times a command demo" );
+	cmdSystem->AddCommand( "benchmarkCmdDemo", Session_BenchmarkCmdDemo_f, CMD_FL_SYSTEM, "replays a command demo as fast as possible and reports game tic and zone times" );
+	cmdSystem->AddCommand( "benchmarkCmdDemoQuit", Session_BenchmarkCmdDemoQuit_f, CMD_FL_SYSTEM, "benchmarks a command demo and quits" );
 	cmdSystem->AddCommand( "exitCmdDemo", Session_ExitCmdDemo_f, CMD_FL_SYSTEM, "exits a command demo" );
 	cmdSystem->AddCommand( "aviCmdDemo", Session_AVICmdDemo_f, CMD_FL_SYSTEM, "writes AVIs for a command demo" );
 	cmdSystem->AddCommand( "aviGame", Session_AVIGame_f, CMD_FL_SYSTEM, "writes AVIs for the current game" );
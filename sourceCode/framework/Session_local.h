@@ -255,6 +255,7 @@ public:
 	void				WriteCmdDemo( const char *name, bool save = false);
 	void				StartPlayingCmdDemo( const char *demoName);
 	void				TimeCmdDemo( const char *demoName);
+	void				BenchmarkCmdDemo( const char *demoName, bool quit );
 	void				SaveCmdDemoToFile(idFile *file);
 	void				LoadCmdDemoFromFile(idFile *file);
 	void				StartRecordingRenderDemo( const char *name );
@@ -1038,6 +1038,8 @@ extern const char *z_errmsg[10]; /* indexed by 2-zlib_error */
 typedef uLong (*check_func) OF((uLong check, const Byte *buf, uInt len));
 voidp zcalloc OF((voidp opaque, unsigned items, unsigned size));
 void   zcfree  OF((voidp opaque, voidp ptr));
+voidp zcalloc_system OF((voidp opaque, unsigned items, unsigned size));
+void   zcfree_system  OF((voidp opaque, voidp ptr));
 
 #define ZALLOC(strm, items, size) \
            (*((strm)->zalloc))((strm)->opaque, (items), (size))
@@ -1707,6 +1709,142 @@ extern int unzSetCurrentFileInfoPosition (unzFile file, unsigned long pos )
 	return UNZ_OK;
 }
 
+/*
+  Set the current file from info gathered with unzGetFileInfoFromCentralDir, without
+  reading the central directory again.
+  return UNZ_OK if there is no problem
+*/
+extern int unzSetCurrentFileInfo (unzFile file, unsigned long pos, const unz_file_info *pfile_info,
+								  const unz_file_info_internal *pfile_info_internal)
+{
+	unz_s* s;
+
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+	s=(unz_s*)file;
+
+	s->pos_in_central_dir = pos;
+	s->cur_file_info = *pfile_info;
+	unzlocal_DosDateToTmuDate(s->cur_file_info.dosDate,&s->cur_file_info.tmu_date);
+	s->cur_file_info_internal = *pfile_info_internal;
+	s->current_file_ok = 1;
+	return UNZ_OK;
+}
+
+/*
+  Read the whole central directory with a single read, so the file infos can be
+  parsed from memory with unzGetFileInfoFromCentralDir.
+  *buf has to be freed with unzFreeCentralDir.
+  return UNZ_OK if there is no problem
+*/
+extern int unzReadCentralDir (unzFile file, unsigned char **buf, unsigned long *size)
+{
+	unz_s* s;
+
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+	s=(unz_s*)file;
+
+	*buf = NULL;
+	*size = 0;
+	if (s->size_central_dir==0)
+		return UNZ_OK;
+
+	*buf = (unsigned char*)ALLOC(s->size_central_dir);
+	if (*buf==NULL)
+		return UNZ_INTERNALERROR;
+
+	if ((fseek(s->file,s->offset_central_dir+s->byte_before_the_zipfile,SEEK_SET)!=0) ||
+		(fread(*buf,(uInt)s->size_central_dir,1,s->file)!=1))
+	{
+		TRYFREE(*buf);
+		*buf = NULL;
+		return UNZ_ERRNO;
+	}
+
+	*size = s->size_central_dir;
+	return UNZ_OK;
+}
+
+extern void unzFreeCentralDir (unsigned char *buf)
+{
+	TRYFREE(buf);
+}
+
+static uLong unzlocal_bufShort (const unsigned char *p)
+{
+	return (uLong)p[0] | ((uLong)p[1]<<8);
+}
+
+static uLong unzlocal_bufLong (const unsigned char *p)
+{
+	return (uLong)p[0] | ((uLong)p[1]<<8) | ((uLong)p[2]<<16) | ((uLong)p[3]<<24);
+}
+
+/*
+  Parse the info of the file at *offset in a central directory read with unzReadCentralDir,
+  and advance *offset to the next file.
+  *pos receives the position of the file info for unzSetCurrentFileInfo(Position).
+  return UNZ_OK if there is no problem
+*/
+extern int unzGetFileInfoFromCentralDir (unzFile file, const unsigned char *buf, unsigned long size,
+										 unsigned long *offset, unsigned long *pos,
+										 unz_file_info *pfile_info, unz_file_info_internal *pfile_info_internal,
+										 char *szFileName, unsigned long fileNameBufferSize)
+{
+	unz_s* s;
+	const unsigned char *p;
+	uLong uSizeRead;
+
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+	s=(unz_s*)file;
+
+	if (*offset + SIZECENTRALDIRITEM > size)
+		return UNZ_BADZIPFILE;
+
+	p = buf + *offset;
+	if (unzlocal_bufLong(p)!=0x02014b50)
+		return UNZ_BADZIPFILE;
+
+	pfile_info->version = unzlocal_bufShort(p+4);
+	pfile_info->version_needed = unzlocal_bufShort(p+6);
+	pfile_info->flag = unzlocal_bufShort(p+8);
+	pfile_info->compression_method = unzlocal_bufShort(p+10);
+	pfile_info->dosDate = unzlocal_bufLong(p+12);
+	unzlocal_DosDateToTmuDate(pfile_info->dosDate,&pfile_info->tmu_date);
+	pfile_info->crc = unzlocal_bufLong(p+16);
+	pfile_info->compressed_size = unzlocal_bufLong(p+20);
+	pfile_info->uncompressed_size = unzlocal_bufLong(p+24);
+	pfile_info->size_filename = unzlocal_bufShort(p+28);
+	pfile_info->size_file_extra = unzlocal_bufShort(p+30);
+	pfile_info->size_file_comment = unzlocal_bufShort(p+32);
+	pfile_info->disk_num_start = unzlocal_bufShort(p+34);
+	pfile_info->internal_fa = unzlocal_bufShort(p+36);
+	pfile_info->external_fa = unzlocal_bufLong(p+38);
+	pfile_info_internal->offset_curfile = unzlocal_bufLong(p+42);
+
+	if (*offset + SIZECENTRALDIRITEM + pfile_info->size_filename > size)
+		return UNZ_BADZIPFILE;
+
+	if (szFileName!=NULL)
+	{
+		if (pfile_info->size_filename<fileNameBufferSize)
+		{
+			*(szFileName+pfile_info->size_filename)='\0';
+			uSizeRead = pfile_info->size_filename;
+		}
+		else
+			uSizeRead = fileNameBufferSize;
+		memcpy(szFileName,p+SIZECENTRALDIRITEM,uSizeRead);
+	}
+
+	*pos = s->offset_central_dir + *offset;
+	*offset += SIZECENTRALDIRITEM + pfile_info->size_filename +
+			pfile_info->size_file_extra + pfile_info->size_file_comment;
+	return UNZ_OK;
+}
+
 /*
   Try locate the file szFileName in the zipfile.
   For the iCaseSensitivity signification, see unzipStringFileNameCompare
@@ -1851,7 +1989,7 @@ static int unzlocal_CheckCurrentFileCoherencyHeader (unz_s* s, uInt* piSizeVar,
   Open for reading data the current file in the zipfile.
   If there is no error and the file is opened, the return value is UNZ_OK.
 */
-extern int unzOpenCurrentFile (unzFile file)
+static int unzlocal_OpenCurrentFile (unzFile file, int systemAlloc)
 {
 	int err=UNZ_OK;
 	int Store;
@@ -1899,6 +2037,7 @@ extern int unzOpenCurrentFile (unzFile file)
 
 	pfile_in_zip_read_info->crc32_wait=s->cur_file_info.crc;
 	pfile_in_zip_read_info->crc32=0;
+	pfile_in_zip_read_info->crc32_skipped=0;
 	pfile_in_zip_read_info->compression_method =
             s->cur_file_info.compression_method;
 	pfile_in_zip_read_info->file=s->file;
@@ -1908,8 +2047,16 @@ extern int unzOpenCurrentFile (unzFile file)
 
 	if (!Store)
 	{
-	  pfile_in_zip_read_info->stream.zalloc = (alloc_func)0;
-	  pfile_in_zip_read_info->stream.zfree = (free_func)0;
+	  if (systemAlloc)
+	  {
+	    pfile_in_zip_read_info->stream.zalloc = (alloc_func)zcalloc_system;
+	    pfile_in_zip_read_info->stream.zfree = (free_func)zcfree_system;
+	  }
+	  else
+	  {
+	    pfile_in_zip_read_info->stream.zalloc = (alloc_func)0;
+	    pfile_in_zip_read_info->stream.zfree = (free_func)0;
+	  }
 	  pfile_in_zip_read_info->stream.opaque = (voidp)0; 
       
 	  err=inflateInit2(&pfile_in_zip_read_info->stream, -MAX_WBITS);
@@ -1940,6 +2087,16 @@ extern int unzOpenCurrentFile (unzFile file)
     return UNZ_OK;
 }
 
+extern int unzOpenCurrentFile (unzFile file)
+{
+	return unzlocal_OpenCurrentFile(file, 0);
+}
+
+extern int unzOpenCurrentFileSystemAlloc (unzFile file)
+{
+	return unzlocal_OpenCurrentFile(file, 1);
+}
+
 
 /*
   Read bytes from the current file.
@@ -1981,6 +2138,35 @@ extern int unzReadCurrentFile  (unzFile file, void *buf, unsigned len)
 
 	while (pfile_in_zip_read_info->stream.avail_out>0)
 	{
+		if (pfile_in_zip_read_info->compression_method==0)
+		{
+			/* stored data is read straight into the output buffer */
+			uInt uReadThis = pfile_in_zip_read_info->stream.avail_out;
+			if (pfile_in_zip_read_info->rest_read_compressed<uReadThis)
+				uReadThis = (uInt)pfile_in_zip_read_info->rest_read_compressed;
+			if (uReadThis == 0)
+				return (iRead==0) ? UNZ_EOF : iRead;
+			if (fseek(pfile_in_zip_read_info->file,
+					  pfile_in_zip_read_info->pos_in_zipfile + 
+						 pfile_in_zip_read_info->byte_before_the_zipfile,SEEK_SET)!=0)
+				return UNZ_ERRNO;
+			if (fread(pfile_in_zip_read_info->stream.next_out,uReadThis,1,
+                         pfile_in_zip_read_info->file)!=1)
+				return UNZ_ERRNO;
+
+			pfile_in_zip_read_info->crc32 = crc32(pfile_in_zip_read_info->crc32,
+								pfile_in_zip_read_info->stream.next_out,
+								uReadThis);
+			pfile_in_zip_read_info->pos_in_zipfile += uReadThis;
+			pfile_in_zip_read_info->rest_read_compressed -= uReadThis;
+			pfile_in_zip_read_info->rest_read_uncompressed -= uReadThis;
+			pfile_in_zip_read_info->stream.avail_out -= uReadThis;
+			pfile_in_zip_read_info->stream.next_out += uReadThis;
+            pfile_in_zip_read_info->stream.total_out += uReadThis;
+			iRead += uReadThis;
+			continue;
+		}
+
 		if ((pfile_in_zip_read_info->stream.avail_in==0) &&
             (pfile_in_zip_read_info->rest_read_compressed>0))
 		{
@@ -2006,65 +2192,38 @@ extern int unzReadCurrentFile  (unzFile file, void *buf, unsigned len)
 			pfile_in_zip_read_info->stream.avail_in = (uInt)uReadThis;
 		}
 
-		if (pfile_in_zip_read_info->compression_method==0)
-		{
-			uInt uDoCopy,i ;
-			if (pfile_in_zip_read_info->stream.avail_out < 
-                            pfile_in_zip_read_info->stream.avail_in)
-				uDoCopy = pfile_in_zip_read_info->stream.avail_out ;
-			else
-				uDoCopy = pfile_in_zip_read_info->stream.avail_in ;
-				
-			for (i=0;i<uDoCopy;i++)
-				*(pfile_in_zip_read_info->stream.next_out+i) =
-                        *(pfile_in_zip_read_info->stream.next_in+i);
-					
-			pfile_in_zip_read_info->crc32 = crc32(pfile_in_zip_read_info->crc32,
-								pfile_in_zip_read_info->stream.next_out,
-								uDoCopy);
-			pfile_in_zip_read_info->rest_read_uncompressed-=uDoCopy;
-			pfile_in_zip_read_info->stream.avail_in -= uDoCopy;
-			pfile_in_zip_read_info->stream.avail_out -= uDoCopy;
-			pfile_in_zip_read_info->stream.next_out += uDoCopy;
-			pfile_in_zip_read_info->stream.next_in += uDoCopy;
-            pfile_in_zip_read_info->stream.total_out += uDoCopy;
-			iRead += uDoCopy;
-		}
-		else
-		{
-			uLong uTotalOutBefore,uTotalOutAfter;
-			const Byte *bufBefore;
-			uLong uOutThis;
-			int flush=Z_SYNC_FLUSH;
-
-			uTotalOutBefore = pfile_in_zip_read_info->stream.total_out;
-			bufBefore = pfile_in_zip_read_info->stream.next_out;
-
-			/*
-			if ((pfile_in_zip_read_info->rest_read_uncompressed ==
-			         pfile_in_zip_read_info->stream.avail_out) &&
-				(pfile_in_zip_read_info->rest_read_compressed == 0))
-				flush = Z_FINISH;
-			*/
-			err=inflate(&pfile_in_zip_read_info->stream,flush);
-
-			uTotalOutAfter = pfile_in_zip_read_info->stream.total_out;
-			uOutThis = uTotalOutAfter-uTotalOutBefore;
-			
-			pfile_in_zip_read_info->crc32 = 
+		uLong uTotalOutBefore,uTotalOutAfter;
+		const Byte *bufBefore;
+		uLong uOutThis;
+		int flush=Z_SYNC_FLUSH;
+
+		uTotalOutBefore = pfile_in_zip_read_info->stream.total_out;
+		bufBefore = pfile_in_zip_read_info->stream.next_out;
+
+		/*
+		if ((pfile_in_zip_read_info->rest_read_uncompressed ==
+		         pfile_in_zip_read_info->stream.avail_out) &&
+			(pfile_in_zip_read_info->rest_read_compressed == 0))
+			flush = Z_FINISH;
+		*/
+		err=inflate(&pfile_in_zip_read_info->stream,flush);
+
+		uTotalOutAfter = pfile_in_zip_read_info->stream.total_out;
+		uOutThis = uTotalOutAfter-uTotalOutBefore;
+		
+		pfile_in_zip_read_info->crc32 = 
                 crc32(pfile_in_zip_read_info->crc32,bufBefore,
                         (uInt)(uOutThis));
 
-			pfile_in_zip_read_info->rest_read_uncompressed -=
+		pfile_in_zip_read_info->rest_read_uncompressed -=
                 uOutThis;
 
-			iRead += (uInt)(uTotalOutAfter - uTotalOutBefore);
+		iRead += (uInt)(uTotalOutAfter - uTotalOutBefore);
             
-			if (err==Z_STREAM_END)
-				return (iRead==0) ? UNZ_EOF : iRead;
-			if (err!=Z_OK) 
-				break;
-		}
+		if (err==Z_STREAM_END)
+			return (iRead==0) ? UNZ_EOF : iRead;
+		if (err!=Z_OK) 
+			break;
 	}
 
 	if (err==Z_OK)
@@ -2072,6 +2231,37 @@ extern int unzReadCurrentFile  (unzFile file, void *buf, unsigned len)
 	return err;
 }
 
+/*
+  Skip len bytes of the current file without reading them. Only stored files can be skipped.
+  The crc32 of a file with skipped data isn't checked by unzCloseCurrentFile.
+  return the number of bytes skipped
+  return UNZ_PARAMERROR if the file is compressed
+*/
+extern int unzSkipCurrentFile (unzFile file, unsigned len)
+{
+	unz_s* s;
+	file_in_zip_read_info_s* pfile_in_zip_read_info;
+	if (file==NULL)
+		return UNZ_PARAMERROR;
+	s=(unz_s*)file;
+    pfile_in_zip_read_info=s->pfile_in_zip_read;
+
+	if ((pfile_in_zip_read_info==NULL) || (pfile_in_zip_read_info->compression_method!=0))
+		return UNZ_PARAMERROR;
+
+	if (len>pfile_in_zip_read_info->rest_read_uncompressed)
+		len = (uInt)pfile_in_zip_read_info->rest_read_uncompressed;
+
+	if (len>0)
+		pfile_in_zip_read_info->crc32_skipped=1;
+
+	pfile_in_zip_read_info->pos_in_zipfile += len;
+	pfile_in_zip_read_info->rest_read_compressed -= len;
+	pfile_in_zip_read_info->rest_read_uncompressed -= len;
+	pfile_in_zip_read_info->stream.total_out += len;
+	return (int)len;
+}
+
 
 /*
   Give the current position in uncompressed data
@@ -2186,7 +2376,8 @@ extern int unzCloseCurrentFile (unzFile file)
 		return UNZ_PARAMERROR;
 
 
-	if (pfile_in_zip_read_info->rest_read_uncompressed == 0)
+	if ((pfile_in_zip_read_info->rest_read_uncompressed == 0) &&
+		(!pfile_in_zip_read_info->crc32_skipped))
 	{
 		if (pfile_in_zip_read_info->crc32 != pfile_in_zip_read_info->crc32_wait)
 			err=UNZ_CRCERROR;
@@ -4470,3 +4661,15 @@ void  zcfree (voidp opaque, voidp ptr)
     Mem_Free(ptr);
     if (opaque) return; /* make compiler happy */
 }
+
+voidp zcalloc_system (voidp opaque, unsigned items, unsigned size)
+{
+    if (opaque) items += size - size; /* make compiler happy */
+    return (voidp)calloc(items, size);
+}
+
+void  zcfree_system (voidp opaque, voidp ptr)
+{
+    free(ptr);
+    if (opaque) return; /* make compiler happy */
+}
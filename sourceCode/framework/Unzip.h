@@ -123,6 +123,7 @@ typedef struct
 
 	unsigned long crc32;					/* crc32 of all data uncompressed */
 	unsigned long crc32_wait;				/* crc32 we must obtain after decompress all */
+	unsigned long crc32_skipped;			/* flag set if data was skipped, the crc32 can't be checked */
 	unsigned long rest_read_compressed;		/* number of unsigned char to be decompressed */
 	unsigned long rest_read_uncompressed;	/*number of unsigned char to be obtained after decomp*/
 	FILE* file;								/* io structore of the zipfile */
@@ -245,6 +246,32 @@ extern int unzSetCurrentFileInfoPosition (unzFile file, unsigned long pos );
   return UNZ_OK if there is no problem
 */
 
+extern int unzSetCurrentFileInfo (unzFile file, unsigned long pos, const unz_file_info *pfile_info, const unz_file_info_internal *pfile_info_internal);
+
+/*
+  Set the current file from info gathered with unzGetFileInfoFromCentralDir, without
+  reading the central directory again.
+  return UNZ_OK if there is no problem
+*/
+
+extern int unzReadCentralDir (unzFile file, unsigned char **buf, unsigned long *size);
+extern void unzFreeCentralDir (unsigned char *buf);
+
+/*
+  Read the whole central directory with a single read. *buf has to be freed
+  with unzFreeCentralDir.
+  return UNZ_OK if there is no problem
+*/
+
+extern int unzGetFileInfoFromCentralDir (unzFile file, const unsigned char *buf, unsigned long size, unsigned long *offset, unsigned long *pos, unz_file_info *pfile_info, unz_file_info_internal *pfile_info_internal, char *szFileName, unsigned long fileNameBufferSize);
+
+/*
+  Parse the info of the file at *offset in a central directory read with
+  unzReadCentralDir, and advance *offset to the next file.
+  *pos receives the position of the file info for unzSetCurrentFileInfo.
+  return UNZ_OK if there is no problem
+*/
+
 extern int unzLocateFile (unzFile file, const char *szFileName, int iCaseSensitivity);
 
 /*
@@ -284,6 +311,13 @@ extern int unzOpenCurrentFile (unzFile file);
   If there is no error, the return value is UNZ_OK.
 */
 
+extern int unzOpenCurrentFileSystemAlloc (unzFile file);
+
+/*
+  Same as unzOpenCurrentFile, but inflate allocates with calloc / free instead
+  of the idLib heap, so the file can be read on a thread that may not use it.
+*/
+
 extern int unzCloseCurrentFile (unzFile file);
 
 /*
@@ -305,6 +339,16 @@ extern int unzReadCurrentFile (unzFile file, void* buf, unsigned len);
     (UNZ_ERRNO for IO error, or zLib error for uncompress error)
 */
 
+extern int unzSkipCurrentFile (unzFile file, unsigned len);
+
+/*
+  Skip len unsigned chars of the current file without reading them.
+  Only stored files can be skipped. The crc32 of a file with skipped
+  data isn't checked by unzCloseCurrentFile.
+  return the number of unsigned chars skipped
+  return UNZ_PARAMERROR if the file is compressed
+*/
+
 extern long unztell(unzFile file);
 
 /*
@@ -821,6 +821,9 @@ void idGameEdit::ParseSpawnArgsToRenderEntity( const idDict *args, renderEntity_
 	// check noDynamicInteractions flag
 	renderEntity->noDynamicInteractions = args->GetBool( "noDynamicInteractions" );
 
+	// large opaque models can hide what is behind them from the renderer
+	renderEntity->occluder = args->GetBool( "occluder" );
+
 	// check noshadows flag
 	renderEntity->noShadow = args->GetBool( "noshadows" );
 
@@ -4235,6 +4238,8 @@ bool idEntity::UpdateRenderEntity( renderEntity_s *renderEntity, const renderVie
 
 	idAnimator *animator = GetAnimator();
 	if ( animator ) {
+		// the entity is in view, the animation LOD interpolates its frames
+		animator->SetViewed( gameLocal.time );
 		return animator->CreateFrame( gameLocal.time, false );
 	}
 
@@ -5941,6 +5946,8 @@ bool idEntity::RunPhysics( void ) {
 	trace_t		results;
 	bool		moved;
 
+	PROFILE_ZONE( Physics );
+
 	// don't run physics if not enabled
 	if ( !( thinkFlags & TH_PHYSICS ) ) {
 		// however do update any animation controllers
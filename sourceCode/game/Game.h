@@ -372,6 +372,8 @@ typedef struct {
 	idDeclManager *				declManager;			// declaration manager
 	idAASFileManager *			AASFileManager;			// AAS file manager
 	idCollisionModelManager *	collisionModelManager;	// collision model manager
+	idProfiler *				profiler;				// frame profiler
+	idParallelJobManager *		parallelJobManager;		// job threads
 
 } gameImport_t;
 
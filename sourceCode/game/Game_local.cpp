@@ -179,6 +179,10 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 	idLib::common				= common;
 	idLib::cvarSystem			= cvarSystem;
 	idLib::fileSystem			= fileSystem;
+	idLib::profiler				= import->profiler;
+
+	// the game's jobs run on the engine's job threads
+	parallelJobManager			= import->parallelJobManager;
 
 	// setup export interface
 	gameExport.version = GAME_API_VERSION;
@@ -216,6 +220,8 @@ void TestGameAPI( void ) {
 	testImport.declManager				= ::declManager;
 	testImport.AASFileManager			= ::AASFileManager;
 	testImport.collisionModelManager	= ::collisionModelManager;
+	testImport.profiler					= idLib::profiler;
+	testImport.parallelJobManager		= ::parallelJobManager;
 
 	testExport = *GetGameAPI( &testImport );
 }
@@ -583,6 +589,7 @@ void idGameLocal::Init( void ) {
 	m_DownloadMenu = CDownloadMenuPtr(new CDownloadMenu);
 	m_DownloadManager = CDownloadManagerPtr(new CDownloadManager);
 	m_ConversationSystem = ai::ConversationSystemPtr(new ai::ConversationSystem);
+	m_PerceptionManager = ai::PerceptionManagerPtr(new ai::PerceptionManager);
 	
 	// load the soundprop globals from the def file
 	m_sndPropLoader->GlobalsFromDef();
@@ -747,6 +754,8 @@ void idGameLocal::Shutdown( void ) {
 	// Destroy the conversation system
 	m_ConversationSystem.reset();
 
+	m_PerceptionManager.reset();
+
 	// Destroy the mission manager
 	m_MissionManager.reset();
 
@@ -1495,7 +1504,9 @@ void idGameLocal::LoadMap( const char *mapName, int randseed ) {
 			delete mapFile;
 		}
 		mapFile = new idMapFile;
-		if ( !mapFile->Parse( idStr( mapName ) + ".map" ) ) {
+		// the game only needs the entities, the brushes and patches are compiled into the .proc and .cm files
+		const bool loaded = cv_map_entity_cache.GetBool() ? mapFile->ParseEntities( idStr( mapName ) + ".map" ) : mapFile->Parse( idStr( mapName ) + ".map" );
+		if ( !loaded ) {
 			delete mapFile;
 			mapFile = NULL;
 			Error( "Couldn't load %s", mapName );
@@ -2482,6 +2493,10 @@ void idGameLocal::MapShutdown( void ) {
 	{
 		m_ConversationSystem->Clear();
 	}
+	if (m_PerceptionManager != NULL)
+	{
+		m_PerceptionManager->Clear();
+	}
 
 	m_DifficultyManager.Clear();
 
@@ -3198,6 +3213,8 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 	const renderView_t *view;
 	int curframe = framenum;
 
+	PROFILE_ZONE( Game_RunFrame );
+
 	ret.sessionCommand[0] = 0; // grayman #3139 - must be cleared here, to handle the "player waiting" time
 	g_Global.m_Frame = curframe;
 	DM_LOG(LC_FRAME, LT_INFO)LOGSTRING("Frame start\r");
@@ -3318,6 +3335,12 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			// sort the active entity list
 			SortActiveEntityList();
 
+			// TDM: Compute the read-only part of the AI perception in parallel, before the entities think
+			if (m_PerceptionManager != NULL)
+			{
+				m_PerceptionManager->Update();
+			}
+
 			timer_think.Clear();
 			timer_think.Start();
 
@@ -3391,7 +3414,10 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 			timer_events.Start();
 
 			// service any pending events
-			idEvent::ServiceEvents();
+			{
+				PROFILE_ZONE( Game_Events );
+				idEvent::ServiceEvents();
+			}
 
 			timer_events.Stop();
 
@@ -7588,6 +7614,8 @@ CStimResponsePtr idGameLocal::FindStimResponse(int uniqueId)
 
 void idGameLocal::ProcessStimResponse(unsigned long ticks)
 {
+	PROFILE_ZONE( Stims );
+
 	if (cv_sr_disable.GetBool())
 	{
 		return; // S/R disabled, skip this
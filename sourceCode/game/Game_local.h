@@ -174,6 +174,9 @@ typedef boost::shared_ptr<CLightController> CLightControllerPtr;
 namespace ai { 
 	class ConversationSystem;
 	typedef boost::shared_ptr<ConversationSystem> ConversationSystemPtr;
+
+	class PerceptionManager;
+	typedef boost::shared_ptr<PerceptionManager> PerceptionManagerPtr;
 } // namespace
 
 class CDownloadMenu;
@@ -550,6 +553,9 @@ public:
 	// The manager class for all map conversations
 	ai::ConversationSystemPtr	m_ConversationSystem;
 
+	// Computes the AI's perception of the player in parallel jobs, before the entities think
+	ai::PerceptionManagerPtr	m_PerceptionManager;
+
 	/**
 	 * greebo: The fan-mission-handling class. Also contains GUI handling code.
 	 */
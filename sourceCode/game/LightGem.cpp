@@ -25,41 +25,22 @@ static bool versioned = RegisterVersionedFile("$Id: LightGem.cpp 6001 2014-05-18
 #include "LightGem.h"
 #include "Grabber.h"
 
-// Temporary profiling related macros
-
-//#define ENABLE_PROFILING
-
-#ifdef ENABLE_PROFILING
-#define PROFILE_BLOCK( block_tag )																				\
-class __profile_block {																							\
-	idTimer m_timeStamp;																						\
-public:																											\
-	__profile_block()  {																						\
-	m_timeStamp.Start();																						\
-	}																											\
-	~__profile_block()  {																						\
-	m_timeStamp.Stop();																							\
-	gameLocal.Printf( #block_tag" : %lf \n\n", m_timeStamp.Milliseconds() );									\
-	}																											\
-}	_profile_blockInstance_##block_tag;																			\
+// Profiler zones of the light gem calculation, see idProfiler
 
+#define PROFILE_BLOCK( block_tag )			PROFILE_ZONE( block_tag )
 
 #define PROFILE_BLOCK_START( block_tag )																		\
-	idTimer timer##block_tag;																					\
-	timer##block_tag.Start()																					\
+	const bool profile##block_tag = ( idLib::profiler != NULL && idLib::profiler->IsEnabled() );				\
+	if ( profile##block_tag ) {																					\
+		idLib::profiler->BeginZone( #block_tag );																\
+	}																											\
 
 // PROFILE_BLOCK_END requires PROFILE_BLOCK_START to be placed before it, to work.
 #define PROFILE_BLOCK_END( block_tag )																			\
-	timer##block_tag.Stop();																					\
-	gameLocal.Printf( #block_tag": %lf \n", timer##block_tag.Milliseconds() )									\
-
-#else
-
-#define PROFILE_BLOCK( block_tag )
-#define PROFILE_BLOCK_START( block_tag )
-#define PROFILE_BLOCK_END( block_tag )	
+	if ( profile##block_tag ) {																					\
+		idLib::profiler->EndZone();																				\
+	}																											\
 
-#endif
 //------------------------
 // Construction/Destruction
 //----------------------------------------------------
@@ -188,12 +169,14 @@ void LightGem::Restore( idRestoreGame & a_savedGame )
 float LightGem::Calculate(idPlayer *player)
 {
 	PROFILE_BLOCK( LightGem_Calculate );
-	PROFILE_BLOCK_START( LightGem_Calculate_Setup);
 
 	// If player is hidden (i.e the whole player entity is actually hidden)
 	if ( player->GetModelDefHandle() == -1 ) {
 		return 0.0f;
 	}
+
+	// the zone has to be closed on every path, so it starts after the early out
+	PROFILE_BLOCK_START( LightGem_Calculate_Setup);
 	
 	{ // Get position for lg
 		idEntity* lg = m_LightgemSurface.GetEntity();
@@ -445,6 +445,8 @@ void CsndProp::Propagate
 	idList<idEntity *>	validTypeEnts, validEnts;
 	SPopArea			*pPopArea;
 
+	PROFILE_ZONE( SoundProp );
+
 	idTimer timer_Prop;
 	if ( cv_spr_debug.GetBool() ) // grayman - only time things if the debug cvar is set
 	{
@@ -98,6 +98,14 @@ int	TimerManager::CreateTimer(const idStr& entityname, const idStr& name)
 	return timerId;
 }
 
+const char* TimerManager::GetZoneName(int timerId)
+{
+	TimerMap::iterator found = _timers.find(timerId);
+	assert(found != _timers.end());
+
+	return _zoneNames.insert(found->second.name.c_str()).first->c_str();
+}
+
 void TimerManager::StartTimer(int timerId)
 {
 	TimerMap::iterator found = _timers.find(timerId);
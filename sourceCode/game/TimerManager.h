@@ -43,6 +43,10 @@
 
 #ifdef TIMING_BUILD
 
+#include <map>
+#include <set>
+#include <string>
+
 namespace debugtools {
 
 class TimerManager
@@ -71,6 +75,9 @@ public:
 	void	DumpTimerResults(const char* const separator = ";", const char* const comma = ".");
 	void	Clear();
 
+	// Name of the timer for profiler zones, stays valid after the timer is destroyed
+	const char*	GetZoneName(int timerId);
+
 	// Resets all timers to 0, doesn't destroy any timers
 	void	ResetTimers();
 
@@ -80,22 +87,36 @@ public:
 private:
 	typedef std::map<int, TimerInfo> TimerMap;
 	TimerMap _timers;
+
+	// Never cleared, the profiler keeps pointers to these until a trace is written
+	std::set<std::string> _zoneNames;
 };
 
-// Scoped object, stops timing at destruction
+// Scoped object, stops timing at destruction. Also records a profiler zone
+// with the name of the timer while the profiler is enabled.
 class ScopedTimer
 {
 	int _id;
+	bool _zone;
 public:
 	ScopedTimer(int timerId) :
 		_id(timerId)
 	{
+		_zone = (idLib::profiler != NULL && idLib::profiler->IsEnabled());
+		if (_zone)
+		{
+			idLib::profiler->BeginZone(TimerManager::Instance().GetZoneName(_id));
+		}
 		TimerManager::Instance().StartTimer(_id);
 	}
 
 	~ScopedTimer()
 	{
 		TimerManager::Instance().StopTimer(_id);
+		if (_zone)
+		{
+			idLib::profiler->EndZone();
+		}
 	}
 };
 
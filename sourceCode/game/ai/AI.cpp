@@ -2304,6 +2304,8 @@ idAI::Think
 void idAI::Think( void ) 
 {
 	START_SCOPED_TIMING(aiThinkTimer, scopedThinkTimer);
+	PROFILE_ZONE( AI_Think );
+
 	if (cv_ai_opt_nothink.GetBool()) 
 	{
 		return; // Thinking is disabled.
@@ -2638,7 +2640,8 @@ bool idAI::ThinkingIsAllowed()
 		}
 
 		// PVS check: let the AI think every frame as long as the player sees them.
-		bool inPVS = gameLocal.InPlayerPVS(this);
+		const ai::Perception* perception = GetPerception();
+		bool inPVS = (perception != NULL) ? perception->inPlayerPVS : gameLocal.InPlayerPVS(this);
 		if (!inPVS)
 		{
 			return false;
@@ -9996,6 +9999,12 @@ float idAI::GetBaseAcuity(const char *type) const
 	return returnval;
 }
 
+// spawnargs which are looked up in every frame
+static const idDictKey KEY_DRUNK("drunk");
+static const idDictKey KEY_DRUNK_ACUITY_FACTOR("drunk_acuity_factor");
+static const idDictKey KEY_UNARMED_MELEE("unarmed_melee");
+static const idDictKey KEY_UNARMED_RANGED("unarmed_ranged");
+
 float idAI::GetAcuity(const char *type) const
 {
 	float returnval = GetBaseAcuity(type);
@@ -10043,9 +10052,9 @@ float idAI::GetAcuity(const char *type) const
 //	}
 
 	// angua: drunken AI have reduced acuity, unless they have seen evidence of intruders
-	if ( spawnArgs.GetBool("drunk", "0") && !HasSeenEvidence() )
+	if ( spawnArgs.GetBool(KEY_DRUNK, "0") && !HasSeenEvidence() )
 	{
-		returnval *= spawnArgs.GetFloat("drunk_acuity_factor", "1");
+		returnval *= spawnArgs.GetFloat(KEY_DRUNK_ACUITY_FACTOR, "1");
 	}
 
 	//DM_LOG(LC_AI, LT_DEBUG)LOGSTRING("Acuity %s = %f\r", type, returnval);
@@ -10097,8 +10106,19 @@ idEntity *idAI::GetTactEnt( void )
 
 void idAI::PerformVisualScan(float timecheck)
 {
+	// The acuity, PVS, FOV and visibility were computed by the perception jobs
+	// before the entities started thinking, unless they are turned off
+	const ai::Perception* perception = GetPerception();
+
 	// Only perform enemy checks if we are in the player's PVS
-	if ( ( GetAcuity("vis") <= 0 ) || !gameLocal.InPlayerPVS(this) )
+	if (perception != NULL)
+	{
+		if ( ( perception->visAcuity <= 0 ) || !perception->inPlayerPVS )
+		{
+			return;
+		}
+	}
+	else if ( ( GetAcuity("vis") <= 0 ) || !gameLocal.InPlayerPVS(this) )
 	{
 		return;
 	}
@@ -10115,7 +10135,14 @@ void idAI::PerformVisualScan(float timecheck)
 		return;
 	}
 
-	if (!CheckFOV(player->GetEyePosition()))
+	if (perception != NULL && perception->fovChecked)
+	{
+		if (!perception->playerInFOV)
+		{
+			return;
+		}
+	}
+	else if (!CheckFOV(player->GetEyePosition()))
 	{
 		// if we can't see the player's eyes, maybe we can see his feet
 		if (!CheckFOV(player->GetPhysics()->GetOrigin()))
@@ -10150,7 +10177,7 @@ void idAI::PerformVisualScan(float timecheck)
 	}
 
 	// Check the candidate's visibility.
-	float vis = GetVisibility(player);
+	float vis = (perception != NULL) ? perception->playerVisibility : GetVisibility(player);
 
 	if ( vis == 0.0f )
 	{
@@ -11851,16 +11878,24 @@ bool idAI::CheckFOV( const idVec3 &pos ) const
 {
 	//DM_LOG(LC_AI,LT_DEBUG)LOGSTRING("idAI::CheckFOV called \r");
 
-	float	dotHoriz, dotVert, lenDelta, lenDeltaH;
-	idVec3	delta, deltaH, deltaV, HeadCenter;
+	idVec3	HeadCenter;
 	idMat3	HeadAxis;
 
 	// ugliness
 	const_cast<idAI *>(this)->GetJointWorldTransform( m_HeadJointID, gameLocal.time, HeadCenter, HeadAxis );
+
+	return CheckFOV( pos, HeadCenter, HeadAxis );
+}
+
+bool idAI::CheckFOV( const idVec3 &pos, const idVec3 &headOrigin, const idMat3 &HeadAxis ) const
+{
+	float	dotHoriz, dotVert, lenDelta, lenDeltaH;
+	idVec3	delta, deltaH, deltaV, HeadCenter;
+
 	idMat3 HeadAxisR = m_FOVRot * HeadAxis;
 
 	// Offset to get the center of the head
-	HeadCenter += HeadAxis * m_HeadCenterOffset;
+	HeadCenter = headOrigin + HeadAxis * m_HeadCenterOffset;
 	delta = pos - HeadCenter;
 	lenDelta = delta.Length(); // Consider LengthFast if error is not too bad
 
@@ -11878,6 +11913,29 @@ bool idAI::CheckFOV( const idVec3 &pos ) const
 	return ( dotHoriz >= m_fovDotHoriz && dotVert >= m_fovDotVert );
 }
 
+bool idAI::GetLastHeadTransform( idVec3 &origin, idMat3 &axis )
+{
+	int			numJoints;
+	idJointMat*	joints;
+
+	if ( m_HeadJointID == INVALID_JOINT )
+	{
+		return false;
+	}
+
+	animator.GetJoints( &numJoints, &joints );
+	if ( joints == NULL || m_HeadJointID >= numJoints )
+	{
+		return false;
+	}
+
+	// the render entity still has the transform the last frame was presented with
+	origin = renderEntity.origin + joints[ m_HeadJointID ].ToVec3() * renderEntity.axis;
+	axis = joints[ m_HeadJointID ].ToMat3() * renderEntity.axis;
+
+	return true;
+}
+
 void idAI::FOVDebugDraw( void )
 {
 	float AngVert(0), AngHoriz(0), radius(0);
@@ -13131,8 +13189,8 @@ bool idAI::CanGreet() // grayman #3338
 		 ( greetingState == ECannotGreetYet ) || // not allowed to greet yet
 		 ( AI_AlertIndex >= ai::EObservant)	  || // too alert
 		 ( GetMemory().fleeing ) || // grayman #3140 - no greeting if fleeing
-		 ( GetAttackFlag(COMBAT_MELEE)  && !spawnArgs.GetBool("unarmed_melee","0") )  || // visible melee weapon drawn
-		 ( GetAttackFlag(COMBAT_RANGED) && !spawnArgs.GetBool("unarmed_ranged","0") ) )  // visible ranged weapon drawn
+		 ( GetAttackFlag(COMBAT_MELEE)  && !spawnArgs.GetBool(KEY_UNARMED_MELEE,"0") )  || // visible melee weapon drawn
+		 ( GetAttackFlag(COMBAT_RANGED) && !spawnArgs.GetBool(KEY_UNARMED_RANGED,"0") ) )  // visible ranged weapon drawn
 	{
 		return false;
 	}
@@ -27,6 +27,7 @@
 #include "../HidingSpotSearchCollection.h"
 #include "../darkmodHidingSpotTree.h"
 #include "MoveState.h"
+#include "PerceptionManager.h"
 
 #include <list>
 #include <set>
@@ -1355,6 +1356,15 @@ public: // greebo: Made these public for now, I didn't want to write an accessor
 	int						GetThinkInterleave() const; // grayman 2414 - add 'const'
 	int						m_nextThinkFrame;
 
+	// Perception of the player computed by the ai::PerceptionManager before the entities think
+	ai::Perception			m_Perception;
+
+	// The perception results of this frame, or NULL if they weren't computed
+	const ai::Perception*	GetPerception() const
+	{
+		return (m_Perception.frame == gameLocal.framenum) ? &m_Perception : NULL;
+	}
+
 	// Below min dist, the AI thinks normally every frame.
 	// Above max dist, the thinking frequency is given by max interleave think frames.
 	// The thinking frequency increases linearly between min and max dist.
@@ -1590,6 +1600,18 @@ public: // greebo: Made these public for now, I didn't want to write an accessor
 	**/
 	virtual bool			CheckFOV( const idVec3 &pos ) const;
 
+	/**
+	* The FOV check for a given world transform of the head joint
+	**/
+	bool					CheckFOV( const idVec3 &pos, const idVec3 &headOrigin, const idMat3 &headAxis ) const;
+
+	/**
+	* The world transform of the head joint in the last animation frame.
+	* Unlike GetJointWorldTransform() this doesn't create a new frame, so it
+	* can be used by the perception jobs. Returns false if there is no head joint.
+	**/
+	bool					GetLastHeadTransform( idVec3 &origin, idMat3 &axis );
+
 	/**
 	* Darkmod enemy tracking: Is an entity shrouded in darkness?
 	* @author: SophisticatedZombie, tels
@@ -0,0 +1,157 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_game.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "../Game_local.h"
+#include "PerceptionManager.h"
+
+namespace ai
+{
+
+// Number of AI processed by one job
+const int AI_PER_PERCEPTION_JOB = 8;
+
+PerceptionManager::PerceptionManager() :
+	_player(NULL)
+{
+	_inputs.SetGranularity(64);
+	_playerPVS.i = -1;
+	_playerPVS.h = 0;
+}
+
+void PerceptionManager::Clear()
+{
+	_inputs.Clear();
+	_jobs.Clear();
+	_player = NULL;
+	_playerPVS.i = -1;
+	_playerPVS.h = 0;
+}
+
+void PerceptionManager::Update()
+{
+	PROFILE_ZONE( AI_Perception );
+
+	_inputs.SetNum(0, false);
+	_jobs.SetNum(0, false);
+
+	// The visibility debug output draws from GetVisibility(), which can only
+	// be done on the main thread. The AI compute everything while thinking then.
+	if (!cv_ai_opt_parallelperception.GetBool() || cv_ai_visdist_show.GetFloat() > 0)
+	{
+		return;
+	}
+
+	// Snapshot of the player
+	_player = gameLocal.GetLocalPlayer();
+	_playerPVS = gameLocal.GetPlayerPVS();
+	if (_player != NULL)
+	{
+		_playerEyePosition = _player->GetEyePosition();
+		_playerOrigin = _player->GetPhysics()->GetOrigin();
+	}
+
+	// Gather the AI. The PVS areas of an entity are updated lazily, which
+	// has to happen here and not in the jobs.
+	for (idEntity* ent = gameLocal.activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next())
+	{
+		if (!ent->IsType(idAI::Type))
+		{
+			continue;
+		}
+
+		idAI* ai = static_cast<idAI*>(ent);
+
+		AIInput& input = _inputs.Alloc();
+		input.ai = ai;
+		input.numPVSAreas = ai->GetNumPVSAreas();
+		memcpy(input.pvsAreas, ai->GetPVSAreas(), input.numPVSAreas * sizeof(input.pvsAreas[0]));
+	}
+
+	if (_inputs.Num() == 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < _inputs.Num(); i += AI_PER_PERCEPTION_JOB)
+	{
+		Job& job = _jobs.Alloc();
+		job.manager = this;
+		job.first = i;
+		job.num = Min(AI_PER_PERCEPTION_JOB, _inputs.Num() - i);
+	}
+
+	// The jobs don't allocate, so the engine's allocators don't have to be serialized.
+	// The main thread only waits, nothing changes the entities while the jobs run.
+	idParallelJobList jobList("aiPerception", false);
+	for (int i = 0; i < _jobs.Num(); i++)
+	{
+		jobList.AddJob(RunJob, &_jobs[i]);
+	}
+	jobList.Submit();
+	jobList.Wait();
+}
+
+void PerceptionManager::RunJob(void* data)
+{
+	const Job* job = static_cast<const Job*>(data);
+
+	for (int i = 0; i < job->num; i++)
+	{
+		job->manager->ProcessAI(job->manager->_inputs[job->first + i]);
+	}
+}
+
+// Runs in a job. Only reads the snapshot and the entities, and only writes the AI's perception.
+void PerceptionManager::ProcessAI(const AIInput& input) const
+{
+	idAI* ai = input.ai;
+	Perception& perception = ai->m_Perception;
+
+	perception.frame = gameLocal.framenum;
+	perception.visAcuity = ai->GetAcuity("vis");
+	perception.inPlayerPVS = (_playerPVS.i != -1 && gameLocal.pvs.InCurrentPVS(_playerPVS, input.pvsAreas, input.numPVSAreas));
+	perception.fovChecked = false;
+	perception.playerInFOV = false;
+	perception.playerVisibility = 0;
+
+	// PerformVisualScan doesn't look any further
+	if (_player == NULL || perception.visAcuity <= 0 || !perception.inPlayerPVS)
+	{
+		return;
+	}
+
+	idVec3 headOrigin;
+	idMat3 headAxis;
+	if (ai->GetLastHeadTransform(headOrigin, headAxis))
+	{
+		// if we can't see the player's eyes, maybe we can see his feet
+		perception.fovChecked = true;
+		perception.playerInFOV = ai->CheckFOV(_playerEyePosition, headOrigin, headAxis) ||
+								 ai->CheckFOV(_playerOrigin, headOrigin, headAxis);
+	}
+
+	perception.playerVisibility = ai->GetVisibility(_player);
+}
+
+} // namespace ai
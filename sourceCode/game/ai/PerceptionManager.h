@@ -0,0 +1,100 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#ifndef __AI_PERCEPTION_MANAGER_H__
+#define __AI_PERCEPTION_MANAGER_H__
+
+class idAI;
+class idPlayer;
+
+namespace ai
+{
+
+/**
+ * The read-only part of an AI's perception of the player, which is computed
+ * for all active AI in parallel jobs before the entities think. The serial
+ * think (PerformVisualScan, ThinkingIsAllowed) consumes these results and
+ * only does the traces and the decisions itself.
+ *
+ * The results are based on a snapshot of the frame before any entity
+ * thinks. The FOV uses the head pose of the last animation frame, which
+ * is not updated while the entities move.
+ */
+struct Perception
+{
+	int		frame;				// the results are only valid in this frame (gameLocal.framenum)
+	bool	inPlayerPVS;
+	float	visAcuity;			// GetAcuity("vis")
+	bool	fovChecked;			// false if the head pose wasn't available, CheckFOV has to be called
+	bool	playerInFOV;		// the player's eyes or feet are in the FOV
+	float	playerVisibility;	// GetVisibility(player)
+
+	Perception() :
+		frame(-1),
+		inPlayerPVS(false),
+		visAcuity(0),
+		fovChecked(false),
+		playerInFOV(false),
+		playerVisibility(0)
+	{}
+};
+
+class PerceptionManager
+{
+private:
+	// Everything a job can't read from the AI itself, taken before the jobs start
+	struct AIInput
+	{
+		idAI*	ai;
+		int		numPVSAreas;
+		int		pvsAreas[idEntity::MAX_PVS_AREAS];
+	};
+
+	// A block of AI processed by one job
+	struct Job
+	{
+		PerceptionManager*	manager;
+		int					first;
+		int					num;
+	};
+
+	idList<AIInput> _inputs;
+	idList<Job> _jobs;
+
+	// Snapshot of the player
+	idPlayer*	_player;
+	pvsHandle_t	_playerPVS;
+	idVec3		_playerEyePosition;
+	idVec3		_playerOrigin;
+
+	static void RunJob(void* data);
+	void ProcessAI(const AIInput& input) const;
+
+public:
+	PerceptionManager();
+
+	// Computes the perception of all active AI, called before the entities think
+	void Update();
+
+	void Clear();
+};
+
+} // namespace ai
+
+#endif /* __AI_PERCEPTION_MANAGER_H__ */
@@ -27,6 +27,15 @@ static bool versioned = RegisterVersionedFile("$Id: Anim.cpp 5185 2012-01-08 05:
 
 bool idAnimManager::forceExport = false;
 
+// binary anim cache, written to generated/<path of the anim>.bmd5anim
+#define MD5_ANIM_CACHE_DIR			"generated/"
+#define MD5_ANIM_CACHE_EXT			"bmd5anim"
+#define MD5_ANIM_CACHE_IDENT		( ( 'A' << 24 ) + ( '5' << 16 ) + ( 'D' << 8 ) + 'M' )
+#define MD5_ANIM_CACHE_VERSION		1
+
+// components which change less than this over all frames are stored once
+#define MD5_ANIM_CONSTANT_EPSILON	1e-5f
+
 /***********************************************************************
 
 	idMD5Anim
@@ -44,6 +53,9 @@ idMD5Anim::idMD5Anim() {
 	numJoints	= 0;
 	frameRate	= 24;
 	animLength	= 0;
+	numAnimatedComponents	= 0;
+	numQuantizedComponents	= 0;
+	numFloatComponents		= 0;
 	totaldelta.Zero();
 }
 
@@ -70,9 +82,16 @@ void idMD5Anim::Free( void ) {
 
 	totaldelta.Zero();
 
+	numAnimatedComponents	= 0;
+	numQuantizedComponents	= 0;
+	numFloatComponents		= 0;
+
 	jointInfo.Clear();
 	bounds.Clear();
-	componentFrames.Clear();
+	baseFrame.Clear();
+	components.Clear();
+	quantizedFrames.Clear();
+	floatFrames.Clear();
 }
 
 /*
@@ -140,30 +159,73 @@ idMD5Anim::Allocated
 ====================
 */
 size_t idMD5Anim::Allocated( void ) const {
-	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size_t	size = bounds.Allocated() + jointInfo.Allocated() + baseFrame.Allocated() + components.Allocated() + quantizedFrames.Allocated() + floatFrames.Allocated() + name.Allocated();
 	return size;
 }
 
 /*
 ====================
 idMD5Anim::LoadAnim
+
+Loads the binary cache of the anim if it was written from the same source file,
+otherwise parses the text and writes the cache.
 ====================
 */
 bool idMD5Anim::LoadAnim( const char *filename ) {
-	int		version;
-	idLexer	parser( LEXFL_ALLOWPATHNAMES | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT );
-	idToken	token;
-	int		i, j;
-	int		num;
+	void *	buffer;
+	idStr	cacheName;
 
-	if ( !parser.LoadFile( filename ) ) {
+	const int length = fileSystem->ReadFile( filename, &buffer );
+	if ( length < 0 || !buffer ) {
 		return false;
 	}
 
+	const unsigned int checksum = CRC32_BlockChecksum( buffer, length );
+
+	cacheName = MD5_ANIM_CACHE_DIR;
+	cacheName += filename;
+	cacheName.SetFileExtension( MD5_ANIM_CACHE_EXT );
+
 	Free();
 
+	if ( cv_anim_cache.GetBool() ) {
+		if ( LoadBinary( cacheName, checksum ) ) {
+			fileSystem->FreeFile( buffer );
+			name = filename;
+			return true;
+		}
+		Free();
+	}
+
 	name = filename;
 
+	idLexer	parser( LEXFL_ALLOWPATHNAMES | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT );
+	parser.LoadMemory( static_cast<const char *>( buffer ), length, filename );
+
+	const bool parsed = ParseAnim( parser );
+
+	parser.FreeSource();
+	fileSystem->FreeFile( buffer );
+
+	if ( parsed && cv_anim_cache.GetBool() ) {
+		WriteBinary( cacheName, checksum );
+	}
+
+	return parsed;
+}
+
+/*
+====================
+idMD5Anim::ParseAnim
+====================
+*/
+bool idMD5Anim::ParseAnim( idLexer &parser ) {
+	int				version;
+	idToken			token;
+	int				i, j;
+	int				num;
+	idList<float>	componentFrames;
+
 	parser.ExpectTokenString( MD5_VERSION_STRING );
 	version = parser.ParseInt();
 	if ( version != MD5_VERSION ) {
@@ -314,6 +376,8 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	}
 	baseFrame[ 0 ].t.Zero();
 
+	CompressComponents( componentFrames );
+
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
@@ -321,6 +385,291 @@ bool idMD5Anim::LoadAnim( const char *filename ) {
 	return true;
 }
 
+/*
+====================
+idMD5Anim::CompressComponents
+
+Components which do not change are stored once. The translation of the origin keeps
+full precision because it moves the entity, all other components are quantized to
+16 bits over their range.
+====================
+*/
+void idMD5Anim::CompressComponents( const idList<float> &componentFrames ) {
+	int i, j;
+
+	int numOriginComponents = 0;
+	if ( numJoints > 0 ) {
+		for( i = jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ); i; i &= i - 1 ) {
+			numOriginComponents++;
+		}
+	}
+
+	components.SetGranularity( 1 );
+	components.SetNum( numAnimatedComponents );
+	numQuantizedComponents = 0;
+	numFloatComponents = 0;
+
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		animComponent_t &component = components[ i ];
+
+		float minValue = componentFrames[ i ];
+		float maxValue = componentFrames[ i ];
+		for( j = 1; j < numFrames; j++ ) {
+			const float value = componentFrames[ j * numAnimatedComponents + i ];
+			minValue = Min( minValue, value );
+			maxValue = Max( maxValue, value );
+		}
+
+		if ( maxValue - minValue <= MD5_ANIM_CONSTANT_EPSILON ) {
+			component.type = ANIMCOMPONENT_CONSTANT;
+			component.index = 0;
+			component.offset = ( minValue + maxValue ) * 0.5f;
+			component.scale = 0.0f;
+		} else if ( numJoints > 0 && i >= jointInfo[ 0 ].firstComponent && i < jointInfo[ 0 ].firstComponent + numOriginComponents ) {
+			component.type = ANIMCOMPONENT_FLOAT;
+			component.index = numFloatComponents++;
+			component.offset = 0.0f;
+			component.scale = 0.0f;
+		} else {
+			component.type = ANIMCOMPONENT_QUANTIZED;
+			component.index = numQuantizedComponents++;
+			component.offset = minValue;
+			component.scale = ( maxValue - minValue ) / 65535.0f;
+		}
+	}
+
+	quantizedFrames.SetGranularity( 1 );
+	quantizedFrames.SetNum( numFrames * numQuantizedComponents );
+	floatFrames.SetGranularity( 1 );
+	floatFrames.SetNum( numFrames * numFloatComponents );
+
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		const animComponent_t &component = components[ i ];
+
+		for( j = 0; j < numFrames; j++ ) {
+			const float value = componentFrames[ j * numAnimatedComponents + i ];
+			if ( component.type == ANIMCOMPONENT_QUANTIZED ) {
+				const int quantized = idMath::Ftoi( ( value - component.offset ) / component.scale + 0.5f );
+				quantizedFrames[ j * numQuantizedComponents + component.index ] = static_cast<unsigned short>( idMath::ClampInt( 0, 65535, quantized ) );
+			} else if ( component.type == ANIMCOMPONENT_FLOAT ) {
+				floatFrames[ j * numFloatComponents + component.index ] = value;
+			}
+		}
+	}
+}
+
+/*
+====================
+idMD5Anim::DecodeJointComponents
+
+Writes the animated components of a joint in a frame, in the order of the anim bits.
+====================
+*/
+ID_INLINE void idMD5Anim::DecodeJointComponents( int framenum, const jointAnimInfo_t &info, float *jointComponents ) const {
+	const animComponent_t *component = &components[ info.firstComponent ];
+
+	for( int bits = info.animBits; bits; bits &= bits - 1, component++, jointComponents++ ) {
+		switch( component->type ) {
+			case ANIMCOMPONENT_CONSTANT:
+				*jointComponents = component->offset;
+				break;
+			case ANIMCOMPONENT_QUANTIZED:
+				*jointComponents = component->offset + component->scale * quantizedFrames[ framenum * numQuantizedComponents + component->index ];
+				break;
+			case ANIMCOMPONENT_FLOAT:
+				*jointComponents = floatFrames[ framenum * numFloatComponents + component->index ];
+				break;
+		}
+	}
+}
+
+/*
+====================
+idMD5Anim::LoadBinary
+====================
+*/
+bool idMD5Anim::LoadBinary( const char *fileName, unsigned int sourceChecksum ) {
+	int				i;
+	int				ident;
+	int				version;
+	unsigned int	checksum;
+	idStr			jointName;
+
+	idFile *file = fileSystem->OpenFileRead( fileName );
+	if ( !file ) {
+		return false;
+	}
+
+	file->ReadInt( ident );
+	file->ReadInt( version );
+	file->ReadUnsignedInt( checksum );
+	if ( ident != MD5_ANIM_CACHE_IDENT || version != MD5_ANIM_CACHE_VERSION || checksum != sourceChecksum ) {
+		fileSystem->CloseFile( file );
+		return false;
+	}
+
+	file->ReadInt( numFrames );
+	file->ReadInt( numJoints );
+	file->ReadInt( frameRate );
+	file->ReadInt( animLength );
+	file->ReadInt( numAnimatedComponents );
+	file->ReadInt( numQuantizedComponents );
+	file->ReadInt( numFloatComponents );
+	file->ReadVec3( totaldelta );
+
+	if ( numFrames <= 0 || numJoints <= 0 || numAnimatedComponents < 0 || numAnimatedComponents > numJoints * 6
+		|| numQuantizedComponents < 0 || numFloatComponents < 0 || numQuantizedComponents + numFloatComponents > numAnimatedComponents ) {
+		common->Warning( "Invalid animation cache '%s'", fileName );
+		fileSystem->CloseFile( file );
+		return false;
+	}
+
+	jointInfo.SetGranularity( 1 );
+	jointInfo.SetNum( numJoints );
+	for( i = 0; i < numJoints; i++ ) {
+		file->ReadString( jointName );
+		jointInfo[ i ].nameIndex = animationLib.JointIndex( jointName );
+		file->ReadInt( jointInfo[ i ].parentNum );
+		file->ReadInt( jointInfo[ i ].animBits );
+		file->ReadInt( jointInfo[ i ].firstComponent );
+
+		// the same checks as the text parser, plus the components of the joint have to exist
+		const jointAnimInfo_t &info = jointInfo[ i ];
+		if ( info.parentNum >= i || ( i != 0 && info.parentNum < 0 ) || ( info.animBits & ~63 )
+			|| ( info.animBits != 0 && ( info.firstComponent < 0 || info.firstComponent + idMath::BitCount( info.animBits ) > numAnimatedComponents ) ) ) {
+			common->Warning( "Invalid animation cache '%s'", fileName );
+			fileSystem->CloseFile( file );
+			return false;
+		}
+	}
+
+	bounds.SetGranularity( 1 );
+	bounds.SetNum( numFrames );
+	for( i = 0; i < numFrames; i++ ) {
+		file->ReadVec3( bounds[ i ][ 0 ] );
+		file->ReadVec3( bounds[ i ][ 1 ] );
+	}
+
+	baseFrame.SetGranularity( 1 );
+	baseFrame.SetNum( numJoints );
+	for( i = 0; i < numJoints; i++ ) {
+		file->ReadVec3( baseFrame[ i ].t );
+		file->ReadFloat( baseFrame[ i ].q.x );
+		file->ReadFloat( baseFrame[ i ].q.y );
+		file->ReadFloat( baseFrame[ i ].q.z );
+		file->ReadFloat( baseFrame[ i ].q.w );
+	}
+
+	components.SetGranularity( 1 );
+	components.SetNum( numAnimatedComponents );
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		animComponent_t &component = components[ i ];
+		file->ReadInt( component.type );
+		file->ReadInt( component.index );
+		file->ReadFloat( component.offset );
+		file->ReadFloat( component.scale );
+
+		if ( ( component.type == ANIMCOMPONENT_QUANTIZED && ( component.index < 0 || component.index >= numQuantizedComponents ) )
+			|| ( component.type == ANIMCOMPONENT_FLOAT && ( component.index < 0 || component.index >= numFloatComponents ) )
+			|| component.type < ANIMCOMPONENT_CONSTANT || component.type > ANIMCOMPONENT_FLOAT ) {
+			common->Warning( "Invalid animation cache '%s'", fileName );
+			fileSystem->CloseFile( file );
+			return false;
+		}
+	}
+
+	// the frames are read in one block, they are little endian in the file
+	quantizedFrames.SetGranularity( 1 );
+	quantizedFrames.SetNum( numFrames * numQuantizedComponents );
+	const int quantizedBytes = quantizedFrames.Num() * sizeof( quantizedFrames[ 0 ] );
+	bool complete = ( file->Read( quantizedFrames.Ptr(), quantizedBytes ) == quantizedBytes );
+	for( i = 0; i < quantizedFrames.Num(); i++ ) {
+		quantizedFrames[ i ] = static_cast<unsigned short>( LittleShort( static_cast<short>( quantizedFrames[ i ] ) ) );
+	}
+
+	floatFrames.SetGranularity( 1 );
+	floatFrames.SetNum( numFrames * numFloatComponents );
+	const int floatBytes = floatFrames.Num() * sizeof( floatFrames[ 0 ] );
+	complete &= ( file->Read( floatFrames.Ptr(), floatBytes ) == floatBytes );
+	for( i = 0; i < floatFrames.Num(); i++ ) {
+		floatFrames[ i ] = LittleFloat( floatFrames[ i ] );
+	}
+
+	fileSystem->CloseFile( file );
+
+	if ( !complete ) {
+		common->Warning( "Truncated animation cache '%s'", fileName );
+		return false;
+	}
+
+	return true;
+}
+
+/*
+====================
+idMD5Anim::WriteBinary
+====================
+*/
+void idMD5Anim::WriteBinary( const char *fileName, unsigned int sourceChecksum ) const {
+	int i;
+
+	idFile *file = fileSystem->OpenFileWrite( fileName );
+	if ( !file ) {
+		common->Warning( "Couldn't write animation cache '%s'", fileName );
+		return;
+	}
+
+	file->WriteInt( MD5_ANIM_CACHE_IDENT );
+	file->WriteInt( MD5_ANIM_CACHE_VERSION );
+	file->WriteUnsignedInt( sourceChecksum );
+
+	file->WriteInt( numFrames );
+	file->WriteInt( numJoints );
+	file->WriteInt( frameRate );
+	file->WriteInt( animLength );
+	file->WriteInt( numAnimatedComponents );
+	file->WriteInt( numQuantizedComponents );
+	file->WriteInt( numFloatComponents );
+	file->WriteVec3( totaldelta );
+
+	for( i = 0; i < numJoints; i++ ) {
+		file->WriteString( animationLib.JointName( jointInfo[ i ].nameIndex ) );
+		file->WriteInt( jointInfo[ i ].parentNum );
+		file->WriteInt( jointInfo[ i ].animBits );
+		file->WriteInt( jointInfo[ i ].firstComponent );
+	}
+
+	for( i = 0; i < numFrames; i++ ) {
+		file->WriteVec3( bounds[ i ][ 0 ] );
+		file->WriteVec3( bounds[ i ][ 1 ] );
+	}
+
+	for( i = 0; i < numJoints; i++ ) {
+		file->WriteVec3( baseFrame[ i ].t );
+		file->WriteFloat( baseFrame[ i ].q.x );
+		file->WriteFloat( baseFrame[ i ].q.y );
+		file->WriteFloat( baseFrame[ i ].q.z );
+		file->WriteFloat( baseFrame[ i ].q.w );
+	}
+
+	for( i = 0; i < numAnimatedComponents; i++ ) {
+		file->WriteInt( components[ i ].type );
+		file->WriteInt( components[ i ].index );
+		file->WriteFloat( components[ i ].offset );
+		file->WriteFloat( components[ i ].scale );
+	}
+
+	for( i = 0; i < quantizedFrames.Num(); i++ ) {
+		file->WriteUnsignedShort( quantizedFrames[ i ] );
+	}
+
+	for( i = 0; i < floatFrames.Num(); i++ ) {
+		file->WriteFloat( floatFrames[ i ] );
+	}
+
+	fileSystem->CloseFile( file );
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -436,8 +785,13 @@ void idMD5Anim::GetOrigin( idVec3 &offset, int time, int cyclecount ) const {
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float components1[ 6 ];
+	float components2[ 6 ];
+	DecodeJointComponents( frame.frame1, jointInfo[ 0 ], components1 );
+	DecodeJointComponents( frame.frame2, jointInfo[ 0 ], components2 );
+
+	const float *componentPtr1 = components1;
+	const float *componentPtr2 = components2;
 
 	if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -478,8 +832,13 @@ void idMD5Anim::GetOriginRotation( idQuat &rotation, int time, int cyclecount )
 
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float	*jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float	*jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float components1[ 6 ];
+	float components2[ 6 ];
+	DecodeJointComponents( frame.frame1, jointInfo[ 0 ], components1 );
+	DecodeJointComponents( frame.frame2, jointInfo[ 0 ], components2 );
+
+	const float	*jointframe1 = components1;
+	const float	*jointframe2 = components2;
 
 	if ( animBits & ANIM_TX ) {
 		jointframe1++;
@@ -592,8 +951,13 @@ void idMD5Anim::GetBounds( idBounds &bnds, int time, int cyclecount ) const {
 	// origin position
 	offset = baseFrame[ 0 ].t;
 	if ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) {
-		const float *componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float *componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float components1[ 6 ];
+		float components2[ 6 ];
+		DecodeJointComponents( frame.frame1, jointInfo[ 0 ], components1 );
+		DecodeJointComponents( frame.frame2, jointInfo[ 0 ], components2 );
+
+		const float *componentPtr1 = components1;
+		const float *componentPtr2 = components2;
 
 		if ( jointInfo[ 0 ].animBits & ANIM_TX ) {
 			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
@@ -623,8 +987,8 @@ idMD5Anim::GetInterpolatedFrame
 */
 void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints, const int *index, int numIndexes ) const {
 	int						i, numLerpJoints;
-	const float				*frame1;
-	const float				*frame2;
+	float					components1[ 6 ];
+	float					components2[ 6 ];
 	const float				*jointframe1;
 	const float				*jointframe2;
 	const jointAnimInfo_t	*infoPtr;
@@ -646,9 +1010,6 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 	lerpIndex = (int *)_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 	numLerpJoints = 0;
 
-	frame1 = &componentFrames[ frame.frame1 * numAnimatedComponents ];
-	frame2 = &componentFrames[ frame.frame2 * numAnimatedComponents ];
-
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
 		jointPtr = &joints[j];
@@ -660,8 +1021,11 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t &frame, idJointQuat *joints,
 
 			lerpIndex[numLerpJoints++] = j;
 
-			jointframe1 = frame1 + infoPtr->firstComponent;
-			jointframe2 = frame2 + infoPtr->firstComponent;
+			// decode the compressed components of both frames
+			DecodeJointComponents( frame.frame1, *infoPtr, components1 );
+			DecodeJointComponents( frame.frame2, *infoPtr, components2 );
+			jointframe1 = components1;
+			jointframe2 = components2;
 
 			switch( animBits & (ANIM_TX|ANIM_TY|ANIM_TZ) ) {
 				case 0:
@@ -813,7 +1177,7 @@ idMD5Anim::GetSingleFrame
 */
 void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *index, int numIndexes ) const {
 	int						i;
-	const float				*frame;
+	float					components[ 6 ];
 	const float				*jointframe;
 	int						animBits;
 	idJointQuat				*jointPtr;
@@ -827,8 +1191,6 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		return;
 	}
 
-	frame = &componentFrames[ framenum * numAnimatedComponents ];
-
 	for ( i = 0; i < numIndexes; i++ ) {
 		int j = index[i];
 		jointPtr = &joints[j];
@@ -837,7 +1199,8 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat *joints, const int *in
 		animBits = infoPtr->animBits;
 		if ( animBits ) {
 
-			jointframe = frame + infoPtr->firstComponent;
+			DecodeJointComponents( framenum, *infoPtr, components );
+			jointframe = components;
 
 			if ( animBits & (ANIM_TX|ANIM_TY|ANIM_TZ) ) {
 
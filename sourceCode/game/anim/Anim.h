@@ -30,6 +30,7 @@
 const int ANIM_NumAnimChannels		= 5;
 const int ANIM_MaxAnimsPerChannel	= 3;
 const int ANIM_MaxSyncedAnims		= 3;
+const int ANIM_LOD_MAX_LEVEL		= 3;	// the animation LOD updates at most every ( USERCMD_MSEC << ANIM_LOD_MAX_LEVEL ) msec
 
 //
 // animation channels.  make sure to change script/doom_defs.script if you add any channels, or change their order
@@ -68,6 +69,19 @@ typedef struct {
 	int						firstComponent;
 } jointAnimInfo_t;
 
+typedef enum {
+	ANIMCOMPONENT_CONSTANT,		// same value in all frames, not stored per frame
+	ANIMCOMPONENT_QUANTIZED,	// 16 bits per frame over the range of the component
+	ANIMCOMPONENT_FLOAT			// full precision per frame
+} animComponentType_t;
+
+typedef struct {
+	int						type;
+	int						index;		// index in the quantized or float frames
+	float					offset;		// value of constant components, minimum of quantized components
+	float					scale;		// step of quantized components
+} animComponent_t;
+
 typedef struct {
 	jointHandle_t			num;
 	jointHandle_t			parentNum;
@@ -281,7 +295,11 @@ private:
 	idList<idBounds>		bounds;
 	idList<jointAnimInfo_t>	jointInfo;
 	idList<idJointQuat>		baseFrame;
-	idList<float>			componentFrames;
+	idList<animComponent_t>	components;				// one for each animated component
+	int						numQuantizedComponents;
+	int						numFloatComponents;
+	idList<unsigned short>	quantizedFrames;		// numFrames * numQuantizedComponents
+	idList<float>			floatFrames;			// numFrames * numFloatComponents
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
@@ -320,6 +338,13 @@ public:
 	* DarkMod: Set the framerate to something different from what's in the file.
 	**/
 	void					SetFrameRate( int frRate );
+
+private:
+	bool					ParseAnim( idLexer &parser );
+	void					CompressComponents( const idList<float> &componentFrames );
+	bool					LoadBinary( const char *fileName, unsigned int sourceChecksum );
+	void					WriteBinary( const char *fileName, unsigned int sourceChecksum ) const;
+	void					DecodeJointComponents( int framenum, const jointAnimInfo_t &info, float *jointComponents ) const;
 };
 
 /*
@@ -409,18 +434,25 @@ public:
 	const char *				GetJointName( int jointHandle ) const;
 	int							NumJointsOnChannel( int channel ) const;
 	const int *					GetChannelJoints( int channel ) const;
+								// channel joints without the "lodskip" joints, used by the animation LOD
+	int							NumLODJointsOnChannel( int channel ) const;
+	const int *					GetLODChannelJoints( int channel ) const;
+	const idList<int> &			GetLODSkipJoints( void ) const;
 
 	const idVec3 &				GetVisualOffset( void ) const;
 
 private:
 	void						CopyDecl( const idDeclModelDef *decl );
 	bool						ParseAnim( idLexer &src, int numDefaultAnims );
+	void						SetupLODChannelJoints( void );
 
 private:
 	idVec3						offset;
 	idList<jointInfo_t>			joints;
 	idList<int>					jointParents;
 	idList<int>					channelJoints[ ANIM_NumAnimChannels ];
+	idList<int>					lodSkipJoints;			// joints which are not animated by the animation LOD
+	idList<int>					lodChannelJoints[ ANIM_NumAnimChannels ];
 	idRenderModel *				modelHandle;
 	idList<idAnim *>			anims;
 	const idDeclSkin *			skin;
@@ -475,7 +507,7 @@ private:
 	void						SetFrame( const idDeclModelDef *modelDef, int animnum, int frame, int currenttime, int blendtime, const idEntity *ent );
 	void						CycleAnim( const idDeclModelDef *modelDef, int animnum, int currenttime, int blendtime, const idEntity *ent );
 	void						PlayAnim( const idDeclModelDef *modelDef, int animnum, int currenttime, int blendtime, const idEntity *ent );
-	bool						BlendAnim( int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOrigin, bool overrideBlend, bool printInfo ) const;
+	bool						BlendAnim( int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOrigin, bool overrideBlend, bool lodJoints, bool printInfo ) const;
 	void						BlendOrigin( int currentTime, idVec3 &blendPos, float &blendWeight, bool removeOriginOffset ) const;
 	void						BlendDelta( int fromtime, int totime, idVec3 &blendDelta, float &blendWeight ) const;
 	void						BlendDeltaRotation( int fromtime, int totime, idQuat &blendDelta, float &blendWeight ) const;
@@ -600,6 +632,8 @@ public:
 	void						ForceUpdate( void );
 	void						ClearForceUpdate( void );
 	bool						CreateFrame( int animtime, bool force );
+								// called when the entity is rendered, the animation LOD interpolates the frames of viewed actors
+	void						SetViewed( int currentTime );
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
@@ -648,6 +682,11 @@ private:
 	void						FreeData( void );
 	void						PushAnims( int channel, int currentTime, int blendTime );
 
+	int							GetLODLevel( int currentTime, bool &viewed ) const;
+	bool						BuildFrame( int currentTime, idJointMat *frameJoints, bool lodJoints, bool debugInfo );
+	bool						BuildLODFrame( int currentTime, int lodLevel, bool debugInfo );
+	void						ResetLODFrames( void );
+
 private:
 	const idDeclModelDef *		modelDef;
 	idEntity *					entity;
@@ -664,6 +703,13 @@ private:
 
 	idBounds					frameBounds;
 
+	// animation LOD, two frames computed ahead which are interpolated for viewed actors
+	idJointMat *				lodFrames[ 2 ];
+	int							lodFrameTimes[ 2 ];
+	int							lodUpdateTime;			// last update of an actor which is not viewed
+	int							lastViewedTime;
+	idList<idJointQuat>			lodSkipPose;			// local joints of the last full detail frame, used for the lodskip joints
+
 	float						AFPoseBlendWeight;
 	idList<int>					AFPoseJoints;
 	idList<idAFPoseJointMod>	AFPoseJointMods;
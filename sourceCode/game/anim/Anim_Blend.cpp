@@ -2657,7 +2657,7 @@ void idAnimBlend::CallFrameCommands( idEntity *ent, int fromtime, int totime ) c
 idAnimBlend::BlendAnim
 =====================
 */
-bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOriginOffset, bool overrideBlend, bool printInfo ) const {
+bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJointQuat *blendFrame, float &blendWeight, bool removeOriginOffset, bool overrideBlend, bool lodJoints, bool printInfo ) const {
 	int				i;
 	float			lerp;
 	float			mixWeight;
@@ -2700,17 +2700,21 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 
 	time = AnimTime( currentTime );
 
+	// the animation LOD skips the "lodskip" joints, they keep the base frame or the blended pose
+	const int *channelJoints = lodJoints ? modelDef->GetLODChannelJoints( channel ) : modelDef->GetChannelJoints( channel );
+	const int numChannelJoints = lodJoints ? modelDef->NumLODJointsOnChannel( channel ) : modelDef->NumJointsOnChannel( channel );
+
 	numAnims = anim->NumAnims();
 	if ( numAnims == 1 ) 
 	{
 		md5anim = anim->MD5Anim( 0 );
 		if ( frame ) 
 		{
-			md5anim->GetSingleFrame( frame - 1, jointFrame, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+			md5anim->GetSingleFrame( frame - 1, jointFrame, channelJoints, numChannelJoints );
 		} else 
 		{
 			md5anim->ConvertTimeToFrame( time, cycle, frametime );
-			md5anim->GetInterpolatedFrame( frametime, jointFrame, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+			md5anim->GetInterpolatedFrame( frametime, jointFrame, channelJoints, numChannelJoints );
 		}
 	} else 
 	{
@@ -2732,15 +2736,15 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 				md5anim = anim->MD5Anim( i );
 				if ( frame ) 
 				{
-					md5anim->GetSingleFrame( frame - 1, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+					md5anim->GetSingleFrame( frame - 1, ptr, channelJoints, numChannelJoints );
 				} else 
 				{
-					md5anim->GetInterpolatedFrame( frametime, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+					md5anim->GetInterpolatedFrame( frametime, ptr, channelJoints, numChannelJoints );
 				}
 
 				// only blend after the first anim is mixed in
 				if ( ptr != jointFrame ) {
-					SIMDProcessor->BlendJoints( jointFrame, ptr, lerp, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+					SIMDProcessor->BlendJoints( jointFrame, ptr, lerp, channelJoints, numChannelJoints );
 				}
 
 				ptr = mixFrame;
@@ -2769,10 +2773,8 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 	if ( !blendWeight ) {
 		blendWeight = weight;
 		if ( channel != ANIMCHANNEL_ALL ) {
-			const int *index = modelDef->GetChannelJoints( channel );
-			const int num = modelDef->NumJointsOnChannel( channel );
-			for( i = 0; i < num; i++ ) {
-				int j = index[i];
+			for( i = 0; i < numChannelJoints; i++ ) {
+				int j = channelJoints[i];
 				blendFrame[j].t = jointFrame[j].t;
 				blendFrame[j].q = jointFrame[j].q;
 			}
@@ -2780,7 +2782,7 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
     } else {
 		blendWeight += weight;
 		lerp = weight / blendWeight;
-		SIMDProcessor->BlendJoints( blendFrame, jointFrame, lerp, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+		SIMDProcessor->BlendJoints( blendFrame, jointFrame, lerp, channelJoints, numChannelJoints );
 	}
 
 	if ( printInfo ) {
@@ -3033,6 +3035,7 @@ idDeclModelDef::idDeclModelDef() {
 	offset.Zero();
 	for ( int i = 0; i < ANIM_NumAnimChannels; i++ ) {
 		channelJoints[i].Clear();
+		lodChannelJoints[i].Clear();
 	}
 }
 
@@ -3079,7 +3082,9 @@ void idDeclModelDef::CopyDecl( const idDeclModelDef *decl ) {
 	memcpy( jointParents.Ptr(), decl->jointParents.Ptr(), decl->jointParents.Num() * sizeof( jointParents[0] ) );
 	for ( i = 0; i < ANIM_NumAnimChannels; i++ ) {
 		channelJoints[i] = decl->channelJoints[i];
+		lodChannelJoints[i] = decl->lodChannelJoints[i];
 	}
+	lodSkipJoints = decl->lodSkipJoints;
 }
 
 /*
@@ -3094,8 +3099,10 @@ void idDeclModelDef::FreeData( void ) {
 	modelHandle	= NULL;
 	skin = NULL;
 	offset.Zero();
+	lodSkipJoints.Clear();
 	for ( int i = 0; i < ANIM_NumAnimChannels; i++ ) {
 		channelJoints[i].Clear();
+		lodChannelJoints[i].Clear();
 	}
 }
 
@@ -3710,6 +3717,39 @@ bool idDeclModelDef::Parse( const char *text, const int textLength ) {
 				channelJoints[ channel ][ num++ ] = jointnum;
 			}
 			channelJoints[ channel ].SetNum( num );
+		} else if ( token == "lodskip" ) {
+			if ( !modelHandle ) {
+				src.Warning( "Must specify mesh before defining lodskip joints" );
+				MakeDefault();
+				return false;
+			}
+
+			// joints which are not animated when the animation LOD reduces the detail, like fingers and the face
+			if ( !src.CheckTokenString( "(" ) ) {
+				src.Warning( "Expected ( after 'lodskip'\n" );
+				MakeDefault();
+				return false;
+			}
+
+			jointnames = "";
+
+			while( !src.CheckTokenString( ")" ) ) {
+				if( !src.ReadToken( &token2 ) ) {
+					src.Warning( "Unexpected end of file" );
+					MakeDefault();
+					return false;
+				}
+				jointnames += token2;
+				if ( ( token2 != "*" ) && ( token2 != "-" ) ) {
+					jointnames += " ";
+				}
+			}
+
+			GetJointList( jointnames, jointList );
+
+			for( i = 0; i < jointList.Num(); i++ ) {
+				lodSkipJoints.AddUnique( jointList[ i ] );
+			}
 		} else {
 			src.Warning( "unknown token '%s' on line %i in '%s'", token.c_str(), token.line, src.GetFileName() );
 			MakeDefault();
@@ -3721,9 +3761,35 @@ bool idDeclModelDef::Parse( const char *text, const int textLength ) {
 	anims.SetGranularity( 1 );
 	anims.SetNum( anims.Num() );
 
+	SetupLODChannelJoints();
+
 	return true;
 }
 
+/*
+=====================
+idDeclModelDef::SetupLODChannelJoints
+
+Removes the lodskip joints from the joint lists of the channels. The origin is always animated.
+=====================
+*/
+void idDeclModelDef::SetupLODChannelJoints( void ) {
+	int i, j;
+
+	for( i = 0; i < ANIM_NumAnimChannels; i++ ) {
+		lodChannelJoints[ i ].SetGranularity( 1 );
+		lodChannelJoints[ i ].SetNum( 0 );
+		lodChannelJoints[ i ].Resize( channelJoints[ i ].Num() );
+		for( j = 0; j < channelJoints[ i ].Num(); j++ ) {
+			const int jointnum = channelJoints[ i ][ j ];
+			if ( jointnum != 0 && lodSkipJoints.FindIndex( jointnum ) >= 0 ) {
+				continue;
+			}
+			lodChannelJoints[ i ].Append( jointnum );
+		}
+	}
+}
+
 /*
 =====================
 idDeclModelDef::HasAnim
@@ -3930,6 +3996,39 @@ const int * idDeclModelDef::GetChannelJoints( int channel ) const {
 	return channelJoints[ channel ].Ptr();
 }
 
+/*
+=====================
+idDeclModelDef::NumLODJointsOnChannel
+=====================
+*/
+int idDeclModelDef::NumLODJointsOnChannel( int channel ) const {
+	if ( ( channel < 0 ) || ( channel >= ANIM_NumAnimChannels ) ) {
+		gameLocal.Error( "idDeclModelDef::NumLODJointsOnChannel : channel out of range" );
+	}
+	return lodChannelJoints[ channel ].Num();
+}
+
+/*
+=====================
+idDeclModelDef::GetLODChannelJoints
+=====================
+*/
+const int * idDeclModelDef::GetLODChannelJoints( int channel ) const {
+	if ( ( channel < 0 ) || ( channel >= ANIM_NumAnimChannels ) ) {
+		gameLocal.Error( "idDeclModelDef::GetLODChannelJoints : channel out of range" );
+	}
+	return lodChannelJoints[ channel ].Ptr();
+}
+
+/*
+=====================
+idDeclModelDef::GetLODSkipJoints
+=====================
+*/
+const idList<int> &idDeclModelDef::GetLODSkipJoints( void ) const {
+	return lodSkipJoints;
+}
+
 /*
 =====================
 idDeclModelDef::GetVisualOffset
@@ -3961,12 +4060,17 @@ idAnimator::idAnimator() {
 	stoppedAnimatingUpdate	= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
+	lodFrames[ 0 ]			= NULL;
+	lodFrames[ 1 ]			= NULL;
+	lastViewedTime			= -1;
 
 	frameBounds.Clear();
+	ResetLODFrames();
 
 	AFPoseJoints.SetGranularity( 1 );
 	AFPoseJointMods.SetGranularity( 1 );
 	AFPoseJointFrame.SetGranularity( 1 );
+	lodSkipPose.SetGranularity( 1 );
 
 	ClearAFPose();
 
@@ -3995,6 +4099,10 @@ size_t idAnimator::Allocated( void ) const {
 	size_t	size;
 
 	size = jointMods.Allocated() + numJoints * sizeof( joints[0] ) + jointMods.Num() * sizeof( jointMods[ 0 ] ) + AFPoseJointMods.Allocated() + AFPoseJointFrame.Allocated() + AFPoseJoints.Allocated();
+	if ( lodFrames[ 0 ] ) {
+		size += 2 * numJoints * sizeof( joints[0] );
+	}
+	size += lodSkipPose.Allocated();
 
 	return size;
 }
@@ -4175,6 +4283,13 @@ void idAnimator::FreeData( void ) {
 	joints = NULL;
 	numJoints = 0;
 
+	Mem_Free16( lodFrames[ 0 ] );
+	Mem_Free16( lodFrames[ 1 ] );
+	lodFrames[ 0 ] = NULL;
+	lodFrames[ 1 ] = NULL;
+	lodSkipPose.Clear();
+	ResetLODFrames();
+
 	modelDef = NULL;
 
 	ForceUpdate();
@@ -4189,6 +4304,8 @@ void idAnimator::PushAnims( int channelNum, int currentTime, int blendTime ) {
 	int			i;
 	idAnimBlend *channel;
 
+	ResetLODFrames();
+
 	channel = channels[ channelNum ];
 	if ( !channel[ 0 ].GetWeight( currentTime ) || ( channel[ 0 ].starttime == currentTime ) ) {
 		return;
@@ -4292,6 +4409,7 @@ idRenderModel* idAnimator::SwapLODModel( const char *modelname ) {
 
 	// OK to proceed
 	modelDef = newmodel;
+	ResetLODFrames();
 	// make sure model hasn't been purged
 	modelDef->Touch();
 
@@ -4473,6 +4591,7 @@ void idAnimator::Clear( int channelNum, int currentTime, int cleartime ) {
 	for( i = 0; i < ANIM_MaxAnimsPerChannel; i++, blend++ ) {
 		blend->Clear( currentTime, cleartime );
 	}
+	ResetLODFrames();
 	ForceUpdate();
 }
 
@@ -5072,6 +5191,7 @@ void idAnimator::ClearAFPose( void ) {
 	if ( AFPoseJoints.Num() ) {
 		ForceUpdate();
 	}
+	ResetLODFrames();
 	AFPoseBlendWeight = 1.0f;
 	AFPoseJoints.SetNum( 0, false );
 	AFPoseBounds.Clear();
@@ -5188,17 +5308,9 @@ idAnimator::CreateFrame
 =====================
 */
 bool idAnimator::CreateFrame( int currentTime, bool force ) {
-	int					i, j;
-	int					numJoints;
-	int					parentNum;
-	bool				hasAnim;
+	int					lodLevel;
+	bool				viewed;
 	bool				debugInfo;
-	float				baseBlend;
-	float				blendWeight;
-	const idAnimBlend *	blend;
-	const int *			jointParent;
-	const jointMod_t *	jointMod;
-	const idJointQuat *	defaultPose;
 
 	static idCVar		r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 
@@ -5220,19 +5332,179 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	}
 	
 	// Optional optimisation: Skip animations for dormant entities
-	if (cv_ai_opt_noanims.GetBool() && entity->CheckDormant()) return false;
+	if (cv_ai_opt_noanims.GetBool() && entity && entity->CheckDormant()) return false;
+
+	// the last frame after the animations stopped is always created at full detail
+	if ( force || r_showSkel.GetInteger() || stoppedAnimatingUpdate ) {
+		lodLevel = 0;
+		viewed = true;
+	} else {
+		lodLevel = GetLODLevel( currentTime, viewed );
+	}
+
+	// actors which are not viewed keep their joints until the next update is due
+	if ( lodLevel > 0 && !viewed && lodUpdateTime >= 0 && currentTime >= lodUpdateTime && currentTime - lodUpdateTime < ( USERCMD_MSEC << lodLevel ) ) {
+		return false;
+	}
 
 	lastTransformTime = currentTime;
+	lodUpdateTime = currentTime;
 	stoppedAnimatingUpdate = false;
 
 	if ( entity && ( ( g_debugAnim.GetInteger() == entity->entityNumber ) || ( g_debugAnim.GetInteger() == -2 ) ) ) {
 		debugInfo = true;
 		gameLocal.Printf( "---------------\n%d: entity '%s':\n", gameLocal.time, entity->GetName() );
  		gameLocal.Printf( "model '%s':\n", modelDef->GetModelName() );
+		if ( lodLevel > 0 ) {
+			gameLocal.Printf( "animation LOD %d%s\n", lodLevel, viewed ? ", interpolated" : "" );
+		}
 	} else {
 		debugInfo = false;
 	}
 
+	if ( lodLevel > 0 && viewed ) {
+		return BuildLODFrame( currentTime, lodLevel, debugInfo );
+	}
+
+	return BuildFrame( currentTime, joints, lodLevel > 0, debugInfo );
+}
+
+/*
+=====================
+idAnimator::GetLODLevel
+
+Level 0 updates every frame with all joints, each further level halves the update rate
+and skips the lodskip joints of the modelDef. The level depends on the size of the
+actor on screen, actors which have not been viewed recently drop one more level.
+=====================
+*/
+int idAnimator::GetLODLevel( int currentTime, bool &viewed ) const {
+	viewed = ( lastViewedTime >= 0 && currentTime >= lastViewedTime && currentTime - lastViewedTime <= 2 * USERCMD_MSEC );
+
+	if ( !cv_anim_lod.GetBool() || !entity || AFPoseJoints.Num() || gameLocal.inCinematic ) {
+		return 0;
+	}
+
+	const idPlayer *player = gameLocal.GetLocalPlayer();
+	if ( !player || entity == player ) {
+		return 0;
+	}
+
+	// approximate the fraction of the screen covered by the actor
+	const renderEntity_t *renderEntity = entity->GetRenderEntity();
+	const float radius = renderEntity->bounds.GetRadius();
+	const float distance = ( renderEntity->origin - player->GetEyePosition() ).LengthFast();
+	if ( distance <= radius ) {
+		return 0;
+	}
+
+	const float screenSize = radius / ( distance * idMath::Tan( DEG2RAD( g_fov.GetFloat() * 0.5f ) ) );
+	float lodSize = cv_anim_lod_size.GetFloat() / Max( cv_lod_bias.GetFloat(), 0.01f );
+
+	int lodLevel = 0;
+	while( lodLevel < ANIM_LOD_MAX_LEVEL && screenSize < lodSize ) {
+		lodLevel++;
+		lodSize *= 0.5f;
+	}
+
+	if ( !viewed ) {
+		lodLevel = Min( lodLevel + 1, ANIM_LOD_MAX_LEVEL );
+	}
+
+	return lodLevel;
+}
+
+/*
+=====================
+idAnimator::BuildLODFrame
+
+Viewed actors with a reduced update rate get two frames computed ahead, the joints
+are interpolated between them in every frame.
+=====================
+*/
+bool idAnimator::BuildLODFrame( int currentTime, int lodLevel, bool debugInfo ) {
+	const int interval = USERCMD_MSEC << lodLevel;
+
+	if ( !lodFrames[ 0 ] ) {
+		lodFrames[ 0 ] = ( idJointMat * )Mem_Alloc16( numJoints * sizeof( lodFrames[ 0 ][ 0 ] ) );
+		lodFrames[ 1 ] = ( idJointMat * )Mem_Alloc16( numJoints * sizeof( lodFrames[ 1 ][ 0 ] ) );
+	}
+
+	if ( lodFrameTimes[ 0 ] < 0 || currentTime < lodFrameTimes[ 0 ] || currentTime >= lodFrameTimes[ 1 ] + interval ) {
+		// start over at the current time
+		if ( !BuildFrame( currentTime, lodFrames[ 0 ], true, debugInfo ) || !BuildFrame( currentTime + interval, lodFrames[ 1 ], true, false ) ) {
+			ResetLODFrames();
+			return BuildFrame( currentTime, joints, true, false );
+		}
+		lodFrameTimes[ 0 ] = currentTime;
+		lodFrameTimes[ 1 ] = currentTime + interval;
+	} else if ( currentTime >= lodFrameTimes[ 1 ] ) {
+		// advance to the next frame
+		idSwap( lodFrames[ 0 ], lodFrames[ 1 ] );
+		lodFrameTimes[ 0 ] = lodFrameTimes[ 1 ];
+		if ( !BuildFrame( lodFrameTimes[ 0 ] + interval, lodFrames[ 1 ], true, debugInfo ) ) {
+			ResetLODFrames();
+			return BuildFrame( currentTime, joints, true, false );
+		}
+		lodFrameTimes[ 1 ] = lodFrameTimes[ 0 ] + interval;
+	}
+
+	const float lerp = ( float )( currentTime - lodFrameTimes[ 0 ] ) / ( float )( lodFrameTimes[ 1 ] - lodFrameTimes[ 0 ] );
+	const int numFloats = numJoints * sizeof( joints[ 0 ] ) / sizeof( float );
+
+	if ( lerp <= 0.0f ) {
+		SIMDProcessor->Memcpy( joints, lodFrames[ 0 ], numJoints * sizeof( joints[ 0 ] ) );
+	} else {
+		SIMDProcessor->Mul( joints[ 0 ].ToFloatPtr(), 1.0f - lerp, lodFrames[ 0 ][ 0 ].ToFloatPtr(), numFloats );
+		SIMDProcessor->MulAdd( joints[ 0 ].ToFloatPtr(), lerp, lodFrames[ 1 ][ 0 ].ToFloatPtr(), numFloats );
+	}
+
+	return true;
+}
+
+/*
+=====================
+idAnimator::ResetLODFrames
+
+Called when the animations change, the frames computed ahead are no longer valid.
+=====================
+*/
+void idAnimator::ResetLODFrames( void ) {
+	lodFrameTimes[ 0 ] = -1;
+	lodFrameTimes[ 1 ] = -1;
+	lodUpdateTime = -1;
+}
+
+/*
+=====================
+idAnimator::SetViewed
+=====================
+*/
+void idAnimator::SetViewed( int currentTime ) {
+	lastViewedTime = currentTime;
+}
+
+/*
+=====================
+idAnimator::BuildFrame
+
+Blends the animations of all channels and writes the joint matrices to frameJoints.
+lodJoints skips the lodskip joints of the modelDef, they keep their pose from the last
+full detail frame so they don't snap back to the default pose.
+=====================
+*/
+bool idAnimator::BuildFrame( int currentTime, idJointMat *frameJoints, bool lodJoints, bool debugInfo ) {
+	int					i, j;
+	int					numJoints;
+	int					parentNum;
+	bool				hasAnim;
+	float				baseBlend;
+	float				blendWeight;
+	const idAnimBlend *	blend;
+	const int *			jointParent;
+	const jointMod_t *	jointMod;
+	const idJointQuat *	defaultPose;
+
 	// init the joint buffer
 	if ( AFPoseJoints.Num() ) {
 		// initialize with AF pose anim for the case where there are no other animations and no AF pose joint modifications
@@ -5248,15 +5520,32 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 
 	numJoints = modelDef->Joints().Num();
 	idJointQuat *jointFrame = ( idJointQuat * )_alloca16( numJoints * sizeof( jointFrame[0] ) );
+
+	if ( lodJoints && lodSkipPose.Num() != numJoints ) {
+		// no full detail frame to take the skipped joints from yet
+		lodJoints = false;
+	}
+
 	SIMDProcessor->Memcpy( jointFrame, defaultPose, numJoints * sizeof( jointFrame[0] ) );
 
+	if ( lodJoints ) {
+		// the channels don't blend into the skipped joints, start them at their last pose
+		const idList<int> &skipJoints = modelDef->GetLODSkipJoints();
+		for( i = 0; i < skipJoints.Num(); i++ ) {
+			const int jointNum = skipJoints[ i ];
+			if ( jointNum > 0 && jointNum < numJoints ) {
+				jointFrame[ jointNum ] = lodSkipPose[ jointNum ];
+			}
+		}
+	}
+
 	hasAnim = false;
 
 	// blend the all channel
 	baseBlend = 0.0f;
 	blend = channels[ ANIMCHANNEL_ALL ];
 	for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
-		if ( blend->BlendAnim( currentTime, ANIMCHANNEL_ALL, numJoints, jointFrame, baseBlend, removeOriginOffset, false, debugInfo ) ) {
+		if ( blend->BlendAnim( currentTime, ANIMCHANNEL_ALL, numJoints, jointFrame, baseBlend, removeOriginOffset, false, lodJoints, debugInfo ) ) {
 			hasAnim = true;
 			if ( baseBlend >= 1.0f ) {
 				break;
@@ -5277,7 +5566,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 			blendWeight = baseBlend;
 			blend = channels[ i ];
 			for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
-				if ( blend->BlendAnim( currentTime, i, numJoints, jointFrame, blendWeight, removeOriginOffset, false, debugInfo ) ) {
+				if ( blend->BlendAnim( currentTime, i, numJoints, jointFrame, blendWeight, removeOriginOffset, false, lodJoints, debugInfo ) ) {
 					hasAnim = true;
 					if ( blendWeight >= 1.0f ) {
 						// fully blended
@@ -5297,7 +5586,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		blend = channels[ ANIMCHANNEL_EYELIDS ];
 		blendWeight = baseBlend;
 		for( j = 0; j < ANIM_MaxAnimsPerChannel; j++, blend++ ) {
-			if ( blend->BlendAnim( currentTime, ANIMCHANNEL_EYELIDS, numJoints, jointFrame, blendWeight, removeOriginOffset, true, debugInfo ) ) {
+			if ( blend->BlendAnim( currentTime, ANIMCHANNEL_EYELIDS, numJoints, jointFrame, blendWeight, removeOriginOffset, true, lodJoints, debugInfo ) ) {
 				hasAnim = true;
 				if ( blendWeight >= 1.0f ) {
 					// fully blended
@@ -5317,8 +5606,13 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		return false;
 	}
 
+	if ( !lodJoints ) {
+		lodSkipPose.SetNum( numJoints, false );
+		SIMDProcessor->Memcpy( lodSkipPose.Ptr(), jointFrame, numJoints * sizeof( jointFrame[0] ) );
+	}
+
 	// convert the joint quaternions to rotation matrices
-	SIMDProcessor->ConvertJointQuatsToJointMats( joints, jointFrame, numJoints );
+	SIMDProcessor->ConvertJointQuatsToJointMats( frameJoints, jointFrame, numJoints );
 
 	// check if we need to modify the origin
 	if ( jointMods.Num() && ( jointMods[0]->jointnum == 0 ) ) {
@@ -5329,16 +5623,16 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[0].SetRotation( jointMod->mat * joints[0].ToMat3() );
+				frameJoints[0].SetRotation( jointMod->mat * frameJoints[0].ToMat3() );
 				break;
 			
 			case JOINTMOD_WORLD:
-				joints[0].SetRotation( joints[0].ToMat3() * jointMod->mat );
+				frameJoints[0].SetRotation( frameJoints[0].ToMat3() * jointMod->mat );
 				break;
 
 			case JOINTMOD_LOCAL_OVERRIDE:
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[0].SetRotation( jointMod->mat );
+				frameJoints[0].SetRotation( jointMod->mat );
 				break;
 		}
 
@@ -5347,13 +5641,13 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[0].SetTranslation( joints[0].ToVec3() + jointMod->pos );
+				frameJoints[0].SetTranslation( frameJoints[0].ToVec3() + jointMod->pos );
 				break;
 			
 			case JOINTMOD_LOCAL_OVERRIDE:
 			case JOINTMOD_WORLD:
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[0].SetTranslation( jointMod->pos );
+				frameJoints[0].SetTranslation( jointMod->pos );
 				break;
 		}
 		j = 1;
@@ -5362,7 +5656,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 	}
 
 	// add in the model offset
-	joints[0].SetTranslation( joints[0].ToVec3() + modelDef->GetVisualOffset() );
+	frameJoints[0].SetTranslation( frameJoints[0].ToVec3() + modelDef->GetVisualOffset() );
 
 	// pointer to joint info
 	jointParent = modelDef->JointParents();
@@ -5372,7 +5666,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		jointMod = jointMods[j];
 
 		// transform any joints preceding the joint modifier
-		SIMDProcessor->TransformJoints( joints, jointParent, i, jointMod->jointnum - 1 );
+		SIMDProcessor->TransformJoints( frameJoints, jointParent, i, jointMod->jointnum - 1 );
 		i = jointMod->jointnum;
 
 		parentNum = jointParent[i];
@@ -5380,52 +5674,52 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 		// modify the axis
 		switch( jointMod->transform_axis ) {
 			case JOINTMOD_NONE:
-				joints[i].SetRotation( joints[i].ToMat3() * joints[ parentNum ].ToMat3() );
+				frameJoints[i].SetRotation( frameJoints[i].ToMat3() * frameJoints[ parentNum ].ToMat3() );
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[i].SetRotation( jointMod->mat * ( joints[i].ToMat3() * joints[parentNum].ToMat3() ) );
+				frameJoints[i].SetRotation( jointMod->mat * ( frameJoints[i].ToMat3() * frameJoints[parentNum].ToMat3() ) );
 				break;
 			
 			case JOINTMOD_LOCAL_OVERRIDE:
-				joints[i].SetRotation( jointMod->mat * joints[parentNum].ToMat3() );
+				frameJoints[i].SetRotation( jointMod->mat * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_WORLD:
-				joints[i].SetRotation( ( joints[i].ToMat3() * joints[parentNum].ToMat3() ) * jointMod->mat );
+				frameJoints[i].SetRotation( ( frameJoints[i].ToMat3() * frameJoints[parentNum].ToMat3() ) * jointMod->mat );
 				break;
 
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[i].SetRotation( jointMod->mat );
+				frameJoints[i].SetRotation( jointMod->mat );
 				break;
 		}
 
 		// modify the position
 		switch( jointMod->transform_pos ) {
 			case JOINTMOD_NONE:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + joints[i].ToVec3() * joints[parentNum].ToMat3() );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + frameJoints[i].ToVec3() * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_LOCAL:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + ( joints[i].ToVec3() + jointMod->pos ) * joints[parentNum].ToMat3() );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + ( frameJoints[i].ToVec3() + jointMod->pos ) * frameJoints[parentNum].ToMat3() );
 				break;
 			
 			case JOINTMOD_LOCAL_OVERRIDE:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + jointMod->pos * joints[parentNum].ToMat3() );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + jointMod->pos * frameJoints[parentNum].ToMat3() );
 				break;
 
 			case JOINTMOD_WORLD:
-				joints[i].SetTranslation( joints[parentNum].ToVec3() + joints[i].ToVec3() * joints[parentNum].ToMat3() + jointMod->pos );
+				frameJoints[i].SetTranslation( frameJoints[parentNum].ToVec3() + frameJoints[i].ToVec3() * frameJoints[parentNum].ToMat3() + jointMod->pos );
 				break;
 
 			case JOINTMOD_WORLD_OVERRIDE:
-				joints[i].SetTranslation( jointMod->pos );
+				frameJoints[i].SetTranslation( jointMod->pos );
 				break;
 		}
 	}
 
 	// transform the rest of the hierarchy
-	SIMDProcessor->TransformJoints( joints, jointParent, i, numJoints - 1 );
+	SIMDProcessor->TransformJoints( frameJoints, jointParent, i, numJoints - 1 );
 
 	return true;
 }
@@ -134,31 +134,12 @@ bool tdmDeclTDM_MatInfo::Parse( const char *text, const int textLength )
 
 /// Used to cache the TDM_MatInfos for all the materials applied to surfaces of a map.
 void tdmDeclTDM_MatInfo::precacheMap( idMapFile *map ) {
-	int numEntities = map->GetNumEntities();
-	int e;
-	for ( e = 0 ; e < numEntities ; e++ ) {
-		idMapEntity *ent = map->GetEntity(e);
-		int numPrimitives = ent->GetNumPrimitives();
-		int p;
-		for ( p = 0 ; p < numPrimitives ; p++ ) {
-			idMapPrimitive *prim = ent->GetPrimitive(p);
-			if ( prim->GetType() == idMapPrimitive::TYPE_BRUSH ) {
-				idMapBrush *brush = dynamic_cast<idMapBrush*>(prim);
-				int numSides = brush->GetNumSides();
-				int s;
-				for ( s = 0 ; s < numSides ; s++ ) {
-					idMapBrushSide *side = brush->GetSide(s);
-					declManager->MediaPrint( "Precaching brush TDM_MatInfo %s\n", side->GetMaterial() );
-					declManager->FindType( DECL_TDM_MATINFO, side->GetMaterial() );
-				}
-			} else if ( prim->GetType() == idMapPrimitive::TYPE_PATCH ) {
-				idMapPatch *patch = dynamic_cast<idMapPatch*>(prim);
-				declManager->MediaPrint( "Precaching patch TDM_MatInfo %s\n", patch->GetMaterial() );
-				declManager->FindType( DECL_TDM_MATINFO, patch->GetMaterial() );
-			} else {
-				gameLocal.Warning( "tdmDeclTDM_MatInfo(): unknown primitive type: %d", prim->GetType() );
-			}
-		}
+	// the material list is also available when the map was loaded from the entity cache without primitives
+	idStrList materials;
+	map->GetMaterials( materials );
+	for ( int i = 0 ; i < materials.Num() ; i++ ) {
+		declManager->MediaPrint( "Precaching TDM_MatInfo %s\n", materials[i].c_str() );
+		declManager->FindType( DECL_TDM_MATINFO, materials[i] );
 	}
 }
 
@@ -360,6 +360,7 @@ void idSaveGame::WriteRenderEntity( const renderEntity_t &renderEntity ) {
 	WriteBool( renderEntity.noShadow );
 	WriteBool( renderEntity.noDynamicInteractions );
 	WriteBool( renderEntity.weaponDepthHack );
+	WriteBool( renderEntity.occluder );
 
 	WriteInt( renderEntity.forceUpdate );
 }
@@ -946,6 +947,7 @@ void idRestoreGame::ReadRenderEntity( renderEntity_t &renderEntity ) {
 	ReadBool( renderEntity.noShadow );
 	ReadBool( renderEntity.noDynamicInteractions );
 	ReadBool( renderEntity.weaponDepthHack );
+	ReadBool( renderEntity.occluder );
 
 	ReadInt( renderEntity.forceUpdate );
 }
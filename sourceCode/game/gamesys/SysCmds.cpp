@@ -1909,6 +1909,173 @@ static void Cmd_ListAnims_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_BenchAnim_f
+
+Animates copies of an entityDef's model without entities, two blending
+animations on each channel, and times the frame creation. Set
+com_forceGenericSIMD to compare against the generic joint code.
+==================
+*/
+static void Cmd_BenchAnim_f( const idCmdArgs &args ) {
+	int				numActors;
+	int				numChannels;
+	int				numFrames;
+	const idDict *	dict;
+	idTimer			timer;
+
+	if ( args.Argc() < 2 || args.Argc() > 5 ) {
+		gameLocal.Printf( "Usage: benchAnim <entityDef> [numActors] [numChannels] [numFrames]\n" );
+		return;
+	}
+	numActors = ( args.Argc() > 2 ) ? idMath::ClampInt( 1, 1024, atoi( args.Argv( 2 ) ) ) : 64;
+	numChannels = ( args.Argc() > 3 ) ? idMath::ClampInt( 1, ANIM_NumAnimChannels - 1, atoi( args.Argv( 3 ) ) ) : 3;
+	numFrames = ( args.Argc() > 4 ) ? idMath::ClampInt( 1, 10000, atoi( args.Argv( 4 ) ) ) : 100;
+
+	dict = gameLocal.FindEntityDefDict( args.Argv( 1 ), false );
+	if ( !dict ) {
+		gameLocal.Printf( "Entitydef '%s' not found\n", args.Argv( 1 ) );
+		return;
+	}
+
+	idList<idAnimator *> animators;
+	for ( int i = 0; i < numActors; i++ ) {
+		idAnimator *animator = new idAnimator;
+		animator->SetModel( dict->GetString( "model" ) );
+		animators.Append( animator );
+	}
+
+	const idDeclModelDef *modelDef = animators[0]->ModelDef();
+	const int numAnims = animators[0]->NumAnims();
+	if ( !modelDef || numAnims < 2 ) {
+		gameLocal.Printf( "Entitydef '%s' has no animated model\n", args.Argv( 1 ) );
+		animators.DeleteContents( true );
+		return;
+	}
+
+	// the all channel overrides the others, so it is only used on its own
+	idList<int> channels;
+	if ( numChannels > 1 ) {
+		for ( int i = ANIMCHANNEL_ALL + 1; i < ANIM_NumAnimChannels && channels.Num() < numChannels; i++ ) {
+			if ( modelDef->NumJointsOnChannel( i ) ) {
+				channels.Append( i );
+			}
+		}
+	}
+	if ( channels.Num() == 0 ) {
+		channels.Append( ANIMCHANNEL_ALL );
+	}
+
+	// every channel blends from one animation into the next for the whole run
+	const int blendTime = numFrames * USERCMD_MSEC;
+	for ( int i = 0; i < numActors; i++ ) {
+		for ( int j = 0; j < channels.Num(); j++ ) {
+			const int anim = i * channels.Num() + j;
+			animators[i]->CycleAnim( channels[j], 1 + anim % ( numAnims - 1 ), 0, 0 );
+			animators[i]->CycleAnim( channels[j], 1 + ( anim + 1 ) % ( numAnims - 1 ), 0, blendTime );
+		}
+	}
+
+	timer.Start();
+	for ( int frame = 0; frame < numFrames; frame++ ) {
+		for ( int i = 0; i < numActors; i++ ) {
+			animators[i]->CreateFrame( frame * USERCMD_MSEC, true );
+		}
+	}
+	timer.Stop();
+
+	const double msec = timer.Milliseconds() / numFrames;
+
+	gameLocal.Printf( "%s: %d actors, %d channels, %d joints, %d frames, %s\n", modelDef->GetName(), numActors, channels.Num(), animators[0]->NumJoints(), numFrames, SIMDProcessor->GetName() );
+	gameLocal.Printf( "%8.3f ms/frame, %8.2f usec/actor\n", msec, msec * 1000.0 / numActors );
+
+	animators.DeleteContents( true );
+}
+
+/*
+==================
+Cmd_BenchLexer_f
+
+Loads all files with an extension below a folder into memory and times
+lexing them, materials by default. The files are lexed with the flags of
+the decl manager, or of idMapFile for .map files. Set com_forceGenericSIMD
+to compare against the generic text scanning.
+==================
+*/
+static void Cmd_BenchLexer_f( const idCmdArgs &args ) {
+	int				numRuns;
+	int				flags;
+	int				numTokens;
+	int				numBytes;
+	double			bestMsec;
+	idToken			token;
+	idTimer			timer;
+
+	if ( args.Argc() > 4 ) {
+		gameLocal.Printf( "Usage: benchLexer [folder] [extension] [numRuns]\n" );
+		return;
+	}
+	const char *folder = ( args.Argc() > 1 ) ? args.Argv( 1 ) : "materials";
+	const char *extension = ( args.Argc() > 2 ) ? args.Argv( 2 ) : ".mtr";
+	numRuns = ( args.Argc() > 3 ) ? idMath::ClampInt( 1, 100, atoi( args.Argv( 3 ) ) ) : 5;
+
+	if ( idStr::Icmp( extension, ".map" ) == 0 ) {
+		flags = LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES;
+	} else {
+		flags = DECL_LEXER_FLAGS;
+	}
+	flags |= LEXFL_NOERRORS | LEXFL_NOWARNINGS;
+
+	// the files are read first, so only the lexer is timed
+	idFileList *files = fileSystem->ListFilesTree( folder, extension, true );
+	idList<char *> buffers;
+	idList<int> lengths;
+	numBytes = 0;
+	for ( int i = 0; i < files->GetNumFiles(); i++ ) {
+		void *buffer;
+		const int length = fileSystem->ReadFile( files->GetFile( i ), &buffer );
+		if ( length < 0 || !buffer ) {
+			continue;
+		}
+		buffers.Append( static_cast<char *>( buffer ) );
+		lengths.Append( length );
+		numBytes += length;
+	}
+	fileSystem->FreeFileList( files );
+
+	if ( buffers.Num() == 0 ) {
+		gameLocal.Printf( "No %s files found in %s\n", extension, folder );
+		return;
+	}
+
+	bestMsec = 0.0;
+	numTokens = 0;
+	for ( int run = 0; run < numRuns; run++ ) {
+		numTokens = 0;
+		timer.Clear();
+		timer.Start();
+		for ( int i = 0; i < buffers.Num(); i++ ) {
+			idLexer src( buffers[i], lengths[i], folder, flags );
+			while ( src.ReadToken( &token ) ) {
+				numTokens++;
+			}
+		}
+		timer.Stop();
+
+		if ( run == 0 || timer.Milliseconds() < bestMsec ) {
+			bestMsec = timer.Milliseconds();
+		}
+	}
+
+	for ( int i = 0; i < buffers.Num(); i++ ) {
+		fileSystem->FreeFile( buffers[i] );
+	}
+
+	gameLocal.Printf( "%s/*%s: %d files, %d kB, %d tokens, best of %d runs, %s\n", folder, extension, buffers.Num(), numBytes >> 10, numTokens, numRuns, SIMDProcessor->GetName() );
+	gameLocal.Printf( "%8.2f ms, %8.2f MB/s\n", bestMsec, ( bestMsec > 0.0 ) ? numBytes / ( bestMsec * 1000.0 ) : 0.0 );
+}
+
 // greebo: Reload the xdata declarations by forcing the declaration manager to perform a reload
 static void Cmd_ReloadXData_f( const idCmdArgs &args )
 {
@@ -3796,6 +3963,8 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
+	cmdSystem->AddCommand( "benchAnim",				Cmd_BenchAnim_f,			CMD_FL_GAME,				"times the animation of copies of an entityDef's model", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
+	cmdSystem->AddCommand( "benchLexer",			Cmd_BenchLexer_f,			CMD_FL_GAME,				"times the lexing of all files with an extension below a folder" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"projects a blood splat on the player weapon" );
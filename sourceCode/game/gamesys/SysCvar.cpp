@@ -103,6 +103,7 @@ idCVar cv_ai_opt_interleavethinkmaxdist (		"tdm_ai_opt_interleavethinkmaxdist",
 idCVar cv_ai_opt_interleavethinkskippvscheck (	"tdm_ai_opt_interleavethinkskipPVS",		"0",	CVAR_GAME | CVAR_ARCHIVE | CVAR_BOOL, "If true (nonzero), the player PVS check for interleaved thinking will be skipped, so that the AI can also do interleaved thinking while in view." );
 idCVar cv_ai_opt_interleavethinkframes (		"tdm_ai_opt_interleavethinkframes",			"0",	CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "If true (nonzero), this is the maximum interleaved thinking frame number." );
 idCVar cv_ai_opt_update_enemypos_interleave (	"tdm_ai_opt_update_enemypos_interleave",	"48",	CVAR_GAME | CVAR_ARCHIVE | CVAR_INTEGER, "Time to pass between enemy position updates. Set this to 0 for updates each frame." );
+idCVar cv_ai_opt_parallelperception (	"tdm_ai_opt_parallelperception",	"1",	CVAR_GAME | CVAR_BOOL, "If true (nonzero), the AI's perception of the player (PVS, acuity, FOV, visibility) is computed in parallel jobs before the entities think." );
 
 idCVar cv_ai_opt_nomind (						"tdm_ai_opt_nomind",				"0",			CVAR_GAME | CVAR_BOOL, "If true (nonzero), AI has its Mind thinking routines disabled." );
 idCVar cv_ai_opt_novisualstim (					"tdm_ai_opt_novisualstim",			"0",			CVAR_GAME | CVAR_BOOL, "If true (nonzero), AI will not process any incoming visual stimuli." );
@@ -431,6 +432,10 @@ idCVar cv_moveable_collision("tdm_show_moveable_collision",  "0", CVAR_GAME | CV
 * DarkMod LOD system
 **/
 idCVar cv_lod_bias("tdm_lod_bias",	"1.0",	CVAR_GAME | CVAR_FLOAT | CVAR_ARCHIVE, "A factor to multiply the LOD (level of detail) distance with. Default is 1.0 (meaning no change). Values < 1.0 make the distances smaller, reducing detail and increasing framerate, values > 1 increase the distance and thus detail at the expense of framerate." );
+idCVar cv_anim_lod("tdm_anim_lod",	"1",	CVAR_GAME | CVAR_BOOL | CVAR_ARCHIVE, "If set to 1, distant and unseen actors update their animations at a reduced rate and skip the 'lodskip' joints of their model. Viewed actors are interpolated between the updates." );
+idCVar cv_anim_lod_size("tdm_anim_lod_size",	"0.08",	CVAR_GAME | CVAR_FLOAT | CVAR_ARCHIVE, "Fraction of the screen size below which actors use the first animation LOD level, each further level starts at half the size of the previous one. Scaled by tdm_lod_bias.", 0.0f, 1.0f );
+idCVar cv_anim_cache("tdm_anim_cache",	"1",	CVAR_GAME | CVAR_BOOL, "If set to 1, md5anims are loaded from binary cache files in generated/, which are written when an anim is loaded from a changed or new source file." );
+idCVar cv_map_entity_cache("tdm_map_entity_cache",	"1",	CVAR_GAME | CVAR_BOOL, "If set to 1, the entities of a map are loaded from a binary cache file in generated/ instead of parsing the .map file. The cache is written when the .map file changed, brushes and patches are only parsed when the collision model has to be rebuilt." );
 
 /**
 * End DarkMod cvars
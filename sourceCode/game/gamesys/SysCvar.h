@@ -70,6 +70,7 @@ extern idCVar cv_ai_opt_interleavethinkmaxdist;
 extern idCVar cv_ai_opt_interleavethinkskippvscheck;
 extern idCVar cv_ai_opt_interleavethinkframes;
 extern idCVar cv_ai_opt_update_enemypos_interleave;
+extern idCVar cv_ai_opt_parallelperception;
 extern idCVar cv_ai_opt_nomind;
 extern idCVar cv_ai_opt_novisualstim;
 extern idCVar cv_ai_opt_nolipsync;
@@ -369,6 +370,14 @@ extern idCVar cv_moveable_collision;
 // Tels: LOD system: multiplier for the LOD distance to be used
 extern idCVar cv_lod_bias;
 
+// animation LOD: reduced update rate and joint subsets for distant actors
+extern idCVar cv_anim_lod;
+extern idCVar cv_anim_lod_size;
+
+// binary md5anim cache
+extern idCVar cv_anim_cache;
+extern idCVar cv_map_entity_cache;
+
 // grayman: for debugging 'evidence' barks and greetings
 extern idCVar cv_ai_debug_transition_barks;
 extern idCVar cv_ai_debug_greetings;
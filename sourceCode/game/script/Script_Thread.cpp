@@ -865,6 +865,8 @@ bool idThread::Execute( void ) {
 		return false;
 	}
 
+	PROFILE_ZONE( Script );
+
 	oldThread = currentThread;
 	currentThread = this;
 
@@ -43,7 +43,7 @@ idDict &idDict::operator=( const idDict &other ) {
 	Clear();
 
 	args = other.args;
-	argHash = other.argHash;
+	hashTable = other.hashTable;
 
 	for ( int i = 0; i < args.Num(); i++ ) {
 		args[i].key = globalKeys.CopyString( args[i].key );
@@ -62,7 +62,6 @@ idDict::Copy
 */
 void idDict::Copy( const idDict &other ) {
 	int i, *found;
-	idKeyValue kv;
 
 	// check for assignment to self
 	if ( this == &other ) {
@@ -84,12 +83,10 @@ void idDict::Copy( const idDict &other ) {
 		if ( found && found[i] != -1 ) {
 			// first set the new value and then free the old value to allow proper self copying
 			const idPoolStr *oldValue = args[found[i]].value;
-			args[found[i]].value = globalValues.CopyString( other.args[i].value );
+			args[found[i]].SetValue( globalValues.CopyString( other.args[i].value ) );
 			globalValues.FreeString( oldValue );
 		} else {
-			kv.key = globalKeys.CopyString( other.args[i].key );
-			kv.value = globalValues.CopyString( other.args[i].value );
-			argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
+			AppendKeyValue( globalKeys.CopyString( other.args[i].key ), globalValues.CopyString( other.args[i].value ) );
 		}
 	}
 }
@@ -114,16 +111,11 @@ void idDict::TransferKeyValues( idDict &other ) {
 
 	Clear();
 
-	const int n = other.args.Num();
-	args.SetNum( n );
-	for ( int i = 0; i < n; i++ ) {
-		args[i].key = other.args[i].key;
-		args[i].value = other.args[i].value;
-	}
-	argHash = other.argHash;
+	args = other.args;
+	hashTable = other.hashTable;
 
 	other.args.Clear();
-	other.argHash.Free();
+	other.hashTable.Clear();
 }
 
 /*
@@ -169,16 +161,13 @@ idDict::SetDefaults
 */
 void idDict::SetDefaults( const idDict *dict ) {
 	const idKeyValue *kv, *def;
-	idKeyValue newkv;
 
 	const int n = dict->args.Num();
 	for( int i = 0; i < n; i++ ) {
 		def = &dict->args[i];
 		kv = FindKey( def->GetKey() );
 		if ( !kv ) {
-			newkv.key = globalKeys.CopyString( def->key );
-			newkv.value = globalValues.CopyString( def->value );
-			argHash.Add( argHash.GenerateKey( newkv.GetKey(), false ), args.Append( newkv ) );
+			AppendKeyValue( globalKeys.CopyString( def->key ), globalValues.CopyString( def->value ) );
 		}
 	}
 }
@@ -192,7 +181,6 @@ Tels: Like SetDefaults(), but skips all entries starting with skip:
 */
 void idDict::SetDefaults( const idDict *dict, const idStr &skip ) {
 	const idKeyValue *kv, *def;
-	idKeyValue newkv;
 
 	const int l = skip.Length();
 	for( int i = 0; i < dict->args.Num() ; i++ ) {
@@ -204,9 +192,7 @@ void idDict::SetDefaults( const idDict *dict, const idStr &skip ) {
 
 		kv = FindKey( def->GetKey() );
 		if ( !kv ) {
-			newkv.key = globalKeys.CopyString( def->key );
-			newkv.value = globalValues.CopyString( def->value );
-			argHash.Add( argHash.GenerateKey( newkv.GetKey(), false ), args.Append( newkv ) );
+			AppendKeyValue( globalKeys.CopyString( def->key ), globalValues.CopyString( def->value ) );
 		}
 	}
 }
@@ -224,7 +210,7 @@ void idDict::Clear( void ) {
 	}
 
 	args.Clear();
-	argHash.Free();
+	hashTable.Clear();
 }
 
 /*
@@ -272,7 +258,7 @@ idDict::Allocated
 ================
 */
 size_t idDict::Allocated( void ) const {
-	size_t	size = args.Allocated() + argHash.Allocated();
+	size_t	size = args.Allocated() + hashTable.Allocated();
 
 	for ( int i = 0; i < args.Num(); i++ ) {
 		size += args[i].Size();
@@ -287,8 +273,6 @@ idDict::Set
 ================
 */
 void idDict::Set( const char *key, const char *value ) {
-	idKeyValue kv;
-
 	if ( key == NULL || key[0] == '\0' ) {
 		return;
 	}
@@ -297,12 +281,65 @@ void idDict::Set( const char *key, const char *value ) {
 	if ( i != -1 ) {
 		// first set the new value and then free the old value to allow proper self copying
 		const idPoolStr *oldValue = args[i].value;
-		args[i].value = globalValues.AllocString( value );
+		args[i].SetValue( globalValues.AllocString( value ) );
 		globalValues.FreeString( oldValue );
 	} else {
-		kv.key = globalKeys.AllocString( key );
-		kv.value = globalValues.AllocString( value );
-		argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
+		AppendKeyValue( globalKeys.AllocString( key ), globalValues.AllocString( value ) );
+	}
+}
+
+/*
+================
+idDict::AppendKeyValue
+
+  adds a new key/value pair, the key must not be in the dict yet
+================
+*/
+int idDict::AppendKeyValue( const idPoolStr *key, const idPoolStr *value ) {
+	idKeyValue kv;
+
+	kv.key = key;
+	kv.SetValue( value );
+	kv.hash = KeyHash( key->c_str() );
+
+	const int index = args.Append( kv );
+
+	// keep the table at most half full
+	if ( args.Num() * 2 > hashTable.Num() ) {
+		Rehash( Max( hashTable.Num() * 2, 16 ) );
+		return index;
+	}
+
+	const int mask = hashTable.Num() - 1;
+	int slot = kv.hash & mask;
+	while ( hashTable[slot] != -1 ) {
+		slot = ( slot + 1 ) & mask;
+	}
+	hashTable[slot] = index;
+
+	return index;
+}
+
+/*
+================
+idDict::Rehash
+
+  rebuilds the hash table with the given size, which has to be a power of two
+================
+*/
+void idDict::Rehash( int tableSize ) {
+	assert( idMath::IsPowerOfTwo( tableSize ) );
+
+	hashTable.SetNum( tableSize, false );
+	memset( hashTable.Ptr(), -1, tableSize * sizeof( hashTable[0] ) );
+
+	const int mask = tableSize - 1;
+	for ( int i = 0; i < args.Num(); i++ ) {
+		int slot = args[i].hash & mask;
+		while ( hashTable[slot] != -1 ) {
+			slot = ( slot + 1 ) & mask;
+		}
+		hashTable[slot] = i;
 	}
 }
 
@@ -312,12 +349,13 @@ idDict::GetFloat
 ================
 */
 bool idDict::GetFloat( const char *key, const char *defaultString, float &out ) const {
-	const char	*s;
-	bool		found;
-
-	found = GetString( key, defaultString, &s );
-	out = atof( s );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = kv->GetFloatValue();
+		return true;
+	}
+	out = atof( defaultString );
+	return false;
 }
 
 /*
@@ -326,12 +364,13 @@ idDict::GetInt
 ================
 */
 bool idDict::GetInt( const char *key, const char *defaultString, int &out ) const {
-	const char	*s;
-	bool		found;
-
-	found = GetString( key, defaultString, &s );
-	out = atoi( s );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = kv->GetIntValue();
+		return true;
+	}
+	out = atoi( defaultString );
+	return false;
 }
 
 /*
@@ -340,12 +379,13 @@ idDict::GetBool
 ================
 */
 bool idDict::GetBool( const char *key, const char *defaultString, bool &out ) const {
-	const char	*s;
-	bool		found;
-
-	found = GetString( key, defaultString, &s );
-	out = ( atoi( s ) != 0 );
-	return found;
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		out = ( kv->GetIntValue() != 0 );
+		return true;
+	}
+	out = ( atoi( defaultString ) != 0 );
+	return false;
 }
 
 /*
@@ -469,14 +509,8 @@ const idKeyValue *idDict::FindKey( const char *key ) const {
 		return NULL;
 	}
 
-	const int hash = argHash.GenerateKey( key, false );
-	for ( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) ) {
-		if ( args[i].GetKey().Icmp( key ) == 0 ) {
-			return &args[i];
-		}
-	}
-
-	return NULL;
+	const int i = FindKeyIndex( key, KeyHash( key ) );
+	return ( i != -1 ) ? &args[i] : NULL;
 }
 
 /*
@@ -491,14 +525,7 @@ int idDict::FindKeyIndex( const char *key ) const {
 		return 0;
 	}
 
-	const int hash = argHash.GenerateKey( key, false );
-	for ( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) ) {
-		if ( args[i].GetKey().Icmp( key ) == 0 ) {
-			return i;
-		}
-	}
-
-	return -1;
+	return FindKeyIndex( key, KeyHash( key ) );
 }
 
 /*
@@ -507,16 +534,13 @@ idDict::Delete
 ================
 */
 void idDict::Delete( const char *key ) {
-	const int hash = argHash.GenerateKey( key, false );
-
-	for ( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) ) {
-		if ( args[i].GetKey().Icmp( key ) == 0 ) {
-			globalKeys.FreeString( args[i].key );
-			globalValues.FreeString( args[i].value );
-			args.RemoveIndex( i );
-			argHash.RemoveIndex( hash, i );
-			break;
-		}
+	const int i = FindKeyIndex( key, KeyHash( key ) );
+	if ( i != -1 ) {
+		globalKeys.FreeString( args[i].key );
+		globalValues.FreeString( args[i].value );
+		args.RemoveIndex( i );
+		// the indexes of the following pairs changed
+		Rehash( hashTable.Num() );
 	}
 
 #if 0
@@ -728,3 +752,141 @@ void idDict::ListValues_f( const idCmdArgs &args ) {
 
 	idLib::common->Printf( "%5d values\n", valueStrings.Num() );
 }
+
+/*
+================
+TestDict_Compare
+
+  returns false if dict doesn't hold exactly the given key/value pairs
+================
+*/
+static bool TestDict_Compare( const idDict &dict, const idStrList &keys, const idStrList &values ) {
+	if ( dict.GetNumKeyVals() != keys.Num() ) {
+		return false;
+	}
+	for ( int i = 0; i < keys.Num(); i++ ) {
+		// look the keys up in a different case to check the case insensitive hash
+		idStr upper = keys[i];
+		upper.ToUpper();
+		const idDictKey dictKey( upper.c_str() );
+
+		const idKeyValue *kv = dict.FindKey( upper.c_str() );
+		if ( kv == NULL || kv != dict.FindKey( dictKey ) || kv->GetValue().Cmp( values[i] ) != 0 ) {
+			return false;
+		}
+		if ( kv->GetFloatValue() != (float)atof( values[i] ) || kv->GetIntValue() != atoi( values[i] ) ) {
+			return false;
+		}
+		if ( dict.GetInt( dictKey, "-1" ) != atoi( values[i] ) || dict.GetBool( keys[i] ) != ( atoi( values[i] ) != 0 ) ) {
+			return false;
+		}
+	}
+	for ( int i = 0; i < dict.GetNumKeyVals(); i++ ) {
+		if ( dict.FindKeyIndex( dict.GetKeyVal( i )->GetKey() ) != i ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idDict::Test_f
+
+  applies random operations to a dictionary and a plain key/value list and compares the two
+================
+*/
+void idDict::Test_f( const idCmdArgs &args ) {
+	const int numOperations = 100000;
+	idRandom2 random( 0 );
+	idDict dict, other;
+	idStrList keys, values;
+	idStr key, value;
+	int i, j;
+
+	int numErrors = 0;
+	int numLookups = 0;
+	for ( i = 0; i < numOperations; i++ ) {
+		sprintf( key, "key%d", random.RandomInt( 200 ) );
+		for ( j = 0; j < keys.Num(); j++ ) {
+			if ( keys[j].Icmp( key ) == 0 ) {
+				break;
+			}
+		}
+
+		switch( random.RandomInt( 8 ) ) {
+			case 0:
+			case 1:
+			case 2: {
+				switch( random.RandomInt( 3 ) ) {
+					case 0: sprintf( value, "%d", random.RandomInt( 2000 ) - 1000 ); break;
+					case 1: sprintf( value, "%1.3f", random.CRandomFloat() * 1000.0f ); break;
+					default: sprintf( value, "value%d", random.RandomInt( 100 ) ); break;
+				}
+				dict.Set( key, value );
+				if ( j < keys.Num() ) {
+					values[j] = value;
+				} else {
+					keys.Append( key );
+					values.Append( value );
+				}
+				break;
+			}
+			case 3:
+			case 4: {
+				dict.Delete( key );
+				if ( j < keys.Num() ) {
+					keys.RemoveIndex( j );
+					values.RemoveIndex( j );
+				}
+				break;
+			}
+			case 5: {
+				// Copy onto a dict with overlapping keys, then move the pairs back
+				other.Clear();
+				other.Set( key, "other" );
+				other.Set( "otherKey", "1" );
+				other.Copy( dict );
+				if ( j < keys.Num() ) {
+					other.Delete( "otherKey" );
+				} else {
+					other.Delete( key );
+					other.Delete( "otherKey" );
+				}
+				dict.TransferKeyValues( other );
+				if ( other.GetNumKeyVals() != 0 ) {
+					numErrors++;
+				}
+				break;
+			}
+			case 6: {
+				if ( random.RandomInt( 100 ) == 0 ) {
+					dict.Clear();
+					keys.Clear();
+					values.Clear();
+				} else {
+					other = dict;
+					if ( !TestDict_Compare( other, keys, values ) ) {
+						numErrors++;
+					}
+				}
+				break;
+			}
+			default: {
+				const idKeyValue *kv = dict.FindKey( key );
+				if ( ( kv != NULL ) != ( j < keys.Num() ) || ( kv != NULL && kv->GetValue().Cmp( values[j] ) != 0 ) ) {
+					numErrors++;
+				}
+				numLookups++;
+				break;
+			}
+		}
+
+		if ( !TestDict_Compare( dict, keys, values ) ) {
+			numErrors++;
+		}
+	}
+
+	const char *result = numErrors == 0 ? "ok" : S_COLOR_RED"X";
+	idLib::common->Printf( "idDict: %d operations, %d lookups, %d errors %s\n", numOperations, numLookups, numErrors, result );
+}
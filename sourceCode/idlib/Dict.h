@@ -33,6 +33,13 @@ and other things.
 
 Keys are compared case-insensitive.
 
+The keys are found through a flat open-addressing table with linear probing,
+each key/value pair stores the hash of its key so most probes don't compare
+strings. Keys which are looked up often can be declared as idDictKey, which
+computes the hash once. The float and int values are parsed from the value
+string whenever the value is set and stored with the key/value pair, so reading
+a dictionary never writes to it.
+
 Does not allocate memory until the first key/value pair is added.
 
 ===============================================================================
@@ -45,16 +52,33 @@ public:
 	const idStr &		GetKey( void ) const { return *key; }
 	const idStr &		GetValue( void ) const { return *value; }
 
+						// the value parsed with atof and atoi
+	float				GetFloatValue( void ) const { return floatValue; }
+	int					GetIntValue( void ) const { return intValue; }
+
 	size_t				Allocated( void ) const { return key->Allocated() + value->Allocated(); }
 	size_t				Size( void ) const { return sizeof( *this ) + key->Size() + value->Size(); }
 
 	bool				operator==( const idKeyValue &kv ) const { return ( key == kv.key && value == kv.value ); }
 
 private:
+	void				SetValue( const idPoolStr *newValue );
+
 	const idPoolStr *	key;
 	const idPoolStr *	value;
+	int					hash;			// idDict::KeyHash of the key
+	float				floatValue;		// parsed in SetValue
+	int					intValue;
 };
 
+ID_INLINE void idKeyValue::SetValue( const idPoolStr *newValue ) {
+	value = newValue;
+	floatValue = atof( newValue->c_str() );
+	intValue = atoi( newValue->c_str() );
+}
+
+class idDictKey;
+
 class idDict {
 public:
 						idDict( void );
@@ -100,6 +124,11 @@ public:
 	float				GetFloat( const char *key, const char *defaultString = "0" ) const;
 	int					GetInt( const char *key, const char *defaultString = "0" ) const;
 	bool				GetBool( const char *key, const char *defaultString = "0" ) const;
+						// same with a precomputed key hash
+	const char *		GetString( const idDictKey &key, const char *defaultString = "" ) const;
+	float				GetFloat( const idDictKey &key, const char *defaultString = "0" ) const;
+	int					GetInt( const idDictKey &key, const char *defaultString = "0" ) const;
+	bool				GetBool( const idDictKey &key, const char *defaultString = "0" ) const;
 	idVec3				GetVector( const char *key, const char *defaultString = NULL ) const;
 	idVec2				GetVec2( const char *key, const char *defaultString = NULL ) const;
 	idVec4				GetVec4( const char *key, const char *defaultString = NULL ) const;
@@ -122,6 +151,7 @@ public:
 						// returns the key/value pair with the given key
 						// returns NULL if the key/value pair does not exist
 	const idKeyValue *	FindKey( const char *key ) const;
+	const idKeyValue *	FindKey( const idDictKey &key ) const;
 						// returns the index to the key/value pair with the given key
 						// returns -1 if the key/value pair does not exist
 	int					FindKeyIndex( const char *key ) const;
@@ -139,6 +169,9 @@ public:
 						// returns a unique checksum for this dictionary's content
 	int					Checksum( void ) const;
 
+						// case insensitive hash of a key
+	static int			KeyHash( const char *key );
+
 	static void			Init( void );
 	static void			Shutdown( void );
 
@@ -146,20 +179,50 @@ public:
 	void				PrintMemory( void ) const;
 	static void			ListKeys_f( const idCmdArgs &args );
 	static void			ListValues_f( const idCmdArgs &args );
+						// checks Set, Delete, Copy, TransferKeyValues and the lookups against a plain key list
+	static void			Test_f( const idCmdArgs &args );
 
 private:
 	idList<idKeyValue>	args;
-	idHashIndex			argHash;
+	idList<int>			hashTable;		// indexes into args, -1 for empty slots, the size is a power of two
 
 	static idStrPool	globalKeys;
 	static idStrPool	globalValues;
+
+	int					FindKeyIndex( const char *key, int hash ) const;
+	int					AppendKeyValue( const idPoolStr *key, const idPoolStr *value );
+	void				Rehash( int tableSize );
+};
+
+/*
+===============================================================================
+
+	Dictionary key with a precomputed hash, for keys which are looked up often.
+	The string has to stay valid as long as the key is used, string literals
+	are fine:
+
+	static const idDictKey KEY_HEALTH( "health" );
+	int health = spawnArgs.GetInt( KEY_HEALTH, "100" );
+
+===============================================================================
+*/
+
+class idDictKey {
+public:
+	explicit			idDictKey( const char *key ) : key( key ), hash( idDict::KeyHash( key ) ) {}
+
+	const char *		c_str( void ) const { return key; }
+	int					GetHash( void ) const { return hash; }
+
+private:
+	const char *		key;
+	int					hash;
 };
 
 
 ID_INLINE idDict::idDict( void ) {
 	args.SetGranularity( 16 );
-	argHash.SetGranularity( 16 );
-	argHash.Clear( 128, 16 );
+	hashTable.SetGranularity( 16 );
 }
 
 ID_INLINE idDict::idDict( const idDict &other ) {
@@ -172,15 +235,45 @@ ID_INLINE idDict::~idDict( void ) {
 
 ID_INLINE void idDict::SetGranularity( int granularity ) {
 	args.SetGranularity( granularity );
-	argHash.SetGranularity( granularity );
 }
 
 ID_INLINE void idDict::SetHashSize( int hashSize ) {
 	if ( args.Num() == 0 ) {
-		argHash.Clear( hashSize, 16 );
+		Rehash( idMath::CeilPowerOfTwo( Max( hashSize, 16 ) ) );
 	}
 }
 
+ID_INLINE int idDict::KeyHash( const char *key ) {
+	// FNV-1a over the lower case characters, the low bits are used for the table slots
+	unsigned int hash = 2166136261u;
+	for ( ; *key != '\0'; key++ ) {
+		hash ^= static_cast<unsigned char>( idStr::ToLower( *key ) );
+		hash *= 16777619u;
+	}
+	return static_cast<int>( hash );
+}
+
+ID_INLINE int idDict::FindKeyIndex( const char *key, int hash ) const {
+	if ( hashTable.Num() == 0 ) {
+		return -1;
+	}
+	const int mask = hashTable.Num() - 1;
+	for ( int slot = hash & mask; ; slot = ( slot + 1 ) & mask ) {
+		const int index = hashTable[slot];
+		if ( index == -1 ) {
+			return -1;
+		}
+		if ( args[index].hash == hash && args[index].GetKey().Icmp( key ) == 0 ) {
+			return index;
+		}
+	}
+}
+
+ID_INLINE const idKeyValue *idDict::FindKey( const idDictKey &key ) const {
+	const int index = FindKeyIndex( key.c_str(), key.GetHash() );
+	return ( index != -1 ) ? &args[index] : NULL;
+}
+
 ID_INLINE void idDict::SetFloat( const char *key, float val ) {
 	Set( key, va( "%f", val ) );
 }
@@ -242,15 +335,59 @@ ID_INLINE const char *idDict::GetString( const char *key, const char *defaultStr
 }
 
 ID_INLINE float idDict::GetFloat( const char *key, const char *defaultString ) const {
-	return atof( GetString( key, defaultString ) );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetFloatValue();
+	}
+	return atof( defaultString );
 }
 
 ID_INLINE int idDict::GetInt( const char *key, const char *defaultString ) const {
-	return atoi( GetString( key, defaultString ) );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetIntValue();
+	}
+	return atoi( defaultString );
 }
 
 ID_INLINE bool idDict::GetBool( const char *key, const char *defaultString ) const {
-	return ( atoi( GetString( key, defaultString ) ) != 0 );
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return ( kv->GetIntValue() != 0 );
+	}
+	return ( atoi( defaultString ) != 0 );
+}
+
+ID_INLINE const char *idDict::GetString( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetValue();
+	}
+	return defaultString;
+}
+
+ID_INLINE float idDict::GetFloat( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetFloatValue();
+	}
+	return atof( defaultString );
+}
+
+ID_INLINE int idDict::GetInt( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return kv->GetIntValue();
+	}
+	return atoi( defaultString );
+}
+
+ID_INLINE bool idDict::GetBool( const idDictKey &key, const char *defaultString ) const {
+	const idKeyValue *kv = FindKey( key );
+	if ( kv ) {
+		return ( kv->GetIntValue() != 0 );
+	}
+	return ( atoi( defaultString ) != 0 );
 }
 
 ID_INLINE idVec3 idDict::GetVector( const char *key, const char *defaultString ) const {
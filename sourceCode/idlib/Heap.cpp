@@ -1070,6 +1070,7 @@ void *Mem_Alloc( const int size ) {
 #endif
 		return malloc( size );
 	}
+	idScopedAllocatorLock lock;
 	void *mem = mem_heap->Allocate( size );
 	Mem_UpdateAllocStats( mem_heap->Msize( mem ) );
 	return mem;
@@ -1091,6 +1092,7 @@ void Mem_Free( void *ptr ) {
 		free( ptr );
 		return;
 	}
+	idScopedAllocatorLock lock;
 	Mem_UpdateFreeStats( mem_heap->Msize( ptr ) );
  	mem_heap->Free( ptr );
 }
@@ -1572,6 +1574,8 @@ void *Mem_AllocDebugMemory( const int size, const char *fileName, const int line
 		return malloc( size );
 	}
 
+	idScopedAllocatorLock lock;
+
 	if ( align16 ) {
 		p = mem_heap->Allocate16( size + sizeof( debugMemory_t ) );
 	}
@@ -1618,6 +1622,8 @@ void Mem_FreeDebugMemory( void *p, const char *fileName, const int lineNumber, c
 		return;
 	}
 
+	idScopedAllocatorLock lock;
+
 	m = (debugMemory_t *) ( ( (byte *) p ) - sizeof( debugMemory_t ) );
 
 	if ( m->size < 0 ) {
@@ -237,6 +237,8 @@ void idLexer::Warning( const char *str, ... ) {
 	char text[MAX_STRING_CHARS];
 	va_list ap;
 
+	hadWarning = true;
+
 	if ( idLexer::flags & LEXFL_NOWARNINGS ) {
 		return;
 	}
@@ -279,7 +281,7 @@ When a newline character is found the scripts line counter is increased.
 */
 int idLexer::ReadWhiteSpace( void ) {
 	while(1) {
-		// skip white space
+		// skip white space, runs of more than one character are skipped with SIMD
 		while(*idLexer::script_p <= ' ') {
 			if (!*idLexer::script_p) {
 				return 0;
@@ -288,19 +290,18 @@ int idLexer::ReadWhiteSpace( void ) {
 				idLexer::line++;
 			}
 			idLexer::script_p++;
+			if (*idLexer::script_p <= ' ') {
+				idLexer::script_p = SIMDProcessor->SkipWhiteSpace( idLexer::script_p, idLexer::line );
+			}
 		}
 		// skip comments
 		if (*idLexer::script_p == '/') {
 			// comments //
 			if (*(idLexer::script_p+1) == '/') {
-				idLexer::script_p++;
-				do {
-					idLexer::script_p++;
-					if ( !*idLexer::script_p ) {
-						return 0;
-					}
+				idLexer::script_p = SIMDProcessor->FindFirstOf( idLexer::script_p + 2, "\n" );
+				if ( !*idLexer::script_p ) {
+					return 0;
 				}
-				while( *idLexer::script_p != '\n' );
 				idLexer::line++;
 				idLexer::script_p++;
 				if ( !*idLexer::script_p ) {
@@ -312,7 +313,7 @@ int idLexer::ReadWhiteSpace( void ) {
 			else if (*(idLexer::script_p+1) == '*') {
 				idLexer::script_p++;
 				while( 1 ) {
-					idLexer::script_p++;
+					idLexer::script_p = SIMDProcessor->FindFirstOf( idLexer::script_p + 1, "\n/" );
 					if ( !*idLexer::script_p ) {
 						return 0;
 					}
@@ -427,7 +428,15 @@ Reads two strings with only a white space between them as one string.
 int idLexer::ReadString( idToken *token, int quote ) {
 	int tmpline;
 	const char *tmpscript_p;
+	const char *run_p;
 	char ch;
+	char stopChars[4];
+
+	// the characters that end a run of plain string characters
+	stopChars[0] = quote;
+	stopChars[1] = '\n';
+	stopChars[2] = ( idLexer::flags & LEXFL_NOSTRINGESCAPECHARS ) ? '\0' : '\\';
+	stopChars[3] = '\0';
 
 	if ( quote == '\"' ) {
 		token->type = TT_STRING;
@@ -489,6 +498,13 @@ int idLexer::ReadString( idToken *token, int quote ) {
 			idLexer::script_p++;
 		}
 		else {
+			// append everything up to the next quote, escape character, newline or the end at once
+			run_p = SIMDProcessor->FindFirstOf( idLexer::script_p, stopChars );
+			if ( run_p != idLexer::script_p ) {
+				token->AppendDirty( idLexer::script_p, run_p - idLexer::script_p );
+				idLexer::script_p = run_p;
+				continue;
+			}
 			if (*idLexer::script_p == '\0') {
 				idLexer::Error( "missing trailing quote" );
 				return 0;
@@ -523,20 +539,22 @@ idLexer::ReadName
 ================
 */
 int idLexer::ReadName( idToken *token ) {
-	char c;
+	const char *extraChars;
+	const char *start_p;
+
+	// if treating all tokens as strings, don't parse '-' as a seperate token
+	// if special path name characters are allowed
+	if ( idLexer::flags & LEXFL_ONLYSTRINGS ) {
+		extraChars = ( idLexer::flags & LEXFL_ALLOWPATHNAMES ) ? "-/\\:." : "-";
+	} else {
+		extraChars = ( idLexer::flags & LEXFL_ALLOWPATHNAMES ) ? "/\\:." : "";
+	}
 
 	token->type = TT_NAME;
-	do {
-		token->AppendDirty( *idLexer::script_p++ );
-		c = *idLexer::script_p;
-	} while ((c >= 'a' && c <= 'z') ||
-				(c >= 'A' && c <= 'Z') ||
-				(c >= '0' && c <= '9') ||
-				c == '_' ||
-				// if treating all tokens as strings, don't parse '-' as a seperate token
-				((idLexer::flags & LEXFL_ONLYSTRINGS) && (c == '-')) ||
-				// if special path name characters are allowed
-				((idLexer::flags & LEXFL_ALLOWPATHNAMES) && (c == '/' || c == '\\' || c == ':' || c == '.')) );
+	// the first character is always part of the name
+	start_p = idLexer::script_p;
+	idLexer::script_p = SIMDProcessor->SkipNameChars( idLexer::script_p + 1, extraChars );
+	token->AppendDirty( start_p, idLexer::script_p - start_p );
 	token->data[token->len] = '\0';
 	//the sub type is the length of the name
 	token->subtype = token->Length();
@@ -1749,6 +1767,7 @@ idLexer::idLexer( void ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -1770,6 +1789,7 @@ idLexer::idLexer( int flags ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -1785,6 +1805,7 @@ idLexer::idLexer( const char *filename, int flags, bool OSPath ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadFile( filename, OSPath );
 }
 
@@ -1801,6 +1822,7 @@ idLexer::idLexer( const char *ptr, int length, const char *name, int flags ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadMemory( ptr, length, name );
 }
 
@@ -1831,4 +1853,13 @@ bool idLexer::HadError( void ) const {
 	return hadError;
 }
 
+/*
+================
+idLexer::HadWarning
+================
+*/
+bool idLexer::HadWarning( void ) const {
+	return hadWarning;
+}
+
 #pragma warning( pop )
@@ -28,6 +28,9 @@
 	Does not use memory allocation during parsing. The lexer uses no
 	memory allocation if a source is loaded with LoadMemory().
 	However, idToken may still allocate memory for large strings.
+
+	White space, comments, names and strings are scanned with the
+	SIMD processor and copied into the token at once.
 	
 	A number directly following the escape character '\' in a string is
 	assumed to be in decimal format instead of octal. Binary numbers of
@@ -305,6 +308,9 @@ public:
 					// returns true if Error() was called with LEXFL_NOFATALERRORS or LEXFL_NOERRORS set
 	bool			HadError( void ) const;
 
+					// returns true if Warning() was called, even if LEXFL_NOWARNINGS is set
+	bool			HadWarning( void ) const;
+
 					// set the base folder to load files from
 	static void		SetBaseFolder( const char *path );
 
@@ -330,6 +336,7 @@ private:
 	idToken			token;					// available token
 	idLexer *		next;					// next script in a chain
 	bool			hadError;				// set by idLexer::Error, even if the error is supressed
+	bool			hadWarning;				// set by idLexer::Warning, even if the warning is supressed
 
 	static char		baseFolder[ 256 ];		// base folder to load files from
 
@@ -40,6 +40,7 @@ idSys *			idLib::sys			= NULL;
 idCommon *		idLib::common		= NULL;
 idCVarSystem *	idLib::cvarSystem	= NULL;
 idFileSystem *	idLib::fileSystem	= NULL;
+idProfiler *	idLib::profiler		= NULL;
 int				idLib::frameNumber	= 0;
 
 /*
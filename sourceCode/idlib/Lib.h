@@ -44,6 +44,7 @@ public:
 	static class idCommon *		common;
 	static class idCVarSystem *	cvarSystem;
 	static class idFileSystem *	fileSystem;
+	static class idProfiler *	profiler;
 	static int					frameNumber;
 
 	static void					Init( void );
@@ -227,6 +228,8 @@ public:
 #include "BitMsg.h"
 #include "MapFile.h"
 #include "Timer.h"
+#include "ParallelJobList.h"
+#include "Profiler.h"
 #include "Image.h"
 #include "RevisionTracker.h"
 
@@ -703,6 +703,11 @@ unsigned int idMapEntity::GetGeometryCRC( void ) const {
 	return crc;
 }
 
+#define MAP_ENTITY_CACHE_DIR		"generated/"
+#define MAP_ENTITY_CACHE_EXT		"bentities"
+#define MAP_ENTITY_CACHE_IDENT		( ( 'E' << 24 ) + ( 'P' << 16 ) + ( 'A' << 8 ) + 'M' )
+#define MAP_ENTITY_CACHE_VERSION	1
+
 /*
 ===============
 idMapFile::Parse
@@ -711,15 +716,13 @@ idMapFile::Parse
 bool idMapFile::Parse( const char *filename, bool ignoreRegion, bool osPath ) {
 	// no string concatenation for epairs and allow path names for materials
 	idLexer src( LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES );
-	idToken token;
 	idStr fullName;
-	idMapEntity *mapEnt;
-	int i, j, k;
 
 	name = filename;
 	name.StripFileExtension();
 	fullName = name;
 	hasPrimitiveData = false;
+	materials.Clear();
 
 	if ( !ignoreRegion ) {
 		// try loading a .reg file first
@@ -737,8 +740,89 @@ bool idMapFile::Parse( const char *filename, bool ignoreRegion, bool osPath ) {
 		}
 	}
 
-	version = OLD_MAP_VERSION;
 	fileTime = src.GetFileTime();
+
+	return ParseSource( src );
+}
+
+/*
+===============
+idMapFile::ParseEntities
+===============
+*/
+bool idMapFile::ParseEntities( const char *filename, bool ignoreRegion ) {
+	idStr fullName;
+	idStr cacheName;
+	void *buffer = NULL;
+	ID_TIME_T time = 0;
+	int length = -1;
+
+	name = filename;
+	name.StripFileExtension();
+	fullName = name;
+	hasPrimitiveData = false;
+	materials.Clear();
+
+	if ( !ignoreRegion ) {
+		// try loading a .reg file first
+		fullName.SetFileExtension( "reg" );
+		length = idLib::fileSystem->ReadFile( fullName, &buffer, &time );
+	}
+
+	if ( length < 0 || !buffer ) {
+		// now try a .map file
+		fullName.SetFileExtension( "map" );
+		length = idLib::fileSystem->ReadFile( fullName, &buffer, &time );
+		if ( length < 0 || !buffer ) {
+			// didn't get anything at all
+			return false;
+		}
+	}
+
+	// the cache is only valid for the exact contents of the source file
+	const unsigned int checksum = CRC32_BlockChecksum( buffer, length );
+
+	cacheName = MAP_ENTITY_CACHE_DIR;
+	cacheName += fullName;
+	cacheName.SetFileExtension( MAP_ENTITY_CACHE_EXT );
+
+	fileTime = time;
+
+	if ( LoadEntityCache( cacheName, checksum ) ) {
+		idLib::fileSystem->FreeFile( buffer );
+		return true;
+	}
+
+	// no string concatenation for epairs and allow path names for materials
+	idLexer src( LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES );
+	src.LoadMemory( static_cast<const char *>( buffer ), length, fullName );
+
+	const bool parsed = ParseSource( src );
+
+	src.FreeSource();
+	idLib::fileSystem->FreeFile( buffer );
+
+	if ( !parsed ) {
+		return false;
+	}
+
+	RemovePrimitiveData();
+	WriteEntityCache( cacheName, checksum );
+
+	return true;
+}
+
+/*
+===============
+idMapFile::ParseSource
+===============
+*/
+bool idMapFile::ParseSource( idLexer &src ) {
+	idToken token;
+	idMapEntity *mapEnt;
+	int i, j, k;
+
+	version = OLD_MAP_VERSION;
 	entities.DeleteContents( true );
 
 	if ( src.CheckTokenString( "Version" ) ) {
@@ -868,6 +952,168 @@ void idMapFile::SetGeometryCRC( void ) {
 	}
 }
 
+/*
+===============
+idMapFile::GetMaterials
+===============
+*/
+void idMapFile::GetMaterials( idStrList &list ) const {
+	int i, j, k;
+	idHashIndex hash;
+
+	if ( !hasPrimitiveData ) {
+		if ( &list != &materials ) {
+			list = materials;
+		}
+		return;
+	}
+
+	list.Clear();
+	for ( i = 0; i < entities.Num(); i++ ) {
+		const idMapEntity *mapEnt = entities[i];
+		for ( j = 0; j < mapEnt->GetNumPrimitives(); j++ ) {
+			const idMapPrimitive *mapPrimitive = mapEnt->GetPrimitive( j );
+			const char *material;
+			int numMaterials;
+
+			if ( mapPrimitive->GetType() == idMapPrimitive::TYPE_BRUSH ) {
+				numMaterials = static_cast<const idMapBrush *>(mapPrimitive)->GetNumSides();
+			} else {
+				numMaterials = 1;
+			}
+
+			for ( k = 0; k < numMaterials; k++ ) {
+				if ( mapPrimitive->GetType() == idMapPrimitive::TYPE_BRUSH ) {
+					material = static_cast<const idMapBrush *>(mapPrimitive)->GetSide( k )->GetMaterial();
+				} else {
+					material = static_cast<const idMapPatch *>(mapPrimitive)->GetMaterial();
+				}
+
+				const int key = hash.GenerateKey( material, false );
+				int index;
+				for ( index = hash.First( key ); index != -1; index = hash.Next( index ) ) {
+					if ( list[index].Icmp( material ) == 0 ) {
+						break;
+					}
+				}
+				if ( index == -1 ) {
+					hash.Add( key, list.Append( material ) );
+				}
+			}
+		}
+	}
+}
+
+/*
+===============
+idMapFile::LoadEntityCache
+===============
+*/
+bool idMapFile::LoadEntityCache( const char *fileName, unsigned int sourceCRC ) {
+	int i, j;
+	int ident;
+	int cacheVersion;
+	int numEntities;
+	int numKeyValues;
+	int numMaterials;
+	unsigned int checksum;
+	idStr key, value;
+
+	idFile *file = idLib::fileSystem->OpenFileRead( fileName );
+	if ( !file ) {
+		return false;
+	}
+
+	file->ReadInt( ident );
+	file->ReadInt( cacheVersion );
+	file->ReadUnsignedInt( checksum );
+	if ( ident != MAP_ENTITY_CACHE_IDENT || cacheVersion != MAP_ENTITY_CACHE_VERSION || checksum != sourceCRC ) {
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+
+	file->ReadFloat( version );
+	file->ReadUnsignedInt( geometryCRC );
+	file->ReadInt( numEntities );
+	file->ReadInt( numMaterials );
+
+	if ( numEntities < 0 || numMaterials < 0 || file->Tell() > file->Length() ) {
+		idLib::common->Warning( "Invalid map entity cache '%s'", fileName );
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+
+	entities.DeleteContents( true );
+	for ( i = 0; i < numEntities && file->Tell() < file->Length(); i++ ) {
+		idMapEntity *mapEnt = new idMapEntity();
+		entities.Append( mapEnt );
+
+		file->ReadInt( numKeyValues );
+		for ( j = 0; j < numKeyValues && file->Tell() < file->Length(); j++ ) {
+			file->ReadString( key );
+			file->ReadString( value );
+			mapEnt->epairs.Set( key, value );
+		}
+	}
+
+	materials.SetNum( numMaterials );
+	for ( i = 0; i < numMaterials; i++ ) {
+		file->ReadString( materials[i] );
+	}
+
+	const bool complete = ( entities.Num() == numEntities && file->Tell() == file->Length() );
+
+	idLib::fileSystem->CloseFile( file );
+
+	if ( !complete ) {
+		idLib::common->Warning( "Truncated map entity cache '%s'", fileName );
+		entities.DeleteContents( true );
+		materials.Clear();
+		return false;
+	}
+
+	return true;
+}
+
+/*
+===============
+idMapFile::WriteEntityCache
+===============
+*/
+void idMapFile::WriteEntityCache( const char *fileName, unsigned int sourceCRC ) const {
+	int i, j;
+
+	idFile *file = idLib::fileSystem->OpenFileWrite( fileName );
+	if ( !file ) {
+		idLib::common->Warning( "Couldn't write map entity cache '%s'", fileName );
+		return;
+	}
+
+	file->WriteInt( MAP_ENTITY_CACHE_IDENT );
+	file->WriteInt( MAP_ENTITY_CACHE_VERSION );
+	file->WriteUnsignedInt( sourceCRC );
+
+	file->WriteFloat( version );
+	file->WriteUnsignedInt( geometryCRC );
+	file->WriteInt( entities.Num() );
+	file->WriteInt( materials.Num() );
+
+	for ( i = 0; i < entities.Num(); i++ ) {
+		const idDict &epairs = entities[i]->epairs;
+		file->WriteInt( epairs.GetNumKeyVals() );
+		for ( j = 0; j < epairs.GetNumKeyVals(); j++ ) {
+			file->WriteString( epairs.GetKeyVal( j )->GetKey() );
+			file->WriteString( epairs.GetKeyVal( j )->GetValue() );
+		}
+	}
+
+	for ( i = 0; i < materials.Num(); i++ ) {
+		file->WriteString( materials[i] );
+	}
+
+	idLib::fileSystem->CloseFile( file );
+}
+
 /*
 ===============
 idMapFile::AddEntity
@@ -926,6 +1172,7 @@ idMapFile::RemoveAllEntities
 */
 void idMapFile::RemoveAllEntities() {
 	entities.DeleteContents( true );
+	materials.Clear();
 	hasPrimitiveData = false;
 }
 
@@ -935,6 +1182,10 @@ idMapFile::RemovePrimitiveData
 ===============
 */
 void idMapFile::RemovePrimitiveData() {
+	// keep the material names for GetMaterials
+	if ( hasPrimitiveData ) {
+		GetMaterials( materials );
+	}
 	for ( int i = 0; i < entities.Num(); i++ ) {
 		idMapEntity *ent = entities[i];
 		ent->RemovePrimitiveData();
@@ -182,6 +182,10 @@ public:
 							// which is what the game and dmap want, but the editor will want to always
 							// load a .map file
 	bool					Parse( const char *filename, bool ignoreRegion = false, bool osPath = false );
+							// loads only the entities and their key/value pairs, which is all the game needs
+							// at run time, from a binary cache in generated/ that is keyed by the CRC of the
+							// .map file; the cache is written when the text file has to be parsed
+	bool					ParseEntities( const char *filename, bool ignoreRegion = false );
 	bool					Write( const char *fileName, const char *ext, bool fromBasePath = true );
 							// get the number of entities in the map
 	int						GetNumEntities( void ) const { return entities.Num(); }
@@ -203,7 +207,10 @@ public:
 	void					RemoveEntities( const char *classname );
 	void					RemoveAllEntities();
 	void					RemovePrimitiveData();
-	bool					HasPrimitiveData() { return hasPrimitiveData; }
+	bool					HasPrimitiveData() const { return hasPrimitiveData; }
+							// get the names of all materials used by brushes and patches, also available
+							// when the map was loaded without primitives
+	void					GetMaterials( idStrList &list ) const;
 
 protected:
 	float					version;
@@ -212,9 +219,13 @@ protected:
 	idList<idMapEntity *>	entities;
 	idStr					name;
 	bool					hasPrimitiveData;
+	idStrList				materials;				// materials of the primitives, kept when the primitives are removed
 
 private:
 	void					SetGeometryCRC( void );
+	bool					ParseSource( idLexer &src );
+	bool					LoadEntityCache( const char *fileName, unsigned int sourceCRC );
+	void					WriteEntityCache( const char *fileName, unsigned int sourceCRC ) const;
 };
 
 ID_INLINE idMapFile::idMapFile( void ) {
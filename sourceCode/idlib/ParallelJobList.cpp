@@ -0,0 +1,363 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+/*
+===============================================================================
+
+	idScopedAllocatorLock
+
+===============================================================================
+*/
+
+volatile int idScopedAllocatorLock::parallelSections = 0;
+
+static boost::recursive_mutex *	allocatorMutex = NULL;
+
+/*
+================
+idScopedAllocatorLock::Lock
+================
+*/
+void idScopedAllocatorLock::Lock( void ) {
+	if ( allocatorMutex ) {
+		allocatorMutex->lock();
+	}
+}
+
+/*
+================
+idScopedAllocatorLock::Unlock
+================
+*/
+void idScopedAllocatorLock::Unlock( void ) {
+	if ( allocatorMutex ) {
+		allocatorMutex->unlock();
+	}
+}
+
+/*
+===============================================================================
+
+	idParallelJobManagerLocal
+
+===============================================================================
+*/
+
+// index of the worker thread, see GetThreadIndex
+#ifdef _WIN32
+static __declspec( thread ) int	threadIndex = 0;
+#else
+static __thread int				threadIndex = 0;
+#endif
+
+class idParallelJobManagerLocal : public idParallelJobManager {
+public:
+							idParallelJobManagerLocal( void );
+
+	virtual void			Init( int numThreads );
+	virtual void			Shutdown( void );
+
+	virtual int				GetNumThreads( void ) const { return threads.Num(); }
+	virtual int				GetNumProcessors( void ) const;
+	virtual int				GetThreadIndex( void ) const { return threadIndex; }
+
+	virtual void			Submit( idParallelJobList *jobList );
+	virtual void			Wait( idParallelJobList *jobList );
+
+private:
+	idList<boost::thread *>			threads;
+	idList<idParallelJobList *>		pending;		// submitted lists with jobs that were not picked up yet
+	boost::mutex					mutex;
+	boost::condition_variable		jobsAvailable;
+	boost::condition_variable		jobsDone;
+	bool							shutdown;
+
+	void					WorkerThread( int index );
+	bool					RunNextJob( boost::mutex::scoped_lock &lock, idParallelJobList *jobList );
+};
+
+idParallelJobManagerLocal	parallelJobManagerLocal;
+idParallelJobManager *		parallelJobManager = &parallelJobManagerLocal;
+
+/*
+================
+idParallelJobManagerLocal::idParallelJobManagerLocal
+================
+*/
+idParallelJobManagerLocal::idParallelJobManagerLocal( void ) {
+	shutdown = false;
+}
+
+/*
+================
+idParallelJobManagerLocal::Init
+
+Can be called again to change the number of worker threads.
+================
+*/
+void idParallelJobManagerLocal::Init( int numThreads ) {
+	if ( numThreads < 0 ) {
+		numThreads = GetNumProcessors() - 1;
+	}
+	numThreads = idMath::ClampInt( 0, MAX_JOB_THREADS, numThreads );
+
+	if ( numThreads == threads.Num() ) {
+		return;
+	}
+
+	Shutdown();
+
+	if ( allocatorMutex == NULL ) {
+		allocatorMutex = new boost::recursive_mutex;
+	}
+
+	shutdown = false;
+	for ( int i = 0; i < numThreads; i++ ) {
+		threads.Append( new boost::thread( boost::bind( &idParallelJobManagerLocal::WorkerThread, this, i + 1 ) ) );
+	}
+
+	idLib::common->Printf( "%d parallel job threads\n", numThreads );
+}
+
+/*
+================
+idParallelJobManagerLocal::Shutdown
+================
+*/
+void idParallelJobManagerLocal::Shutdown( void ) {
+	if ( threads.Num() == 0 ) {
+		return;
+	}
+
+	{
+		boost::mutex::scoped_lock lock( mutex );
+		shutdown = true;
+	}
+	jobsAvailable.notify_all();
+
+	for ( int i = 0; i < threads.Num(); i++ ) {
+		threads[i]->join();
+		delete threads[i];
+	}
+	threads.Clear();
+}
+
+/*
+================
+idParallelJobManagerLocal::GetNumProcessors
+================
+*/
+int idParallelJobManagerLocal::GetNumProcessors( void ) const {
+	int numProcessors = boost::thread::hardware_concurrency();
+	return ( numProcessors > 0 ) ? numProcessors : 1;
+}
+
+/*
+================
+idParallelJobManagerLocal::Submit
+================
+*/
+void idParallelJobManagerLocal::Submit( idParallelJobList *jobList ) {
+	assert( !jobList->submitted );
+
+	jobList->nextJob = 0;
+	jobList->numDone = 0;
+	jobList->submitted = true;
+	jobList->runTimer.Clear();
+	jobList->runTimer.Start();
+
+	if ( jobList->jobs.Num() == 0 ) {
+		return;
+	}
+
+	boost::mutex::scoped_lock lock( mutex );
+	if ( jobList->usesAllocators ) {
+		idScopedAllocatorLock::BeginParallelSection();
+	}
+	if ( threads.Num() > 0 ) {
+		pending.Append( jobList );
+		lock.unlock();
+		jobsAvailable.notify_all();
+	}
+}
+
+/*
+================
+idParallelJobManagerLocal::Wait
+================
+*/
+void idParallelJobManagerLocal::Wait( idParallelJobList *jobList ) {
+	assert( jobList->submitted );
+
+	if ( jobList->jobs.Num() > 0 ) {
+		boost::mutex::scoped_lock lock( mutex );
+
+		// help out until there is nothing left to pick up, then wait for the stragglers
+		while( RunNextJob( lock, jobList ) ) {
+		}
+		while( jobList->numDone < jobList->jobs.Num() ) {
+			jobsDone.wait( lock );
+		}
+		if ( jobList->usesAllocators ) {
+			idScopedAllocatorLock::EndParallelSection();
+		}
+	}
+
+	jobList->submitted = false;
+	jobList->runTimer.Stop();
+	jobList->lastRunTime = jobList->runTimer.Milliseconds();
+}
+
+/*
+================
+idParallelJobManagerLocal::RunNextJob
+
+Picks the next job from the given list, or from any pending list if jobList is NULL.
+The lock is released while the job executes. Returns false if there was nothing to run.
+================
+*/
+bool idParallelJobManagerLocal::RunNextJob( boost::mutex::scoped_lock &lock, idParallelJobList *jobList ) {
+	if ( jobList == NULL ) {
+		if ( pending.Num() == 0 ) {
+			return false;
+		}
+		jobList = pending[0];
+	}
+
+	if ( jobList->nextJob >= jobList->jobs.Num() ) {
+		return false;
+	}
+
+	const idParallelJobList::job_t job = jobList->jobs[jobList->nextJob++];
+	if ( jobList->nextJob >= jobList->jobs.Num() ) {
+		pending.Remove( jobList );
+	}
+
+	lock.unlock();
+	{
+		idScopedProfileZone profileZone( jobList->name );
+		job.function( job.data );
+	}
+	lock.lock();
+
+	if ( ++jobList->numDone == jobList->jobs.Num() ) {
+		jobsDone.notify_all();
+	}
+	return true;
+}
+
+/*
+================
+idParallelJobManagerLocal::WorkerThread
+================
+*/
+void idParallelJobManagerLocal::WorkerThread( int index ) {
+	threadIndex = index;
+
+	boost::mutex::scoped_lock lock( mutex );
+
+	while( !shutdown ) {
+		if ( !RunNextJob( lock, NULL ) ) {
+			jobsAvailable.wait( lock );
+		}
+	}
+}
+
+/*
+===============================================================================
+
+	idParallelJobList
+
+===============================================================================
+*/
+
+/*
+================
+idParallelJobList::idParallelJobList
+================
+*/
+idParallelJobList::idParallelJobList( const char *name, bool usesAllocators ) {
+	this->name = name;
+	this->usesAllocators = usesAllocators;
+	jobs.SetGranularity( 64 );
+	nextJob = 0;
+	numDone = 0;
+	submitted = false;
+	lastRunTime = 0.0;
+}
+
+/*
+================
+idParallelJobList::~idParallelJobList
+================
+*/
+idParallelJobList::~idParallelJobList( void ) {
+	if ( submitted ) {
+		Wait();
+	}
+}
+
+/*
+================
+idParallelJobList::AddJob
+================
+*/
+void idParallelJobList::AddJob( jobRun_t function, void *data ) {
+	assert( !submitted );
+	job_t &job = jobs.Alloc();
+	job.function = function;
+	job.data = data;
+}
+
+/*
+================
+idParallelJobList::Clear
+================
+*/
+void idParallelJobList::Clear( void ) {
+	assert( !submitted );
+	jobs.SetNum( 0, false );
+}
+
+/*
+================
+idParallelJobList::Submit
+================
+*/
+void idParallelJobList::Submit( void ) {
+	parallelJobManager->Submit( this );
+}
+
+/*
+================
+idParallelJobList::Wait
+================
+*/
+void idParallelJobList::Wait( void ) {
+	parallelJobManager->Wait( this );
+}
@@ -0,0 +1,145 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+ 
+ This file is part of the The Dark Mod Source Code, originally based 
+ on the Doom 3 GPL Source Code as published in 2011.
+ 
+ The Dark Mod Source Code is free software: you can redistribute it 
+ and/or modify it under the terms of the GNU General Public License as 
+ published by the Free Software Foundation, either version 3 of the License, 
+ or (at your option) any later version. For details, see LICENSE.TXT.
+ 
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+ 
+ $Revision$ (Revision of last commit) 
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+ 
+******************************************************************************/
+
+#ifndef __PARALLELJOBLIST_H__
+#define __PARALLELJOBLIST_H__
+
+/*
+===============================================================================
+
+	Parallel job lists.
+
+	A job list is a set of independent function / data pairs which are
+	executed by the worker threads of the parallelJobManager. The thread
+	that waits for a job list executes jobs as well, so a list always
+	completes, even if no worker threads are running.
+
+	Jobs run concurrently with each other and with the submitting thread.
+	A job may allocate memory (the idLib allocators are serialized while
+	job lists are in flight), but it must not print, use va(), touch idDict
+	string pools or call into any of the engine systems. Lists of jobs that
+	never use the idLib allocators can be created with usesAllocators set
+	to false, so the main thread keeps allocating without the lock while
+	they run.
+
+===============================================================================
+*/
+
+typedef void ( * jobRun_t )( void * );
+
+const int MAX_JOB_THREADS		= 16;
+
+class idParallelJobList {
+	friend class idParallelJobManagerLocal;
+
+public:
+							idParallelJobList( const char *name, bool usesAllocators = true );
+							~idParallelJobList( void );
+
+	void					AddJob( jobRun_t function, void *data );
+	void					Clear( void );
+	int						NumJobs( void ) const { return jobs.Num(); }
+
+							// hands the jobs to the worker threads and returns immediately
+	void					Submit( void );
+							// executes jobs on the calling thread until all jobs are done
+	void					Wait( void );
+	bool					IsSubmitted( void ) const { return submitted; }
+
+	const char *			GetName( void ) const { return name; }
+							// wall clock time between Submit and the end of Wait
+	double					GetLastRunTime( void ) const { return lastRunTime; }
+
+private:
+	typedef struct {
+		jobRun_t			function;
+		void *				data;
+	} job_t;
+
+	const char *			name;
+	bool					usesAllocators;
+	idList<job_t>			jobs;
+	int						nextJob;		// next job to be picked up by a thread
+	int						numDone;		// number of finished jobs
+	bool					submitted;
+	idTimer					runTimer;
+	double					lastRunTime;		// milliseconds
+};
+
+class idParallelJobManager {
+public:
+	virtual					~idParallelJobManager( void ) {}
+
+							// numThreads < 0 uses one worker per core besides the calling thread
+	virtual void			Init( int numThreads ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+	virtual int				GetNumThreads( void ) const = 0;
+	virtual int				GetNumProcessors( void ) const = 0;
+
+							// 0 for any thread that isn't a worker, 1 to MAX_JOB_THREADS for the workers
+	virtual int				GetThreadIndex( void ) const = 0;
+
+							// these are only used by idParallelJobList
+	virtual void			Submit( idParallelJobList *jobList ) = 0;
+	virtual void			Wait( idParallelJobList *jobList ) = 0;
+};
+
+extern idParallelJobManager *	parallelJobManager;
+
+/*
+===============================================================================
+
+	Serializes the non thread safe idLib allocators (idHeap and the idStr
+	data allocator) while job lists or other parallel sections are active.
+	Outside of parallel sections the lock costs a single integer test.
+
+===============================================================================
+*/
+
+class idScopedAllocatorLock {
+public:
+	ID_INLINE				idScopedAllocatorLock( void ) {
+								locked = ( parallelSections != 0 );
+								if ( locked ) {
+									Lock();
+								}
+							}
+	ID_INLINE				~idScopedAllocatorLock( void ) {
+								if ( locked ) {
+									Unlock();
+								}
+							}
+
+	static void				Lock( void );
+	static void				Unlock( void );
+
+							// Other threads may only allocate between these calls. They have to be
+							// called by the main thread, which is the only one allocating outside of them.
+	static void				BeginParallelSection( void ) { parallelSections++; }
+	static void				EndParallelSection( void ) { parallelSections--; }
+
+private:
+							// number of job lists between Submit and the end of Wait, and other active parallel sections
+	static volatile int		parallelSections;
+
+	bool					locked;
+};
+
+#endif /* !__PARALLELJOBLIST_H__ */
@@ -0,0 +1,98 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+/*
+===============================================================================
+
+	Frame profiler.
+
+	Records nested, named zones per thread into ring buffers which can be
+	written out as a Chrome trace (chrome://tracing) with the profileTrace
+	command. The engine implements the profiler, idLib::profiler points at
+	it in the engine as well as in the game module.
+
+	Zone names are copied by the profiler, so the names of the game module
+	don't have to outlive it. When the profiler is off a zone costs one
+	pointer and one flag test.
+
+===============================================================================
+*/
+
+typedef struct {
+	const char *			name;			// valid until the profiler is shut down
+	double					msec;			// includes the time of nested zones
+	int						count;
+} profileZoneTotal_t;
+
+class idProfiler {
+public:
+	virtual					~idProfiler( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+	bool					IsEnabled( void ) const { return enabled; }
+
+							// zones have to be closed on the thread they were opened on, in reverse order
+	virtual void			BeginZone( const char *name ) = 0;
+	virtual void			EndZone( void ) = 0;
+
+							// called by the main thread between frames
+	virtual void			EndFrame( void ) = 0;
+
+							// writes the recorded zones of all threads to a trace file
+	virtual bool			WriteTrace( const char *fileName ) = 0;
+
+							// sums up the time spent in each zone, recording is enabled while totals are collected
+	virtual void			BeginZoneTotals( void ) = 0;
+	virtual void			EndZoneTotals( void ) = 0;
+							// zone totals of all threads, sorted by time
+	virtual void			GetZoneTotals( idList<profileZoneTotal_t> &totals ) const = 0;
+
+protected:
+	volatile bool			enabled;
+};
+
+class idScopedProfileZone {
+public:
+	ID_INLINE				idScopedProfileZone( const char *name ) {
+								active = ( idLib::profiler != NULL && idLib::profiler->IsEnabled() );
+								if ( active ) {
+									idLib::profiler->BeginZone( name );
+								}
+							}
+	ID_INLINE				~idScopedProfileZone( void ) {
+								if ( active ) {
+									idLib::profiler->EndZone();
+								}
+							}
+
+private:
+	bool					active;
+};
+
+extern idProfiler *			profiler;		// only defined by the engine, use idLib::profiler
+
+// records a zone from here to the end of the scope, the tag is used as the zone name
+#define PROFILE_ZONE( tag )		idScopedProfileZone profileZone_##tag( #tag )
+
+#endif /* !__PROFILER_H__ */
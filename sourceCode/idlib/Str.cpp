@@ -89,6 +89,7 @@ void idStr::ReAllocate( int amount, bool keepold ) {
 	alloced = newsize;
 
 #ifdef USE_STRING_DATA_ALLOCATOR
+	idScopedAllocatorLock lock;
 	newbuffer = stringDataAllocator.Alloc( alloced );
 #else
 	newbuffer = new char[ alloced ];
@@ -117,6 +118,7 @@ idStr::FreeData
 void idStr::FreeData( void ) {
 	if ( data && data != baseBuffer ) {
 #ifdef USE_STRING_DATA_ALLOCATOR
+		idScopedAllocatorLock lock;
 		stringDataAllocator.Free( data );
 #else
 		delete[] data;
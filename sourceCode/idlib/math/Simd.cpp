@@ -2875,6 +2875,63 @@ void TestDecalPointCull( void ) {
 	PrintClocks( va( "   simd->DecalPointCull() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestCullBoxes
+============
+*/
+void TestCullBoxes( void ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( idPlane planes[6] );
+	ALIGN16( float boxes[COUNT*6] );
+	ALIGN16( byte cullBits1[COUNT] );
+	ALIGN16( byte cullBits2[COUNT] );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < 6; i++ ) {
+		idVec3 normal( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+		normal.Normalize();
+		planes[i].SetNormal( normal );
+		planes[i][3] = srnd.CRandomFloat() * 5.0f;
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		float *mins = boxes + ( i >> 2 ) * 24 + ( i & 3 );
+		for ( j = 0; j < 3; j++ ) {
+			mins[j*4] = srnd.CRandomFloat() * 10.0f;
+			mins[j*4+12] = mins[j*4] + srnd.RandomFloat() * 3.0f;
+		}
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->CullBoxes( cullBits1, boxes, COUNT, planes, 6 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->CullBoxes()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->CullBoxes( cullBits2, boxes, COUNT, planes, 6 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( cullBits1[i] != cullBits2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->CullBoxes() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestOverlayPointCull
@@ -4193,6 +4250,90 @@ void TestNegate( void ) {
 	PrintClocks( va( "   simd->Negate16( float[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+ScanText
+
+  Walks the text like the lexer, skipping white space, names and strings.
+============
+*/
+static int ScanText( idSIMDProcessor *p, const char *text, int &numLines ) {
+	int numRuns = 0;
+
+	numLines = 0;
+	while( *text ) {
+		text = p->SkipWhiteSpace( text, numLines );
+		text = p->SkipNameChars( text, "/\\:." );
+		text = p->FindFirstOf( text, "\"\n" );
+		if ( *text ) {
+			numLines += ( *text == '\n' );
+			text++;
+		}
+		numRuns++;
+	}
+	return numRuns;
+}
+
+/*
+============
+TestTextScanning
+============
+*/
+void TestTextScanning( void ) {
+	int i, j, numRuns1, numRuns2, numLines1, numLines2;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( char text[COUNT*4+1] );
+	const char *result;
+	static const char chars[] = " \t\n\r\"/\\:._-abcxyzABCXYZ0189{}()*\x80\xff";
+
+	idRandom srnd( RANDOM_SEED );
+
+	idLib::common->Printf("====================================\n" );
+
+	// runs of random lengths of the same character class
+	for ( i = 0; i < COUNT*4; ) {
+		const char c = chars[srnd.RandomInt( sizeof( chars ) - 1 )];
+		for ( j = srnd.RandomInt( 24 ) + 1; j > 0 && i < COUNT*4; j-- ) {
+			text[i++] = ( c >= 'a' && c <= 'z' ) ? 'a' + srnd.RandomInt( 26 ) : c;
+		}
+	}
+	text[COUNT*4] = '\0';
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		numRuns1 = ScanText( p_generic, text, numLines1 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->ScanText()", COUNT*4, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		numRuns2 = ScanText( p_simd, text, numLines2 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	// every start offset within the aligned blocks
+	for ( i = 0; i < 64; i++ ) {
+		int lines1 = 0, lines2 = 0;
+		if ( p_generic->SkipWhiteSpace( text + i, lines1 ) != p_simd->SkipWhiteSpace( text + i, lines2 ) || lines1 != lines2 ) {
+			break;
+		}
+		if ( p_generic->SkipNameChars( text + i, "-" ) != p_simd->SkipNameChars( text + i, "-" ) ) {
+			break;
+		}
+		if ( p_generic->FindFirstOf( text + i, "/*\n" ) != p_simd->FindFirstOf( text + i, "/*\n" ) ) {
+			break;
+		}
+	}
+
+	result = ( i >= 64 && numRuns1 == numRuns2 && numLines1 == numLines2 ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->ScanText() %s", result ), COUNT*4, bestClocksSIMD, bestClocksGeneric );
+}
+
 
 /*
 ============
@@ -4298,6 +4439,7 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	TestTracePointCull();
 	TestDecalPointCull();
 	TestOverlayPointCull();
+	TestCullBoxes();
 	TestDeriveTriPlanes();
 	TestDeriveTangents();
 	TestDeriveUnsmoothedTangents();
@@ -4311,6 +4453,8 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	TestSoundUpSampling();
 	TestSoundMixing();
 
+	TestTextScanning();
+
 	idLib::common->SetRefreshOnPrint( false );
 
 	if ( p_simd != processor ) {
@@ -178,6 +178,9 @@ public:
 	virtual void VPCALL CreateSpecularTextureCoords( idVec3 *texCoords, const idVec3 &lightOrigin, const idVec3 &viewOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) = 0;
 	virtual int  VPCALL CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) = 0;
 	virtual int  VPCALL CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) = 0;
+	// the axial boxes are stored in blocks of four as mins x, y, z and maxs x, y, z of each box,
+	// so numBoxes is a multiple of four; a box is culled if it is completely in front of one of the planes
+	virtual void VPCALL CullBoxes( byte *cullBits, const float *boxes, const int numBoxes, const idPlane *planes, const int numPlanes ) = 0;
 
 	// sound mixing
 	virtual void VPCALL UpSamplePCMTo44kHz( float *dest, const short *pcm, const int numSamples, const int kHz, const int numChannels ) = 0;
@@ -187,6 +190,14 @@ public:
 	virtual void VPCALL MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) = 0;
 	virtual void VPCALL MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) = 0;
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) = 0;
+
+	// text scanning for idLexer, the text has to be zero terminated and the scan always stops at the terminating zero
+	// skips the characters up to ' ' (compared as signed char) and adds the number of skipped newlines to numLines
+	virtual const char * VPCALL SkipWhiteSpace( const char *text, int &numLines ) = 0;
+	// skips letters, digits, underscores and the extra characters
+	virtual const char * VPCALL SkipNameChars( const char *text, const char *extraChars ) = 0;
+	// finds the first of the given characters
+	virtual const char * VPCALL FindFirstOf( const char *text, const char *chars ) = 0;
 };
 
 // pointer to SIMD processor
@@ -2828,6 +2828,38 @@ int VPCALL idSIMD_Generic::CreateVertexProgramShadowCache( idVec4 *vertexCache,
 	return numVerts * 2;
 }
 
+/*
+============
+idSIMD_Generic::CullBoxes
+============
+*/
+void VPCALL idSIMD_Generic::CullBoxes( byte *cullBits, const float *boxes, const int numBoxes, const idPlane *planes, const int numPlanes ) {
+	int i, j;
+
+	assert( ( numBoxes & 3 ) == 0 );
+
+	for ( i = 0; i < numBoxes; i++ ) {
+		const float *mins = boxes + ( i >> 2 ) * 24 + ( i & 3 );
+		const float *maxs = mins + 12;
+
+		cullBits[i] = 0;
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &plane = planes[j];
+			float d;
+
+			// distance of the corner furthest behind the plane
+			d = plane[3];
+			d += plane[0] * ( ( plane[0] > 0.0f ) ? mins[0] : maxs[0] );
+			d += plane[1] * ( ( plane[1] > 0.0f ) ? mins[4] : maxs[4] );
+			d += plane[2] * ( ( plane[2] > 0.0f ) ? mins[8] : maxs[8] );
+			if ( d > 0.0f ) {
+				cullBits[i] = 1;
+				break;
+			}
+		}
+	}
+}
+
 /*
 ============
 idSIMD_Generic::UpSamplePCMTo44kHz
@@ -3048,3 +3080,49 @@ void VPCALL idSIMD_Generic::MixedSoundToSamples( short *samples, const float *mi
 		}
 	}
 }
+
+/*
+============
+idSIMD_Generic::SkipWhiteSpace
+============
+*/
+const char * VPCALL idSIMD_Generic::SkipWhiteSpace( const char *text, int &numLines ) {
+	while( *text <= ' ' && *text != '\0' ) {
+		if ( *text == '\n' ) {
+			numLines++;
+		}
+		text++;
+	}
+	return text;
+}
+
+/*
+============
+idSIMD_Generic::SkipNameChars
+============
+*/
+const char * VPCALL idSIMD_Generic::SkipNameChars( const char *text, const char *extraChars ) {
+	while( 1 ) {
+		const char c = *text;
+		if ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) || c == '_' ) {
+			text++;
+			continue;
+		}
+		if ( c == '\0' || strchr( extraChars, c ) == NULL ) {
+			return text;
+		}
+		text++;
+	}
+}
+
+/*
+============
+idSIMD_Generic::FindFirstOf
+============
+*/
+const char * VPCALL idSIMD_Generic::FindFirstOf( const char *text, const char *chars ) {
+	while( *text != '\0' && strchr( chars, *text ) == NULL ) {
+		text++;
+	}
+	return text;
+}
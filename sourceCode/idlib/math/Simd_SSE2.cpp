@@ -866,3 +866,569 @@ void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBu
 }
 
 #endif /* _WIN32 */
+
+#if defined(ID_SIMD_SSE2_INTRINSICS)
+
+#include <emmintrin.h>
+
+/*
+  The intrinsic functions are compiled for SSE2 one by one, the rest of this
+  file and the inline functions of the headers keep the default target, so
+  they can't end up with SSE2 instructions on processors without it. MSVC
+  allows the intrinsics in any function.
+*/
+#if defined(__GNUC__) && !defined(__SSE2__)
+#define ID_SSE2_TARGET		__attribute__((target("sse2")))
+#else
+#define ID_SSE2_TARGET
+#endif
+
+#if !defined(_WIN32) && !( defined(MACOS_X) && defined(__i386__) )
+
+/*
+============
+idSIMD_SSE2::GetName
+============
+*/
+const char * idSIMD_SSE2::GetName( void ) const {
+	return "MMX & SSE & SSE2";
+}
+
+/*
+============
+idSIMD_SSE2::MixedSoundToSamples
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) {
+
+	assert( ( numSamples % MIXBUFFER_SAMPLES ) == 0 );
+
+	for ( int i = 0; i < numSamples; i += 8 ) {
+		__m128i a = _mm_cvtps_epi32( _mm_load_ps( mixBuffer + i + 0 ) );
+		__m128i b = _mm_cvtps_epi32( _mm_load_ps( mixBuffer + i + 4 ) );
+		_mm_storeu_si128( (__m128i *)( samples + i ), _mm_packs_epi32( a, b ) );
+	}
+}
+
+/*
+============
+LoadJointQuats4
+
+  Loads four joints into structure of arrays form. A joint quat is seven
+  floats, so the quaternion and the translation are loaded as the first and
+  the last four floats of the joint to stay inside of it.
+============
+*/
+ID_SSE2_TARGET static ID_INLINE void LoadJointQuats4( const idJointQuat *j0, const idJointQuat *j1, const idJointQuat *j2, const idJointQuat *j3,
+										__m128 &qx, __m128 &qy, __m128 &qz, __m128 &qw, __m128 &tx, __m128 &ty, __m128 &tz ) {
+	__m128 w;
+
+	qx = _mm_loadu_ps( j0->q.ToFloatPtr() );
+	qy = _mm_loadu_ps( j1->q.ToFloatPtr() );
+	qz = _mm_loadu_ps( j2->q.ToFloatPtr() );
+	qw = _mm_loadu_ps( j3->q.ToFloatPtr() );
+	_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+
+	w = _mm_loadu_ps( j0->q.ToFloatPtr() + 3 );
+	tx = _mm_loadu_ps( j1->q.ToFloatPtr() + 3 );
+	ty = _mm_loadu_ps( j2->q.ToFloatPtr() + 3 );
+	tz = _mm_loadu_ps( j3->q.ToFloatPtr() + 3 );
+	_MM_TRANSPOSE4_PS( w, tx, ty, tz );
+}
+
+/*
+============
+idSIMD_SSE2::BlendJoints
+
+  Same as idQuat::Slerp and idVec3::Lerp for four joints at a time. The
+  angle between the quaternions is at most half pi after the sign flip,
+  so the sine and arc tangent polynomials need no range reduction.
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			int j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+
+	const __m128 vlerp = _mm_set1_ps( lerp );
+	const __m128 vlerp1 = _mm_set1_ps( 1.0f - lerp );
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 half = _mm_set1_ps( 0.5f );
+	const __m128 three = _mm_set1_ps( 3.0f );
+	const __m128 halfPI = _mm_set1_ps( idMath::HALF_PI );
+	const __m128 epsilon = _mm_set1_ps( 1e-6f );
+	const __m128 signBit = _mm_castsi128_ps( _mm_set1_epi32( 0x80000000 ) );
+
+	for ( i = 0; i <= numJoints - 4; i += 4 ) {
+		idJointQuat *j0 = &joints[index[i+0]];
+		idJointQuat *j1 = &joints[index[i+1]];
+		idJointQuat *j2 = &joints[index[i+2]];
+		idJointQuat *j3 = &joints[index[i+3]];
+		__m128 qx, qy, qz, qw, tx, ty, tz;
+		__m128 bx, by, bz, bw, btx, bty, btz;
+
+		LoadJointQuats4( j0, j1, j2, j3, qx, qy, qz, qw, tx, ty, tz );
+		LoadJointQuats4( &blendJoints[index[i+0]], &blendJoints[index[i+1]], &blendJoints[index[i+2]], &blendJoints[index[i+3]], bx, by, bz, bw, btx, bty, btz );
+
+		// lerp the translations
+		tx = _mm_add_ps( tx, _mm_mul_ps( vlerp, _mm_sub_ps( btx, tx ) ) );
+		ty = _mm_add_ps( ty, _mm_mul_ps( vlerp, _mm_sub_ps( bty, ty ) ) );
+		tz = _mm_add_ps( tz, _mm_mul_ps( vlerp, _mm_sub_ps( btz, tz ) ) );
+
+		// cosom = dot( from, to ), take the shortest path
+		__m128 cosom = _mm_add_ps( _mm_add_ps( _mm_mul_ps( qx, bx ), _mm_mul_ps( qy, by ) ), _mm_add_ps( _mm_mul_ps( qz, bz ), _mm_mul_ps( qw, bw ) ) );
+		const __m128 sign = _mm_and_ps( cosom, signBit );
+		cosom = _mm_xor_ps( cosom, sign );
+
+		// sinom = 1 / sin( omega ), refined once
+		__m128 scale0 = _mm_sub_ps( one, _mm_mul_ps( cosom, cosom ) );
+		__m128 sinom = _mm_rsqrt_ps( scale0 );
+		sinom = _mm_mul_ps( _mm_mul_ps( half, sinom ), _mm_sub_ps( three, _mm_mul_ps( _mm_mul_ps( scale0, sinom ), sinom ) ) );
+
+		// omega = atan2( sin, cos ) with both of them positive
+		const __m128 sinVal = _mm_mul_ps( scale0, sinom );
+		const __m128 swap = _mm_cmpgt_ps( sinVal, cosom );
+		const __m128 a = _mm_div_ps( _mm_min_ps( sinVal, cosom ), _mm_max_ps( sinVal, cosom ) );
+		const __m128 s = _mm_mul_ps( a, a );
+		__m128 p = _mm_set1_ps( 0.0028662257f );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( -0.0161657367f ) );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( 0.0429096138f ) );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( -0.0752896400f ) );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( 0.1065626393f ) );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( -0.1420889944f ) );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( 0.1999355085f ) );
+		p = _mm_add_ps( _mm_mul_ps( p, s ), _mm_set1_ps( -0.3333314528f ) );
+		p = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( p, s ), one ), a );
+		const __m128 omega = _mm_or_ps( _mm_and_ps( swap, _mm_sub_ps( halfPI, p ) ), _mm_andnot_ps( swap, p ) );
+
+		// scale0 = sin( ( 1 - t ) * omega ) * sinom, scale1 = sin( t * omega ) * sinom
+		__m128 a0 = _mm_mul_ps( vlerp1, omega );
+		__m128 a1 = _mm_mul_ps( vlerp, omega );
+		__m128 s0 = _mm_mul_ps( a0, a0 );
+		__m128 s1 = _mm_mul_ps( a1, a1 );
+		__m128 p0 = _mm_set1_ps( -2.39e-08f );
+		__m128 p1 = p0;
+		p0 = _mm_add_ps( _mm_mul_ps( p0, s0 ), _mm_set1_ps( 2.7526e-06f ) );
+		p1 = _mm_add_ps( _mm_mul_ps( p1, s1 ), _mm_set1_ps( 2.7526e-06f ) );
+		p0 = _mm_add_ps( _mm_mul_ps( p0, s0 ), _mm_set1_ps( -1.98409e-04f ) );
+		p1 = _mm_add_ps( _mm_mul_ps( p1, s1 ), _mm_set1_ps( -1.98409e-04f ) );
+		p0 = _mm_add_ps( _mm_mul_ps( p0, s0 ), _mm_set1_ps( 8.3333315e-03f ) );
+		p1 = _mm_add_ps( _mm_mul_ps( p1, s1 ), _mm_set1_ps( 8.3333315e-03f ) );
+		p0 = _mm_add_ps( _mm_mul_ps( p0, s0 ), _mm_set1_ps( -1.666666664e-01f ) );
+		p1 = _mm_add_ps( _mm_mul_ps( p1, s1 ), _mm_set1_ps( -1.666666664e-01f ) );
+		p0 = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( p0, s0 ), one ), a0 );
+		p1 = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( p1, s1 ), one ), a1 );
+
+		// use a plain lerp when the quaternions are very close
+		const __m128 close = _mm_cmple_ps( _mm_sub_ps( one, cosom ), epsilon );
+		scale0 = _mm_or_ps( _mm_and_ps( close, vlerp1 ), _mm_andnot_ps( close, _mm_mul_ps( p0, sinom ) ) );
+		__m128 scale1 = _mm_or_ps( _mm_and_ps( close, vlerp ), _mm_andnot_ps( close, _mm_mul_ps( p1, sinom ) ) );
+		scale1 = _mm_xor_ps( scale1, sign );
+
+		qx = _mm_add_ps( _mm_mul_ps( scale0, qx ), _mm_mul_ps( scale1, bx ) );
+		qy = _mm_add_ps( _mm_mul_ps( scale0, qy ), _mm_mul_ps( scale1, by ) );
+		qz = _mm_add_ps( _mm_mul_ps( scale0, qz ), _mm_mul_ps( scale1, bz ) );
+		qw = _mm_add_ps( _mm_mul_ps( scale0, qw ), _mm_mul_ps( scale1, bw ) );
+
+		// back to one joint per register, w and the translation are the last four floats of a joint
+		__m128 w = qw;
+		_MM_TRANSPOSE4_PS( w, tx, ty, tz );
+		_mm_storeu_ps( j0->q.ToFloatPtr() + 3, w );
+		_mm_storeu_ps( j1->q.ToFloatPtr() + 3, tx );
+		_mm_storeu_ps( j2->q.ToFloatPtr() + 3, ty );
+		_mm_storeu_ps( j3->q.ToFloatPtr() + 3, tz );
+
+		_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+		_mm_storeu_ps( j0->q.ToFloatPtr(), qx );
+		_mm_storeu_ps( j1->q.ToFloatPtr(), qy );
+		_mm_storeu_ps( j2->q.ToFloatPtr(), qz );
+		_mm_storeu_ps( j3->q.ToFloatPtr(), qw );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		int j = index[i];
+		joints[j].q.Slerp( joints[j].q, blendJoints[j].q, lerp );
+		joints[j].t.Lerp( joints[j].t, blendJoints[j].t, lerp );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::ConvertJointQuatsToJointMats
+
+  Same as idQuat::ToMat3 for four joints at a time. The three rows of the
+  joint matrices are transposed back out of the structure of arrays.
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) {
+	int i;
+
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( i = 0; i <= numJoints - 4; i += 4 ) {
+		__m128 x, y, z, w, tx, ty, tz;
+
+		LoadJointQuats4( &jointQuats[i+0], &jointQuats[i+1], &jointQuats[i+2], &jointQuats[i+3], x, y, z, w, tx, ty, tz );
+
+		const __m128 x2 = _mm_add_ps( x, x );
+		const __m128 y2 = _mm_add_ps( y, y );
+		const __m128 z2 = _mm_add_ps( z, z );
+
+		const __m128 xx = _mm_mul_ps( x, x2 );
+		const __m128 xy = _mm_mul_ps( x, y2 );
+		const __m128 xz = _mm_mul_ps( x, z2 );
+		const __m128 yy = _mm_mul_ps( y, y2 );
+		const __m128 yz = _mm_mul_ps( y, z2 );
+		const __m128 zz = _mm_mul_ps( z, z2 );
+		const __m128 wx = _mm_mul_ps( w, x2 );
+		const __m128 wy = _mm_mul_ps( w, y2 );
+		const __m128 wz = _mm_mul_ps( w, z2 );
+
+		// the rows of the joint matrix are the columns of the rotation matrix followed by the translation
+		__m128 r00 = _mm_sub_ps( one, _mm_add_ps( yy, zz ) );
+		__m128 r01 = _mm_add_ps( xy, wz );
+		__m128 r02 = _mm_sub_ps( xz, wy );
+		__m128 r03 = tx;
+
+		__m128 r10 = _mm_sub_ps( xy, wz );
+		__m128 r11 = _mm_sub_ps( one, _mm_add_ps( xx, zz ) );
+		__m128 r12 = _mm_add_ps( yz, wx );
+		__m128 r13 = ty;
+
+		__m128 r20 = _mm_add_ps( xz, wy );
+		__m128 r21 = _mm_sub_ps( yz, wx );
+		__m128 r22 = _mm_sub_ps( one, _mm_add_ps( xx, yy ) );
+		__m128 r23 = tz;
+
+		_MM_TRANSPOSE4_PS( r00, r01, r02, r03 );
+		_MM_TRANSPOSE4_PS( r10, r11, r12, r13 );
+		_MM_TRANSPOSE4_PS( r20, r21, r22, r23 );
+
+		float *m0 = jointMats[i+0].ToFloatPtr();
+		float *m1 = jointMats[i+1].ToFloatPtr();
+		float *m2 = jointMats[i+2].ToFloatPtr();
+		float *m3 = jointMats[i+3].ToFloatPtr();
+
+		_mm_storeu_ps( m0 + 0, r00 );
+		_mm_storeu_ps( m0 + 4, r10 );
+		_mm_storeu_ps( m0 + 8, r20 );
+		_mm_storeu_ps( m1 + 0, r01 );
+		_mm_storeu_ps( m1 + 4, r11 );
+		_mm_storeu_ps( m1 + 8, r21 );
+		_mm_storeu_ps( m2 + 0, r02 );
+		_mm_storeu_ps( m2 + 4, r12 );
+		_mm_storeu_ps( m2 + 8, r22 );
+		_mm_storeu_ps( m3 + 0, r03 );
+		_mm_storeu_ps( m3 + 4, r13 );
+		_mm_storeu_ps( m3 + 8, r23 );
+	}
+
+	for ( ; i < numJoints; i++ ) {
+		jointMats[i].SetRotation( jointQuats[i].q.ToMat3() );
+		jointMats[i].SetTranslation( jointQuats[i].t );
+	}
+}
+
+#endif
+
+/*
+============
+idSIMD_SSE2::MixSoundTwoSpeakerMono
+
+  The volumes for two consecutive output frames are kept in one register and
+  ramped with a single add, the mix buffer and the samples have to be aligned.
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	__m128 vol0 = _mm_setr_ps( lastV[0], lastV[1], lastV[0] + incL, lastV[1] + incR );
+	__m128 vol1 = _mm_add_ps( vol0, _mm_setr_ps( 2.0f * incL, 2.0f * incR, 2.0f * incL, 2.0f * incR ) );
+	const __m128 inc = _mm_setr_ps( 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 4 ) {
+		const __m128 s = _mm_load_ps( samples + i );
+		float *mix = mixBuffer + i * 2;
+
+		_mm_store_ps( mix + 0, _mm_add_ps( _mm_load_ps( mix + 0 ), _mm_mul_ps( _mm_unpacklo_ps( s, s ), vol0 ) ) );
+		_mm_store_ps( mix + 4, _mm_add_ps( _mm_load_ps( mix + 4 ), _mm_mul_ps( _mm_unpackhi_ps( s, s ), vol1 ) ) );
+
+		vol0 = _mm_add_ps( vol0, inc );
+		vol1 = _mm_add_ps( vol1, inc );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundTwoSpeakerStereo
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	__m128 vol0 = _mm_setr_ps( lastV[0], lastV[1], lastV[0] + incL, lastV[1] + incR );
+	__m128 vol1 = _mm_add_ps( vol0, _mm_setr_ps( 2.0f * incL, 2.0f * incR, 2.0f * incL, 2.0f * incR ) );
+	const __m128 inc = _mm_setr_ps( 4.0f * incL, 4.0f * incR, 4.0f * incL, 4.0f * incR );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES * 2; i += 8 ) {
+		_mm_store_ps( mixBuffer + i + 0, _mm_add_ps( _mm_load_ps( mixBuffer + i + 0 ), _mm_mul_ps( _mm_load_ps( samples + i + 0 ), vol0 ) ) );
+		_mm_store_ps( mixBuffer + i + 4, _mm_add_ps( _mm_load_ps( mixBuffer + i + 4 ), _mm_mul_ps( _mm_load_ps( samples + i + 4 ), vol1 ) ) );
+
+		vol0 = _mm_add_ps( vol0, inc );
+		vol1 = _mm_add_ps( vol1, inc );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundSixSpeakerMono
+
+  Two output frames of six speakers are three registers, the volumes are laid out the same way.
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	float inc[6];
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	for ( int i = 0; i < 6; i++ ) {
+		inc[i] = ( currentV[i] - lastV[i] ) / MIXBUFFER_SAMPLES;
+	}
+
+	__m128 vol0 = _mm_setr_ps( lastV[0], lastV[1], lastV[2], lastV[3] );
+	__m128 vol1 = _mm_setr_ps( lastV[4], lastV[5], lastV[0] + inc[0], lastV[1] + inc[1] );
+	__m128 vol2 = _mm_setr_ps( lastV[2] + inc[2], lastV[3] + inc[3], lastV[4] + inc[4], lastV[5] + inc[5] );
+	const __m128 inc0 = _mm_setr_ps( 2.0f * inc[0], 2.0f * inc[1], 2.0f * inc[2], 2.0f * inc[3] );
+	const __m128 inc1 = _mm_setr_ps( 2.0f * inc[4], 2.0f * inc[5], 2.0f * inc[0], 2.0f * inc[1] );
+	const __m128 inc2 = _mm_setr_ps( 2.0f * inc[2], 2.0f * inc[3], 2.0f * inc[4], 2.0f * inc[5] );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 4 ) {
+		const __m128 s = _mm_load_ps( samples + i );
+		float *mix = mixBuffer + i * 6;
+
+		_mm_store_ps( mix + 0, _mm_add_ps( _mm_load_ps( mix + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 0, 0, 0, 0 ) ), vol0 ) ) );
+		_mm_store_ps( mix + 4, _mm_add_ps( _mm_load_ps( mix + 4 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 1, 0, 0 ) ), vol1 ) ) );
+		_mm_store_ps( mix + 8, _mm_add_ps( _mm_load_ps( mix + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 1, 1, 1 ) ), vol2 ) ) );
+
+		vol0 = _mm_add_ps( vol0, inc0 );
+		vol1 = _mm_add_ps( vol1, inc1 );
+		vol2 = _mm_add_ps( vol2, inc2 );
+
+		_mm_store_ps( mix + 12, _mm_add_ps( _mm_load_ps( mix + 12 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 2, 2, 2, 2 ) ), vol0 ) ) );
+		_mm_store_ps( mix + 16, _mm_add_ps( _mm_load_ps( mix + 16 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 3, 3, 2, 2 ) ), vol1 ) ) );
+		_mm_store_ps( mix + 20, _mm_add_ps( _mm_load_ps( mix + 20 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 3, 3, 3, 3 ) ), vol2 ) ) );
+
+		vol0 = _mm_add_ps( vol0, inc0 );
+		vol1 = _mm_add_ps( vol1, inc1 );
+		vol2 = _mm_add_ps( vol2, inc2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::MixSoundSixSpeakerStereo
+
+  The left sample goes to speakers 0, 2, 3 and 4, the right sample to 1 and 5.
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	float inc[6];
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	for ( int i = 0; i < 6; i++ ) {
+		inc[i] = ( currentV[i] - lastV[i] ) / MIXBUFFER_SAMPLES;
+	}
+
+	__m128 vol0 = _mm_setr_ps( lastV[0], lastV[1], lastV[2], lastV[3] );
+	__m128 vol1 = _mm_setr_ps( lastV[4], lastV[5], lastV[0] + inc[0], lastV[1] + inc[1] );
+	__m128 vol2 = _mm_setr_ps( lastV[2] + inc[2], lastV[3] + inc[3], lastV[4] + inc[4], lastV[5] + inc[5] );
+	const __m128 inc0 = _mm_setr_ps( 2.0f * inc[0], 2.0f * inc[1], 2.0f * inc[2], 2.0f * inc[3] );
+	const __m128 inc1 = _mm_setr_ps( 2.0f * inc[4], 2.0f * inc[5], 2.0f * inc[0], 2.0f * inc[1] );
+	const __m128 inc2 = _mm_setr_ps( 2.0f * inc[2], 2.0f * inc[3], 2.0f * inc[4], 2.0f * inc[5] );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		// left0 right0 left1 right1
+		const __m128 s = _mm_load_ps( samples + i * 2 );
+		float *mix = mixBuffer + i * 6;
+
+		_mm_store_ps( mix + 0, _mm_add_ps( _mm_load_ps( mix + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 0, 0, 1, 0 ) ), vol0 ) ) );
+		_mm_store_ps( mix + 4, _mm_add_ps( _mm_load_ps( mix + 4 ), _mm_mul_ps( s, vol1 ) ) );
+		_mm_store_ps( mix + 8, _mm_add_ps( _mm_load_ps( mix + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, _MM_SHUFFLE( 3, 2, 2, 2 ) ), vol2 ) ) );
+
+		vol0 = _mm_add_ps( vol0, inc0 );
+		vol1 = _mm_add_ps( vol1, inc1 );
+		vol2 = _mm_add_ps( vol2, inc2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE2::CullBoxes
+
+  Tests the four boxes of a block at once. For every plane the box corner
+  furthest behind it is picked per axis, the box is culled if even that
+  corner is in front of the plane.
+============
+*/
+ID_SSE2_TARGET void VPCALL idSIMD_SSE2::CullBoxes( byte *cullBits, const float *boxes, const int numBoxes, const idPlane *planes, const int numPlanes ) {
+	const __m128 zero = _mm_setzero_ps();
+
+	assert( ( numBoxes & 3 ) == 0 );
+
+	for ( int i = 0; i < numBoxes; i += 4 ) {
+		const float *block = boxes + i * 6;
+		const __m128 minX = _mm_loadu_ps( block + 0 );
+		const __m128 minY = _mm_loadu_ps( block + 4 );
+		const __m128 minZ = _mm_loadu_ps( block + 8 );
+		const __m128 maxX = _mm_loadu_ps( block + 12 );
+		const __m128 maxY = _mm_loadu_ps( block + 16 );
+		const __m128 maxZ = _mm_loadu_ps( block + 20 );
+		__m128 culled = zero;
+
+		for ( int j = 0; j < numPlanes; j++ ) {
+			const idPlane &plane = planes[j];
+
+			__m128 d = _mm_set1_ps( plane[3] );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_set1_ps( plane[0] ), ( plane[0] > 0.0f ) ? minX : maxX ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_set1_ps( plane[1] ), ( plane[1] > 0.0f ) ? minY : maxY ) );
+			d = _mm_add_ps( d, _mm_mul_ps( _mm_set1_ps( plane[2] ), ( plane[2] > 0.0f ) ? minZ : maxZ ) );
+			culled = _mm_or_ps( culled, _mm_cmpgt_ps( d, zero ) );
+		}
+
+		const int mask = _mm_movemask_ps( culled );
+		cullBits[i+0] = ( mask >> 0 ) & 1;
+		cullBits[i+1] = ( mask >> 1 ) & 1;
+		cullBits[i+2] = ( mask >> 2 ) & 1;
+		cullBits[i+3] = ( mask >> 3 ) & 1;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::SkipWhiteSpace
+
+  The text scanners load the aligned 16 byte blocks the text is in, so they never
+  read into the next page after the terminating zero. The characters in front of
+  the text are masked out in the first block.
+============
+*/
+ID_SSE2_TARGET const char * VPCALL idSIMD_SSE2::SkipWhiteSpace( const char *text, int &numLines ) {
+	const __m128i space = _mm_set1_epi8( ' ' );
+	const __m128i newLine = _mm_set1_epi8( '\n' );
+	const __m128i zero = _mm_setzero_si128();
+
+	const int offset = (int)( (size_t)text & 15 );
+	const __m128i *block = (const __m128i *)( text - offset );
+	int scanMask = ( 0xFFFF << offset ) & 0xFFFF;
+
+	while( 1 ) {
+		const __m128i chars = _mm_load_si128( block );
+		// the signed compare treats characters above 127 as white space like the lexer does
+		const int stop = _mm_movemask_epi8( _mm_or_si128( _mm_cmpgt_epi8( chars, space ), _mm_cmpeq_epi8( chars, zero ) ) ) & scanMask;
+		const int lines = _mm_movemask_epi8( _mm_cmpeq_epi8( chars, newLine ) ) & scanMask;
+		if ( stop ) {
+			const int skipped = ( stop & -stop ) - 1;
+			numLines += idMath::BitCount( lines & skipped );
+			return (const char *)block + idMath::BitCount( skipped );
+		}
+		numLines += idMath::BitCount( lines );
+		block++;
+		scanMask = 0xFFFF;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::SkipNameChars
+============
+*/
+ID_SSE2_TARGET const char * VPCALL idSIMD_SSE2::SkipNameChars( const char *text, const char *extraChars ) {
+	__m128i extra[8];
+	int numExtra;
+
+	for ( numExtra = 0; extraChars[numExtra] != '\0'; numExtra++ ) {
+		assert( numExtra < 8 );
+		extra[numExtra] = _mm_set1_epi8( extraChars[numExtra] );
+	}
+
+	const __m128i lowerCase = _mm_set1_epi8( 0x20 );
+	const __m128i beforeA = _mm_set1_epi8( 'a' - 1 );
+	const __m128i afterZ = _mm_set1_epi8( 'z' + 1 );
+	const __m128i before0 = _mm_set1_epi8( '0' - 1 );
+	const __m128i after9 = _mm_set1_epi8( '9' + 1 );
+	const __m128i underscore = _mm_set1_epi8( '_' );
+
+	const int offset = (int)( (size_t)text & 15 );
+	const __m128i *block = (const __m128i *)( text - offset );
+	int scanMask = ( 0xFFFF << offset ) & 0xFFFF;
+
+	while( 1 ) {
+		const __m128i chars = _mm_load_si128( block );
+		const __m128i lower = _mm_or_si128( chars, lowerCase );
+		__m128i name = _mm_and_si128( _mm_cmpgt_epi8( lower, beforeA ), _mm_cmplt_epi8( lower, afterZ ) );
+		name = _mm_or_si128( name, _mm_and_si128( _mm_cmpgt_epi8( chars, before0 ), _mm_cmplt_epi8( chars, after9 ) ) );
+		name = _mm_or_si128( name, _mm_cmpeq_epi8( chars, underscore ) );
+		for ( int i = 0; i < numExtra; i++ ) {
+			name = _mm_or_si128( name, _mm_cmpeq_epi8( chars, extra[i] ) );
+		}
+		// the terminating zero is never a name character
+		const int stop = ~_mm_movemask_epi8( name ) & scanMask;
+		if ( stop ) {
+			return (const char *)block + idMath::BitCount( ( stop & -stop ) - 1 );
+		}
+		block++;
+		scanMask = 0xFFFF;
+	}
+}
+
+/*
+============
+idSIMD_SSE2::FindFirstOf
+============
+*/
+ID_SSE2_TARGET const char * VPCALL idSIMD_SSE2::FindFirstOf( const char *text, const char *chars ) {
+	__m128i find[8];
+	int numFind;
+
+	for ( numFind = 0; chars[numFind] != '\0'; numFind++ ) {
+		assert( numFind < 8 );
+		find[numFind] = _mm_set1_epi8( chars[numFind] );
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+
+	const int offset = (int)( (size_t)text & 15 );
+	const __m128i *block = (const __m128i *)( text - offset );
+	int scanMask = ( 0xFFFF << offset ) & 0xFFFF;
+
+	while( 1 ) {
+		const __m128i b = _mm_load_si128( block );
+		__m128i found = _mm_cmpeq_epi8( b, zero );
+		for ( int i = 0; i < numFind; i++ ) {
+			found = _mm_or_si128( found, _mm_cmpeq_epi8( b, find[i] ) );
+		}
+		const int stop = _mm_movemask_epi8( found ) & scanMask;
+		if ( stop ) {
+			return (const char *)block + idMath::BitCount( ( stop & -stop ) - 1 );
+		}
+		block++;
+		scanMask = 0xFFFF;
+	}
+}
+
+#endif /* ID_SIMD_SSE2_INTRINSICS */
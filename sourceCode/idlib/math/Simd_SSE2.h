@@ -25,9 +25,20 @@
 
 	SSE2 implementation of idSIMDProcessor
 
+	The sound mixing routines use compiler intrinsics, so they are
+	available to every x86 compiler and not only to the inline assembly
+	of the 32 bit MSVC build. Compilers without the inline assembly also
+	get intrinsic versions of the joint blending and conversion, which
+	the MSVC build has in idSIMD_SSE. The text scanning for idLexer
+	tests 16 characters at a time.
+
 ===============================================================================
 */
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define ID_SIMD_SSE2_INTRINSICS
+#endif
+
 class idSIMD_SSE2 : public idSIMD_SSE {
 public:
 #if defined(MACOS_X) && defined(__i386__)
@@ -42,6 +53,27 @@ public:
 
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples );
 
+#elif defined(ID_SIMD_SSE2_INTRINSICS)
+	virtual const char * VPCALL GetName( void ) const;
+
+	virtual void VPCALL BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints );
+	virtual void VPCALL ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints );
+
+	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples );
+
+#endif
+
+#if defined(ID_SIMD_SSE2_INTRINSICS)
+	virtual void VPCALL MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] );
+	virtual void VPCALL MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] );
+	virtual void VPCALL MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] );
+	virtual void VPCALL MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] );
+
+	virtual void VPCALL CullBoxes( byte *cullBits, const float *boxes, const int numBoxes, const idPlane *planes, const int numPlanes );
+
+	virtual const char * VPCALL SkipWhiteSpace( const char *text, int &numLines );
+	virtual const char * VPCALL SkipNameChars( const char *text, const char *extraChars );
+	virtual const char * VPCALL FindFirstOf( const char *text, const char *chars );
 #endif
 };
 
@@ -1962,6 +1962,43 @@ void idImageManager::BeginLevelLoad() {
 	}
 }
 
+/*
+====================
+R_PrefetchImage
+
+Queues the file that ActuallyLoadImage will read for the image, so it can be read
+ahead while the previous images are uploaded. The precompressed file is only queued
+if CheckPrecompressedImage is going to accept it.
+====================
+*/
+static void R_PrefetchImage( const idImage *image ) {
+	if ( image->cubeFiles != CF_2D || image->isPartialImage ) {
+		return;
+	}
+
+	if ( globalImages->image_usePrecompressedTextures.GetBool() ) {
+		char filename[MAX_IMAGE_NAME];
+		fileStat_t stat;
+		image->ImageProgramStringToCompressedFileName( image->imgName, filename );
+		if ( fileSystem->StatFile( filename, stat ) && image->IsPrecompressedImageUsable( stat.timestamp ) ) {
+			fileSystem->PrefetchFile( filename );
+			return;
+		}
+	}
+
+	// image programs read several files, only plain image names are predictable
+	if ( image->imgName.Find( '(' ) != -1 ) {
+		return;
+	}
+
+	idStr name = image->imgName;
+	name.DefaultFileExtension( ".tga" );
+	if ( !fileSystem->PrefetchFile( name ) && name.CheckExtension( ".tga" ) ) {
+		name.SetFileExtension( ".jpg" );
+		fileSystem->PrefetchFile( name );
+	}
+}
+
 /*
 ====================
 EndLevelLoad
@@ -2015,6 +2052,16 @@ void idImageManager::EndLevelLoad()
 
 	common->PacifierUpdate(LOAD_KEY_IMAGES_START,images.Num()/LOAD_KEY_IMAGE_GRANULARITY); // grayman #3763
 
+	// queue the files in load order so they are read while the previous images are uploaded
+	for ( int i = 0 ; i < images.Num() ; i++ )
+	{
+		idImage	*image = images[ i ];
+		if ( !image->generatorFunction && image->levelLoadReferenced && (image->texnum == idImage::TEXTURE_NOT_LOADED) && !image->partialImage )
+		{
+			R_PrefetchImage( image );
+		}
+	}
+
 	// load the ones we do need, if we are preloading
 	for ( int i = 0 ; i < images.Num() ; i++ )
 	{
@@ -2046,6 +2093,8 @@ void idImageManager::EndLevelLoad()
 
 	}
 
+	fileSystem->ClearPrefetch();
+
 	const int end = Sys_Milliseconds();
 	common->Printf( "%5i purged from previous\n", purgeCount );
 	common->Printf( "%5i kept from previous\n", keepCount );
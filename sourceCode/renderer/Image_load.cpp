@@ -1310,12 +1310,13 @@ bool idImage::ShouldImageBePartialCached() {
 
 /*
 ================
-CheckPrecompressedImage
+IsPrecompressedImageUsable
 
-If fullLoad is false, only the small mip levels of the image will be loaded
+Returns false if the precompressed file with the given timestamp must not be used,
+so the source image is loaded instead
 ================
 */
-bool idImage::CheckPrecompressedImage( bool fullLoad ) {
+bool idImage::IsPrecompressedImageUsable( ID_TIME_T precompTimestamp ) const {
 	if ( !glConfig.isInitialized || !glConfig.textureCompressionAvailable ) {
 		return false;
 	}
@@ -1331,14 +1332,6 @@ bool idImage::CheckPrecompressedImage( bool fullLoad ) {
 		return false;
 	}
 
-	char filename[MAX_IMAGE_NAME];
-	ImageProgramStringToCompressedFileName( imgName, filename );
-
-	// get the file timestamp
-	ID_TIME_T precompTimestamp;
-	fileSystem->ReadFile( filename, NULL, &precompTimestamp );
-
-
 	if ( precompTimestamp == FILE_NOT_FOUND_TIMESTAMP ) {
 		return false;
 	}
@@ -1350,6 +1343,28 @@ bool idImage::CheckPrecompressedImage( bool fullLoad ) {
 		}
 	}
 
+	return true;
+}
+
+/*
+================
+CheckPrecompressedImage
+
+If fullLoad is false, only the small mip levels of the image will be loaded
+================
+*/
+bool idImage::CheckPrecompressedImage( bool fullLoad ) {
+	char filename[MAX_IMAGE_NAME];
+	ImageProgramStringToCompressedFileName( imgName, filename );
+
+	// get the file timestamp
+	ID_TIME_T precompTimestamp;
+	fileSystem->ReadFile( filename, NULL, &precompTimestamp );
+
+	if ( !IsPrecompressedImageUsable( precompTimestamp ) ) {
+		return false;
+	}
+
 	timestamp = precompTimestamp;
 
 	// open it and just read the header
@@ -1366,39 +1381,53 @@ bool idImage::CheckPrecompressedImage( bool fullLoad ) {
 		return false;
 	}
 
-	if ( !fullLoad && len > globalImages->image_cacheMinK.GetInteger() * 1024 ) {
-		len = globalImages->image_cacheMinK.GetInteger() * 1024;
-	}
+	byte *data;
 
-	byte *data = (byte *)R_StaticAlloc( len );
+	if ( fullLoad ) {
+		// read through the file system so files read ahead during level loads are picked up
+		fileSystem->CloseFile( f );
+		len = fileSystem->ReadFile( filename, (void **)&data );
+		if ( len < (int)sizeof( ddsFileHeader_t ) ) {
+			if ( data ) {
+				fileSystem->FreeFile( data );
+			}
+			return false;
+		}
+	} else {
+		if ( len > globalImages->image_cacheMinK.GetInteger() * 1024 ) {
+			len = globalImages->image_cacheMinK.GetInteger() * 1024;
+		}
 
-	f->Read( data, len );
+		data = (byte *)R_StaticAlloc( len );
 
-	fileSystem->CloseFile( f );
+		f->Read( data, len );
+
+		fileSystem->CloseFile( f );
+	}
 
 	unsigned long magic = LittleLong( *(unsigned long *)data );
 	ddsFileHeader_t	*_header = (ddsFileHeader_t *)(data + 4);
 	int ddspf_dwFlags = LittleLong( _header->ddspf.dwFlags );
 
+	bool uploaded = false;
 	if ( magic != DDS_MAKEFOURCC('D', 'D', 'S', ' ')) {
 		common->Printf( "CheckPrecompressedImage( %s ): magic != 'DDS '\n", imgName.c_str() );
-		R_StaticFree( data );
-		return false;
+	} else if ( ddspf_dwFlags & DDSF_ID_INDEXCOLOR ) {
+		// if we don't support color index textures, we must load the full image
+		// should we just expand the 256 color image to 32 bit for upload?
+	} else {
+		// upload all the levels
+		UploadPrecompressedImage( data, len );
+		uploaded = true;
 	}
 
-	// if we don't support color index textures, we must load the full image
-	// should we just expand the 256 color image to 32 bit for upload?
-	if ( ddspf_dwFlags & DDSF_ID_INDEXCOLOR ) {
+	if ( fullLoad ) {
+		fileSystem->FreeFile( data );
+	} else {
 		R_StaticFree( data );
-		return false;
 	}
 
-	// upload all the levels
-	UploadPrecompressedImage( data, len );
-
-	R_StaticFree( data );
-
-	return true;
+	return uploaded;
 }
 
 /*
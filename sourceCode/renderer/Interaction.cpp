@@ -289,7 +289,6 @@ static srfTriangles_t *R_CreateLightTris( const idRenderEntityLocal *ent,
 	bool		includeBackFaces;
 	int			faceNum;
 
-	tr.pc.c_createLightTris++;
 	c_backfaced = 0;
 	c_distance = 0;
 
@@ -451,6 +450,7 @@ idInteraction::idInteraction( void ) {
 	entityNext				= NULL;
 	entityPrev				= NULL;
 	dynamicModelFrameCount	= 0;
+	shadowType				= 0;
 	frustumState			= FRUSTUM_UNINITIALIZED;
 	frustumAreas			= NULL;
 }
@@ -471,6 +471,7 @@ idInteraction *idInteraction::AllocAndLink( idRenderEntityLocal *edef, idRenderL
 
 	// link and initialize
 	interaction->dynamicModelFrameCount = 0;
+	interaction->shadowType = 0;
 
 	interaction->lightDef = ldef;
 	interaction->entityDef = edef;
@@ -536,7 +537,10 @@ void idInteraction::FreeSurfaces( void ) {
 				// if it doesn't have an entityDef, it is part of a prelight
 				// model, not a generated interaction
 				if ( this->entityDef ) {
-					R_FreeStaticTriSurf( sint->shadowTris );
+					// keep the shadows of static models for the next time the pair interacts
+					if ( !R_CacheShadowVolume( this->entityDef, sint->ambientTris, sint->shader, this->lightDef, this->shadowType, sint->shadowTris ) ) {
+						R_FreeStaticTriSurf( sint->shadowTris );
+					}
 					sint->shadowTris = NULL;
 				}
 			}
@@ -810,6 +814,21 @@ bool idInteraction::CullInteractionByViewFrustum( const idFrustum &viewFrustum )
 	return false;
 }
 
+/*
+====================
+R_AddInteractionCounts
+
+Adds the counts of CreateInteractionSurfaces to the performance counters,
+after the job threads are done with them.
+====================
+*/
+static void R_AddInteractionCounts( const interactionCounts_t &counts ) {
+	tr.pc.c_createLightTris += counts.createLightTris;
+	tr.pc.c_createShadowVolumes += counts.createShadowVolumes;
+	c_turboUsedVerts += counts.turboUsedVerts;
+	c_turboUnusedVerts += counts.turboUnusedVerts;
+}
+
 /*
 ====================
 idInteraction::CreateInteraction
@@ -825,9 +844,32 @@ The results of this are cached and valid until the light or entity change.
 ====================
 */
 void idInteraction::CreateInteraction( const idRenderModel *model ) {
+	bool staticShadows;
+	interactionCounts_t counts = { 0, 0, 0, 0 };
+
+	if ( !PrepareInteraction( model, staticShadows ) ) {
+		return;
+	}
+
+	// if none of the surfaces generated anything, don't even bother checking?
+	if ( !CreateInteractionSurfaces( model, staticShadows, counts ) ) {
+		MakeEmpty();
+	}
+	R_AddInteractionCounts( counts );
+}
+
+/*
+====================
+idInteraction::PrepareInteraction
+
+The part of CreateInteraction that has to run on the main thread. Culls the model against
+the light, allocates the surface slots and derives the face planes that the light and shadow
+triangles need. Returns false if the interaction was made empty.
+====================
+*/
+bool idInteraction::PrepareInteraction( const idRenderModel *model, bool &staticShadows ) {
 	const idMaterial *	lightShader = lightDef->lightShader;
 	const idMaterial*	shader;
-	bool				interactionGenerated;
 	idBounds			bounds;
 
 	tr.pc.c_createInteractions++;
@@ -837,18 +879,16 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	// if it doesn't contact the light frustum, none of the surfaces will
 	if ( R_CullLocalBox( bounds, entityDef->modelMatrix, 6, lightDef->frustum ) ) {
 		MakeEmpty();
-		return;
+		return false;
 	}
 
-	// use the turbo shadow path
-	shadowGen_t shadowGen = SG_DYNAMIC;
-
 	// really large models, like outside terrain meshes, should use
 	// the more exactly culled static shadow path instead of the turbo shadow path.
 	// FIXME: this is a HACK, we should probably have a material flag.
-	if ( bounds[1][0] - bounds[0][0] > 3000 ) {
-		shadowGen = SG_STATIC;
-	}
+	staticShadows = ( bounds[1][0] - bounds[0][0] > 3000 );
+
+	// the cached shadow volumes must have been created the same way
+	shadowType = R_ShadowVolumeType( staticShadows ? SG_STATIC : SG_DYNAMIC );
 
 	//
 	// create slots for each of the model's surfaces
@@ -856,8 +896,6 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	numSurfaces = model->NumSurfaces();
 	surfaces = (surfaceInteraction_t *)R_ClearedStaticAlloc( sizeof( *surfaces ) * numSurfaces );
 
-	interactionGenerated = false;
-
 	// check each surface in the model
 	for ( int c = 0 ; c < model->NumSurfaces() ; c++ ) {
 		const modelSurface_t	*surf;
@@ -897,10 +935,58 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 			continue;
 		}
 
+		// the ambient surface is shared by all interactions of the entity, so the face planes
+		// have to exist before the surfaces of several interactions are created at the same time
+		if ( !tri->facePlanes || !tri->facePlanesCalculated ) {
+			R_DeriveFacePlanes( tri );
+		}
+
+		// the shadow may still be around from an interaction of the same pair that was freed
+		if ( SurfaceCastsShadow( model, shader, tri ) ) {
+			sint->shadowTris = R_FindCachedShadowVolume( entityDef, tri, shader, lightDef, shadowType );
+		}
+	}
+
+	return true;
+}
+
+/*
+====================
+idInteraction::CreateInteractionSurfaces
+
+Creates the light and shadow triangles for the surface slots set up by PrepareInteraction and
+returns true if any surface generated something. Only touches the interaction itself, so it can
+run on a job thread as long as the dynamic shadow path is used, see CanCreateInParallel.
+====================
+*/
+bool idInteraction::CreateInteractionSurfaces( const idRenderModel *model, bool staticShadows, interactionCounts_t &counts ) {
+	const idMaterial *	lightShader = lightDef->lightShader;
+	bool				interactionGenerated;
+
+	// use the turbo shadow path
+	shadowGen_t shadowGen = staticShadows ? SG_STATIC : SG_DYNAMIC;
+
+	interactionGenerated = false;
+
+	for ( int c = 0 ; c < numSurfaces ; c++ ) {
+		surfaceInteraction_t *sint = &surfaces[c];
+		srfTriangles_t *tri = sint->ambientTris;
+		const idMaterial *shader = sint->shader;
+
+		if ( !tri || !shader ) {
+			continue;
+		}
+
+		// "invisible ink" lights and shaders
+		if ( shader->Spectrum() != lightShader->Spectrum() ) {
+			continue;
+		}
+
 		// generate a lighted surface and add it
 		if ( shader->ReceivesLighting() ) {
 			if ( tri->ambientViewCount == tr.viewCount ) {
 				sint->lightTris = R_CreateLightTris( entityDef, tri, lightDef, shader, sint->cullInfo );
+				counts.createLightTris++;
 			} else {
 				// this will be calculated when sint->ambientTris is actually in view
 				sint->lightTris = LIGHT_TRIS_DEFERRED;
@@ -909,24 +995,24 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 		}
 
 		// if the interaction has shadows and this surface casts a shadow
-		if ( HasShadows() && shader->SurfaceCastsShadow() && tri->silEdges != NULL ) {
-
-			// if the light has an optimized shadow volume, don't create shadows for any models that are part of the base areas
-			if ( lightDef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || !r_useOptimizedShadows.GetBool() ) {
-
-				// this is the only place during gameplay (outside the utilities) that R_CreateShadowVolume() is called
-				sint->shadowTris = R_CreateShadowVolume( entityDef, tri, lightDef, shadowGen, sint->cullInfo );
-				if ( sint->shadowTris ) {
-					if ( shader->Coverage() != MC_OPAQUE || ( !r_skipSuppress.GetBool() && entityDef->parms.suppressSurfaceInViewID ) ) {
-						// if any surface is a shadow-casting perforated or translucent surface, or the
-						// base surface is suppressed in the view (world weapon shadows) we can't use
-						// the external shadow optimizations because we can see through some of the faces
-						sint->shadowTris->numShadowIndexesNoCaps = sint->shadowTris->numIndexes;
-						sint->shadowTris->numShadowIndexesNoFrontCaps = sint->shadowTris->numIndexes;
-					}
+		if ( sint->shadowTris ) {
+			// taken from the shadow cache by PrepareInteraction
+			interactionGenerated = true;
+		} else if ( SurfaceCastsShadow( model, shader, tri ) ) {
+
+			// this is the only place during gameplay (outside the utilities) that R_CreateShadowVolume() is called
+			sint->shadowTris = R_CreateShadowVolume( entityDef, tri, lightDef, shadowGen, sint->cullInfo, &counts );
+			counts.createShadowVolumes++;
+			if ( sint->shadowTris ) {
+				if ( shader->Coverage() != MC_OPAQUE || ( !r_skipSuppress.GetBool() && entityDef->parms.suppressSurfaceInViewID ) ) {
+					// if any surface is a shadow-casting perforated or translucent surface, or the
+					// base surface is suppressed in the view (world weapon shadows) we can't use
+					// the external shadow optimizations because we can see through some of the faces
+					sint->shadowTris->numShadowIndexesNoCaps = sint->shadowTris->numIndexes;
+					sint->shadowTris->numShadowIndexesNoFrontCaps = sint->shadowTris->numIndexes;
 				}
-				interactionGenerated = true;
 			}
+			interactionGenerated = true;
 		}
 
 		// free the cull information when it's no longer needed
@@ -935,10 +1021,171 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 		}
 	}
 
-	// if none of the surfaces generated anything, don't even bother checking?
-	if ( !interactionGenerated ) {
-		MakeEmpty();
+	return interactionGenerated;
+}
+
+/*
+====================
+idInteraction::SurfaceCastsShadow
+
+Returns true if a shadow volume is built for the surface of the interaction.
+====================
+*/
+bool idInteraction::SurfaceCastsShadow( const idRenderModel *model, const idMaterial *shader, const srfTriangles_t *tri ) const {
+	if ( !HasShadows() || !shader->SurfaceCastsShadow() || tri->silEdges == NULL ) {
+		return false;
+	}
+	// if the light has an optimized shadow volume, don't create shadows for any models that are part of the base areas
+	return ( lightDef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || !r_useOptimizedShadows.GetBool() );
+}
+
+/*
+====================
+idInteraction::CanCreateInParallel
+
+The static shadow volume path keeps its work buffers in globals, only the turbo path can run on several threads.
+====================
+*/
+bool idInteraction::CanCreateInParallel( bool staticShadows ) const {
+	if ( !HasShadows() || !r_shadows.GetBool() ) {
+		return true;
 	}
+	return !staticShadows && r_useTurboShadow.GetBool();
+}
+
+/*
+===============================================================================
+
+	Parallel interaction creation
+
+	While R_AddModelSurfaces walks the view entities, the interactions that still have
+	to be created are prepared on the main thread and queued instead of being created
+	right away. R_CreateQueuedInteractions builds their light and shadow triangles on the
+	job threads and R_AddModelSurfaces adds the interactions to the view afterwards.
+
+===============================================================================
+*/
+
+typedef struct {
+	idInteraction *			inter;
+	const idRenderModel *	model;
+	bool					staticShadows;
+	bool					generated;
+	interactionCounts_t		counts;
+} interactionJob_t;
+
+static idList<interactionJob_t>	interactionJobs;
+static bool						queueInteractions = false;
+
+/*
+====================
+idInteraction::CreateInteractionJob
+====================
+*/
+void idInteraction::CreateInteractionJob( void *data ) {
+	interactionJob_t *job = static_cast<interactionJob_t *>( data );
+	job->generated = job->inter->CreateInteractionSurfaces( job->model, job->staticShadows, job->counts );
+}
+
+/*
+====================
+idInteraction::QueueCreateInteraction
+
+Prepares the interaction and queues the creation of its surfaces if interactions are being
+collected for the job threads. Returns true if it was queued or turned out to be empty.
+Interactions that can't be created on the job threads are created right away.
+====================
+*/
+bool idInteraction::QueueCreateInteraction( const idRenderModel *model ) {
+	bool staticShadows;
+
+	if ( !queueInteractions ) {
+		return false;
+	}
+
+	if ( !PrepareInteraction( model, staticShadows ) ) {
+		// empty, nothing left to do
+		return true;
+	}
+
+	if ( !CanCreateInParallel( staticShadows ) ) {
+		interactionCounts_t counts = { 0, 0, 0, 0 };
+		if ( !CreateInteractionSurfaces( model, staticShadows, counts ) ) {
+			MakeEmpty();
+		}
+		R_AddInteractionCounts( counts );
+		return false;
+	}
+
+	interactionJob_t &job = interactionJobs.Alloc();
+	job.inter = this;
+	job.model = model;
+	job.staticShadows = staticShadows;
+	job.generated = false;
+	memset( &job.counts, 0, sizeof( job.counts ) );
+	return true;
+}
+
+/*
+====================
+R_QueueInteractions
+
+Starts collecting the interactions that have to be created in this view.
+====================
+*/
+void R_QueueInteractions( void ) {
+	interactionJobs.SetGranularity( 256 );
+	interactionJobs.SetNum( 0, false );
+	queueInteractions = r_useParallelInteractions.GetBool() && parallelJobManager->GetNumThreads() > 0;
+}
+
+/*
+====================
+R_CreateQueuedInteractions
+
+Creates the surfaces of all queued interactions and stops collecting them.
+Returns the number of queued interactions, which R_QueuedInteraction returns.
+====================
+*/
+int R_CreateQueuedInteractions( void ) {
+	queueInteractions = false;
+
+	if ( interactionJobs.Num() == 0 ) {
+		return 0;
+	}
+
+	if ( interactionJobs.Num() == 1 ) {
+		idInteraction::CreateInteractionJob( &interactionJobs[0] );
+	} else {
+		idParallelJobList jobList( "interactions" );
+
+		for ( int i = 0; i < interactionJobs.Num(); i++ ) {
+			jobList.AddJob( idInteraction::CreateInteractionJob, &interactionJobs[i] );
+		}
+		jobList.Submit();
+		jobList.Wait();
+	}
+
+	// linking empty interactions to the end of the lists has to be done serially
+	for ( int i = 0; i < interactionJobs.Num(); i++ ) {
+		if ( !interactionJobs[i].generated ) {
+			interactionJobs[i].inter->MakeEmpty();
+		}
+		R_AddInteractionCounts( interactionJobs[i].counts );
+	}
+
+	tr.pc.c_parallelInteractions += interactionJobs.Num();
+
+	return interactionJobs.Num();
+}
+
+/*
+====================
+R_QueuedInteraction
+====================
+*/
+idInteraction *R_QueuedInteraction( int index ) {
+	return interactionJobs[index].inter;
 }
 
 /*
@@ -1080,7 +1327,11 @@ void idInteraction::AddActiveInteraction( void ) {
 	}
 	dynamicModelFrameCount = entityDef->dynamicModelFrameCount;
 
-	// actually create the interaction if needed, building light and shadow surfaces as needed
+	// actually create the interaction if needed, building light and shadow surfaces as needed,
+	// R_AddModelSurfaces adds queued interactions again once their surfaces are created
+	if ( IsDeferred() && QueueCreateInteraction( model ) ) {
+		return;
+	}
 	if ( IsDeferred() ) {
 		CreateInteraction( model );
 	}
@@ -1106,6 +1357,7 @@ void idInteraction::AddActiveInteraction( void ) {
 			// on a previous use that only needed the shadow
 			if ( sint->lightTris == LIGHT_TRIS_DEFERRED ) {
 				sint->lightTris = R_CreateLightTris( vEntity->entityDef, sint->ambientTris, vLight->lightDef, sint->shader, sint->cullInfo );
+				tr.pc.c_createLightTris++;
 				R_FreeInteractionCullInfo( sint->cullInfo );
 			}
 
@@ -1309,4 +1561,8 @@ void R_ShowInteractionMemory_f( const idCmdArgs &args ) {
 	common->Printf( "%i deferred interactions, %i empty interactions\n", deferredInteractions, emptyInteractions );
 	common->Printf( "%5i indexes %5i verts in %5i light tris\n", lightTriIndexes, lightTriVerts, lightTris );
 	common->Printf( "%5i indexes %5i verts in %5i shadow tris\n", shadowTriIndexes, shadowTriVerts, shadowTris );
+
+	int cachedVolumes;
+	int cacheMemory = R_ShadowCacheMemory( &cachedVolumes );
+	common->Printf( "%5i shadow volumes totalling %ik in the shadow cache\n", cachedVolumes, cacheMemory / 1024 );
 }
@@ -72,6 +72,16 @@ typedef struct {
 } surfaceInteraction_t;
 
 
+// surfaces created by CreateInteractionSurfaces, which may run on a job thread,
+// so they are added to the performance counters by the caller
+typedef struct {
+	int						createLightTris;
+	int						createShadowVolumes;
+	int						turboUsedVerts;
+	int						turboUnusedVerts;
+} interactionCounts_t;
+
+
 typedef struct areaNumRef_s {
 	struct areaNumRef_s *	next;
 	int						areaNum;
@@ -137,6 +147,9 @@ public:
 	// calls R_LinkLightSurf() for each one
 	void					AddActiveInteraction( void );
 
+	// creates the surfaces of an interaction queued by R_QueueInteractions on a job thread
+	static void				CreateInteractionJob( void *data );
+
 private:
 	enum {
 		FRUSTUM_UNINITIALIZED,
@@ -149,10 +162,27 @@ private:
 
 	int						dynamicModelFrameCount;	// so we can tell if a callback model animated
 
+	int						shadowType;				// R_ShadowVolumeType of the shadow volumes, for the shadow cache
+
 private:
 	// actually create the interaction
 	void					CreateInteraction( const idRenderModel *model );
 
+	// the main thread part of CreateInteraction, returns false if the interaction became empty
+	bool					PrepareInteraction( const idRenderModel *model, bool &staticShadows );
+
+	// creates the light and shadow surfaces, returns false if none were generated
+	bool					CreateInteractionSurfaces( const idRenderModel *model, bool staticShadows, interactionCounts_t &counts );
+
+	// returns true if a shadow volume has to be created for the surface
+	bool					SurfaceCastsShadow( const idRenderModel *model, const idMaterial *shader, const srfTriangles_t *tri ) const;
+
+	// returns true if CreateInteractionSurfaces may run on a job thread
+	bool					CanCreateInParallel( bool staticShadows ) const;
+
+	// queues the interaction if R_QueueInteractions is collecting them
+	bool					QueueCreateInteraction( const idRenderModel *model );
+
 	// unlink from entity and light lists
 	void					Unlink( void );
 
@@ -172,4 +202,10 @@ void R_FreeInteractionCullInfo( srfCullInfo_t &cullInfo );
 
 void R_ShowInteractionMemory_f( const idCmdArgs &args );
 
+// interactions created while adding the model surfaces of a view are
+// queued and created on the job threads, see R_AddModelSurfaces
+void R_QueueInteractions( void );
+int R_CreateQueuedInteractions( void );
+idInteraction *R_QueuedInteraction( int index );
+
 #endif /* !__INTERACTION_H__ */
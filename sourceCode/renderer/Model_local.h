@@ -134,7 +134,10 @@ public:
 								~idMD5Mesh();
 
  	void						ParseMesh( idLexer &parser, int numJoints, const idJointMat *joints );
-	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf );
+	void						UpdateSurface( const struct renderEntity_s *ent, const idJointMat *joints, modelSurface_t *surf, bool receivesLighting );
+								// transforms the vertexes of a surface set up by UpdateSurface, may run on a job thread
+								// returns the number of indexes the tangents were derived for
+	int							SkinSurface( srfTriangles_t *tri, const idJointMat *joints, float skinScale, bool deriveTangents );
 	idBounds					CalcBounds( const idJointMat *joints );
 	int							NearestJoint( int a, int b, int c ) const;
 	int							NumVerts( void ) const;
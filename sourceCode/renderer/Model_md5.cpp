@@ -260,13 +260,111 @@ void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJo
 	SIMDProcessor->TransformVerts( verts, texCoords.Num(), entJoints, scaledWeights, weightIndex, numWeights );
 }
 
+/*
+===============================================================================
+
+	Batched skinning
+
+	While R_AddModelSurfaces instantiates the dynamic models of the visible entities,
+	UpdateSurface only sets up the MD5 surfaces and queues the vertex transforms,
+	which R_FinishMD5Skinning runs on the job threads. The surfaces of lit materials
+	also get their tangents there, which would otherwise be derived on the main
+	thread when their ambient cache is created.
+
+===============================================================================
+*/
+
+typedef struct {
+	idMD5Mesh *				mesh;
+	srfTriangles_t *		tri;
+	const idJointMat *		joints;
+	float					skinScale;
+	bool					deriveTangents;
+	int						tangentIndexes;		// added to tr.pc after the jobs are done
+} md5SkinJob_t;
+
+static idList<md5SkinJob_t>				md5SkinJobs;
+static idList<idRenderModelStatic *>	md5SkinnedModels;	// their bounds are calculated after skinning
+static bool								queueMD5Skinning = false;
+
+/*
+====================
+R_SkinMD5Job
+====================
+*/
+static void R_SkinMD5Job( void *data ) {
+	md5SkinJob_t *job = static_cast<md5SkinJob_t *>( data );
+	job->tangentIndexes = job->mesh->SkinSurface( job->tri, job->joints, job->skinScale, job->deriveTangents );
+}
+
+/*
+====================
+R_BeginMD5Skinning
+
+Starts queueing the vertex transforms of the MD5 models that are instantiated until R_FinishMD5Skinning.
+====================
+*/
+void R_BeginMD5Skinning( void ) {
+	md5SkinJobs.SetGranularity( 256 );
+	md5SkinJobs.SetNum( 0, false );
+	md5SkinnedModels.SetGranularity( 64 );
+	md5SkinnedModels.SetNum( 0, false );
+	queueMD5Skinning = true;
+}
+
+/*
+====================
+R_FinishMD5Skinning
+
+Skins all queued surfaces on the job threads and updates the bounds of their models.
+====================
+*/
+void R_FinishMD5Skinning( void ) {
+	queueMD5Skinning = false;
+
+	if ( md5SkinJobs.Num() == 1 ) {
+		R_SkinMD5Job( &md5SkinJobs[0] );
+	} else if ( md5SkinJobs.Num() > 1 ) {
+		idParallelJobList jobList( "md5Skinning" );
+
+		for ( int i = 0; i < md5SkinJobs.Num(); i++ ) {
+			jobList.AddJob( R_SkinMD5Job, &md5SkinJobs[i] );
+		}
+		jobList.Submit();
+		jobList.Wait();
+	}
+
+	for ( int i = 0; i < md5SkinJobs.Num(); i++ ) {
+		tr.pc.c_tangentIndexes += md5SkinJobs[i].tangentIndexes;
+	}
+
+	for ( int i = 0; i < md5SkinnedModels.Num(); i++ ) {
+		idRenderModelStatic *staticModel = md5SkinnedModels[i];
+
+		staticModel->bounds.Clear();
+		for ( int j = 0; j < staticModel->NumSurfaces(); j++ ) {
+			const srfTriangles_t *tri = staticModel->Surface( j )->geometry;
+			if ( tri ) {
+				staticModel->bounds.AddPoint( tri->bounds[0] );
+				staticModel->bounds.AddPoint( tri->bounds[1] );
+			}
+		}
+	}
+
+	md5SkinJobs.SetNum( 0, false );
+	md5SkinnedModels.SetNum( 0, false );
+}
+
 /*
 ====================
 idMD5Mesh::UpdateSurface
+
+Sets up the surface for the current joints, the vertexes are transformed right away
+unless R_BeginMD5Skinning queues them.
 ====================
 */
-void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) {
-	int i, base;
+void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf, bool receivesLighting ) {
+	int i;
 	srfTriangles_t *tri;
 
 	tr.pc.c_deformedSurfaces++;
@@ -315,8 +413,34 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 		}
 	}
 
-	if ( ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] != 0.0f ) {
-		TransformScaledVerts( tri->verts, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
+	if ( queueMD5Skinning ) {
+		md5SkinJob_t &job = md5SkinJobs.Alloc();
+		job.mesh = this;
+		job.tri = tri;
+		job.joints = entJoints;
+		job.skinScale = ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ];
+		job.deriveTangents = receivesLighting;
+		job.tangentIndexes = 0;
+		return;
+	}
+
+	tr.pc.c_tangentIndexes += SkinSurface( tri, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ], false );
+}
+
+/*
+====================
+idMD5Mesh::SkinSurface
+
+Only touches the given surface, so it can run on a job thread. Returns the number
+of indexes the tangents were derived for, which the caller adds to tr.pc.
+====================
+*/
+int idMD5Mesh::SkinSurface( srfTriangles_t *tri, const idJointMat *entJoints, float skinScale, bool deriveTangents ) {
+	int i, base;
+	int tangentIndexes = 0;
+
+	if ( skinScale != 0.0f ) {
+		TransformScaledVerts( tri->verts, entJoints, skinScale );
 	} else {
 		TransformVerts( tri->verts, entJoints );
 	}
@@ -333,10 +457,12 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
 	// needs shadows generated, it will only have to generate face planes.  If it only
 	// has ambient drawing, or is culled, no additional work will be necessary
-	if ( !r_useDeferredTangents.GetBool() ) {
+	if ( !r_useDeferredTangents.GetBool() || deriveTangents ) {
 		// set face planes, vertex normals, tangents
-		R_DeriveTangents( tri );
+		R_DeriveTangents( tri, true, &tangentIndexes );
 	}
+
+	return tangentIndexes;
 }
 
 /*
@@ -794,10 +920,16 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
-		mesh->UpdateSurface( ent, ent->joints, surf );
+		mesh->UpdateSurface( ent, ent->joints, surf, shader->ReceivesLighting() );
 
-		staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
-		staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
+		if ( !queueMD5Skinning ) {
+			staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
+			staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
+		}
+	}
+
+	if ( queueMD5Skinning ) {
+		md5SkinnedModels.Append( staticModel );
 	}
 
 	return staticModel;
@@ -953,3 +1085,94 @@ int	idRenderModelMD5::Memory() const {
 	}
 	return total;
 }
+
+/*
+===================
+R_BenchSkinning_f
+
+Instantiates copies of an MD5 model in its default pose, once surface by surface
+on the main thread and once through the batched skinning jobs.
+===================
+*/
+void R_BenchSkinning_f( const idCmdArgs &args ) {
+	int numInstances, numFrames;
+	idTimer serialTimer, batchedTimer;
+
+	if ( args.Argc() < 2 || args.Argc() > 4 ) {
+		common->Printf( "Usage: benchSkinning <model.md5mesh> [numInstances] [numFrames]\n" );
+		return;
+	}
+	numInstances = ( args.Argc() > 2 ) ? idMath::ClampInt( 1, 4096, atoi( args.Argv( 2 ) ) ) : 64;
+	numFrames = ( args.Argc() > 3 ) ? idMath::ClampInt( 1, 10000, atoi( args.Argv( 3 ) ) ) : 100;
+
+	idRenderModelMD5 *model = dynamic_cast<idRenderModelMD5 *>( renderModelManager->FindModel( args.Argv( 1 ) ) );
+	if ( model == NULL || model->IsDefaultModel() || model->NumJoints() == 0 ) {
+		common->Printf( "%s is not an MD5 mesh\n", args.Argv( 1 ) );
+		return;
+	}
+
+	// build the default pose in model space
+	const int numJoints = model->NumJoints();
+	const idMD5Joint *md5Joints = model->GetJoints();
+	idJointMat *joints = (idJointMat *)Mem_Alloc16( numJoints * sizeof( joints[0] ) );
+
+	SIMDProcessor->ConvertJointQuatsToJointMats( joints, model->GetDefaultPose(), numJoints );
+	for ( int i = 0; i < numJoints; i++ ) {
+		if ( md5Joints[i].parent ) {
+			joints[i] *= joints[ md5Joints[i].parent - md5Joints ];
+		}
+	}
+
+	renderEntity_t ent;
+	memset( &ent, 0, sizeof( ent ) );
+	ent.hModel = model;
+	ent.numJoints = numJoints;
+	ent.joints = joints;
+	ent.axis.Identity();
+
+	idList<idRenderModel *> instances;
+	instances.SetNum( numInstances );
+	for ( int i = 0; i < numInstances; i++ ) {
+		instances[i] = NULL;
+	}
+
+	// the serial path leaves the tangents to the ambient cache, derive them here the way it would
+	serialTimer.Start();
+	for ( int frame = 0; frame < numFrames; frame++ ) {
+		for ( int i = 0; i < numInstances; i++ ) {
+			instances[i] = model->InstantiateDynamicModel( &ent, NULL, instances[i] );
+			for ( int j = 0; j < instances[i]->NumSurfaces(); j++ ) {
+				const modelSurface_t *surf = instances[i]->Surface( j );
+				if ( surf->shader->ReceivesLighting() && !surf->geometry->tangentsCalculated ) {
+					R_DeriveTangents( surf->geometry );
+				}
+			}
+		}
+	}
+	serialTimer.Stop();
+
+	batchedTimer.Start();
+	for ( int frame = 0; frame < numFrames; frame++ ) {
+		R_BeginMD5Skinning();
+		for ( int i = 0; i < numInstances; i++ ) {
+			instances[i] = model->InstantiateDynamicModel( &ent, NULL, instances[i] );
+		}
+		R_FinishMD5Skinning();
+	}
+	batchedTimer.Stop();
+
+	const double serialMs = serialTimer.Milliseconds() / numFrames;
+	const double batchedMs = batchedTimer.Milliseconds() / numFrames;
+
+	int numVerts = 0;
+	for ( int j = 0; j < instances[0]->NumSurfaces(); j++ ) {
+		numVerts += instances[0]->Surface( j )->geometry->numVerts;
+	}
+
+	common->Printf( "%s: %d instances of %d verts, %d frames, %d job threads\n", model->Name(), numInstances, numVerts, numFrames, parallelJobManager->GetNumThreads() );
+	common->Printf( "serial:  %8.3f ms/frame\n", serialMs );
+	common->Printf( "batched: %8.3f ms/frame (%.2fx)\n", batchedMs, ( batchedMs > 0.0 ) ? serialMs / batchedMs : 0.0 );
+
+	instances.DeleteContents( true );
+	Mem_Free16( joints );
+}
@@ -35,6 +35,12 @@ idRenderEntityLocal::idRenderEntityLocal() {
 	dynamicModel			= NULL;
 	dynamicModelFrameCount	= 0;
 	cachedDynamicModel		= NULL;
+	cachedModelSource		= NULL;
+	cachedModelSkin			= NULL;
+	cachedModelShader		= NULL;
+	cachedModelSkinScale	= 0.0f;
+	cachedModelNumJoints	= 0;
+	cachedModelJoints		= NULL;
 	referenceBounds			= bounds_zero;
 	viewCount				= 0;
 	viewEntity				= NULL;
@@ -65,9 +65,10 @@ static void R_PerformanceCounters( void ) {
 	}
 
 	if ( r_showDynamic.GetBool() ) {
-		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
+		common->Printf( "callback:%i md5:%i reused:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
 			tr.pc.c_entityDefCallbacks,
 			tr.pc.c_generateMd5,
+			tr.pc.c_reusedDynamicModels,
 			tr.pc.c_deformedVerts,
 			tr.pc.c_deformedIndexes/3,
 			tr.pc.c_tangentIndexes/3,
@@ -76,18 +77,23 @@ static void R_PerformanceCounters( void ) {
 	}
 
 	if ( r_showCull.GetBool() ) {
-		common->Printf( "%i sin %i sclip  %i sout %i bin %i bout\n",
+		common->Printf( "%i sin %i sclip  %i sout %i bin %i bout %i aout\n",
 			tr.pc.c_sphere_cull_in, tr.pc.c_sphere_cull_clip, tr.pc.c_sphere_cull_out, 
-			tr.pc.c_box_cull_in, tr.pc.c_box_cull_out );
+			tr.pc.c_box_cull_in, tr.pc.c_box_cull_out, tr.pc.c_area_cull_out );
 	}
 	
+	if ( r_showSoftOcclusion.GetBool() ) {
+		common->Printf( "occluderTris:%i occludedEntities:%i occludedLights:%i\n",
+			tr.pc.c_occluderTris, tr.pc.c_occludedEntities, tr.pc.c_occludedLights );
+	}
+
 	if ( r_showAlloc.GetBool() ) {
 		common->Printf( "alloc:%i free:%i\n", tr.pc.c_alloc, tr.pc.c_free );
 	}
 
 	if ( r_showInteractions.GetBool() ) {
-		common->Printf( "createInteractions:%i createLightTris:%i createShadowVolumes:%i\n",
-			tr.pc.c_createInteractions, tr.pc.c_createLightTris, tr.pc.c_createShadowVolumes );
+		common->Printf( "createInteractions:%i (parallel:%i) createLightTris:%i createShadowVolumes:%i (cached:%i)\n",
+			tr.pc.c_createInteractions, tr.pc.c_parallelInteractions, tr.pc.c_createLightTris, tr.pc.c_createShadowVolumes, tr.pc.c_cachedShadowVolumes );
  	}
 	if ( r_showDefs.GetBool() ) {
 		common->Printf( "viewEntities:%i  shadowEntities:%i  viewLights:%i\n", tr.pc.c_visibleViewEntities,
@@ -100,7 +106,13 @@ static void R_PerformanceCounters( void ) {
 	}
 	if ( r_showMemory.GetBool() ) {
 		int	m1 = frameData ? frameData->memoryHighwater : 0;
-		common->Printf( "frameData: %i (%i)\n", R_CountFrameData(), m1 );
+		int numArenas = 0;
+		for ( int i = 0; frameData && i < MAX_FRAME_ARENAS; i++ ) {
+			if ( frameData->arenas[i].memory ) {
+				numArenas++;
+			}
+		}
+		common->Printf( "frameData: %i (%i) in %i arenas\n", R_CountFrameData(), m1, numArenas );
 	}
 	if ( r_showLightScale.GetBool() ) {
 		common->Printf( "lightScale: %f\n", backEnd.pc.maxLightValue );
@@ -135,6 +147,9 @@ static void R_IssueRenderCommands( void ) {
 	// r_skipRender is usually more usefull, because it will still
 	// draw 2D graphics
 	if ( !r_skipBackEnd.GetBool() ) {
+		// all the dynamic vertexes of the front end go to the GPU at once
+		vertexCache.UploadFrameTemp();
+
 		RB_ExecuteBackEndCommands( frameData->cmdHead );
 	}
 
@@ -57,6 +57,9 @@ idCVar r_useShadowVertexProgram( "r_useShadowVertexProgram", "1", CVAR_RENDERER
 idCVar r_useShadowSurfaceScissor( "r_useShadowSurfaceScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor shadows by the scissor rect of the interaction surfaces" );
 idCVar r_useInteractionTable( "r_useInteractionTable", "1", CVAR_RENDERER | CVAR_BOOL, "create a full entityDefs * lightDefs table to make finding interactions faster" );
 idCVar r_useTurboShadow( "r_useTurboShadow", "1", CVAR_RENDERER | CVAR_BOOL, "use the infinite projection with W technique for dynamic shadows" );
+idCVar r_useParallelInteractions( "r_useParallelInteractions", "1", CVAR_RENDERER | CVAR_BOOL, "create the light and shadow triangles of new interactions on the job threads" );
+idCVar r_useParallelSkinning( "r_useParallelSkinning", "1", CVAR_RENDERER | CVAR_BOOL, "skin the MD5 meshes of the visible entities on the job threads" );
+idCVar r_reuseDynamicModels( "r_reuseDynamicModels", "1", CVAR_RENDERER | CVAR_BOOL, "reuse the snapshot of an animated model in all views that see it in the same pose" );
 idCVar r_useTwoSidedStencil( "r_useTwoSidedStencil", "1", CVAR_RENDERER | CVAR_BOOL, "do stencil shadows in one pass with different ops on each side" );
 idCVar r_useDeferredTangents( "r_useDeferredTangents", "1", CVAR_RENDERER | CVAR_BOOL, "defer tangents calculations after deform" );
 idCVar r_useCachedDynamicModels( "r_useCachedDynamicModels", "1", CVAR_RENDERER | CVAR_BOOL, "cache snapshots of dynamic models" );
@@ -114,6 +117,10 @@ idCVar r_useLightCulling( "r_useLightCulling", "3", CVAR_RENDERER | CVAR_INTEGER
 idCVar r_useLightScissors( "r_useLightScissors", "1", CVAR_RENDERER | CVAR_BOOL, "1 = use custom scissor rectangle for each light" );
 idCVar r_useClippedLightScissors( "r_useClippedLightScissors", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar r_useEntityCulling( "r_useEntityCulling", "1", CVAR_RENDERER | CVAR_BOOL, "0 = none, 1 = box" );
+idCVar r_useAreaCulling( "r_useAreaCulling", "1", CVAR_RENDERER | CVAR_BOOL, "cull the world bounds of the entities and lights of an area in blocks before testing them one by one" );
+idCVar r_useSoftOcclusion( "r_useSoftOcclusion", "0", CVAR_RENDERER | CVAR_BOOL, "rasterize the large opaque surfaces of a view on the CPU and skip the entities and lights hidden behind them" );
+idCVar r_showSoftOcclusion( "r_showSoftOcclusion", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = draw the software occlusion buffer and print its counters, 2 = also draw the bounds of the occluded entities and lights", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar r_softOcclusionMinSize( "r_softOcclusionMinSize", "0.05", CVAR_RENDERER | CVAR_FLOAT, "occluder surfaces with a radius smaller than this fraction of their distance are not rasterized" );
 idCVar r_useEntityScissors( "r_useEntityScissors", "0", CVAR_RENDERER | CVAR_BOOL, "1 = use custom scissor rectangle for each entity" );
 idCVar r_useInteractionCulling( "r_useInteractionCulling", "1", CVAR_RENDERER | CVAR_BOOL, "1 = cull interactions" );
 idCVar r_useInteractionScissors( "r_useInteractionScissors", "2", CVAR_RENDERER | CVAR_INTEGER, "1 = use a custom scissor rectangle for each shadow interaction, 2 = also crop using portal scissors", -2, 2, idCmdSystem::ArgCompletion_Integer<-2,2> );
@@ -141,6 +148,8 @@ idCVar r_flareSize( "r_flareSize", "1", CVAR_RENDERER | CVAR_FLOAT, "scale the f
 
 idCVar r_useExternalShadows( "r_useExternalShadows", "1", CVAR_RENDERER | CVAR_INTEGER, "1 = skip drawing caps when outside the light volume, 2 = force to no caps for testing", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar r_useOptimizedShadows( "r_useOptimizedShadows", "1", CVAR_RENDERER | CVAR_BOOL, "use the dmap generated static shadow volumes" );
+idCVar r_useShadowCache( "r_useShadowCache", "1", CVAR_RENDERER | CVAR_BOOL, "keep the shadow volumes of static models when their interactions are freed and reuse them for the same light" );
+idCVar r_shadowCacheSize( "r_shadowCacheSize", "32", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "megabytes of freed shadow volumes kept in the shadow cache" );
 idCVar r_useScissor( "r_useScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor clip as portals and lights are processed" );
 idCVar r_useCombinerDisplayLists( "r_useCombinerDisplayLists", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "put all nvidia register combiner programming in display lists" );
 idCVar r_useDepthBoundsTest( "r_useDepthBoundsTest", "1", CVAR_RENDERER | CVAR_BOOL, "use depth bounds test to reduce shadow fill" );
@@ -2039,6 +2048,7 @@ void R_InitCommands( void ) {
 	cmdSystem->AddCommand( "listRenderLightDefs", R_ListRenderLightDefs_f, CMD_FL_RENDERER, "lists the light defs" );
 	cmdSystem->AddCommand( "listModes", R_ListModes_f, CMD_FL_RENDERER, "lists all video modes" );
 	cmdSystem->AddCommand( "reloadSurface", R_ReloadSurface_f, CMD_FL_RENDERER, "reloads the decl and images for selected surface" );
+	cmdSystem->AddCommand( "benchSkinning", R_BenchSkinning_f, CMD_FL_RENDERER, "times serial and parallel skinning of an MD5 mesh", idCmdSystem::ArgCompletion_ModelName );
 }
 
 /*
@@ -2171,6 +2181,10 @@ void idRenderSystemLocal::Shutdown( void ) {
 	// free frame memory
 	R_ShutdownFrameData();
 
+	R_ShutdownOcclusionBuffer();
+
+	R_PurgeShadowCache();
+
 	// free the vertex cache, which should have nothing allocated now
 	vertexCache.Shutdown();
 
@@ -218,7 +218,9 @@ void idRenderWorldLocal::UpdateEntityDef( qhandle_t entityHandle, const renderEn
 	idRenderEntityLocal	*def = entityDefs[entityHandle];
 	if ( def ) {
 
-		if ( !re->forceUpdate ) {
+		if ( re->forceUpdate ) {
+			R_InvalidateEntityDefDynamicModel( def );
+		} else {
 
 			// check for exact match (OPTIMIZE: check through pointers more)
 			if ( !re->joints && !re->callbackData && !def->dynamicModel && !memcmp( re, &def->parms, sizeof( *re ) ) ) {
@@ -1412,6 +1414,11 @@ void idRenderWorldLocal::AddEntityRefToArea( idRenderEntityLocal *def, portalAre
 
 		ref->entity = def;
 
+		// world bounds for the area culling
+		idBounds bounds;
+		bounds.FromTransformedBounds( def->referenceBounds, def->parms.origin, def->parms.axis );
+		ref->cullSlot = area->entityCull->AddBounds( bounds );
+
 		// link to entityDef
 		ref->ownerNext = def->entityRefs;
 		def->entityRefs = ref;
@@ -1438,6 +1445,7 @@ void idRenderWorldLocal::AddLightRefToArea( idRenderLightLocal *light, portalAre
 	lref = areaReferenceAllocator.Alloc();
 	lref->light = light;
 	lref->area = area;
+	lref->cullSlot = area->lightCull->AddBounds( light->frustumTris->bounds );
 	lref->ownerNext = light->references;
 	light->references = lref;
 	tr.pc.c_lightReferences++;
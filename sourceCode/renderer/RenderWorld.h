@@ -142,6 +142,7 @@ typedef struct renderEntity_s {
 
 	bool					weaponDepthHack;		// squash depth range so view weapons don't poke into walls
 													// this automatically implies noShadow
+	bool					occluder;				// large opaque static model that hides what is behind it (r_useSoftOcclusion)
 	int						forceUpdate;			// force an update (NOTE: not a bool to keep this struct a multiple of 4 bytes)
 	int						timeGroup;
 	int						xrayIndex;
@@ -55,6 +55,9 @@ void idRenderWorldLocal::FreeWorld() {
 		if ( area->entityRefs.areaNext != &area->entityRefs ) {
 			common->Error( "FreeWorld: unexpected remaining entityRefs" );
 		}
+
+		delete area->entityCull;
+		delete area->lightCull;
 	}
 
 	if ( portalAreas ) {
@@ -83,6 +86,9 @@ void idRenderWorldLocal::FreeWorld() {
 	}
 	localModels.Clear();
 
+	// the cached shadows refer to the freed models
+	R_PurgeShadowCache();
+
 	areaReferenceAllocator.Shutdown();
 	interactionAllocator.Shutdown();
 	areaNumRefAllocator.Shutdown();
@@ -254,6 +260,8 @@ void idRenderWorldLocal::SetupAreaRefs() {
 		portalAreas[i].entityRefs.areaNext =
 		portalAreas[i].entityRefs.areaPrev =
 			&portalAreas[i].entityRefs;
+		portalAreas[i].entityCull = new idAreaCullBoxes;
+		portalAreas[i].lightCull = new idAreaCullBoxes;
 	}
 }
 
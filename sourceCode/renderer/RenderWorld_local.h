@@ -47,6 +47,40 @@ typedef struct doublePortal_s {
 } doublePortal_t;
 
 
+/*
+===============================================================================
+
+	Axial world bounds of the entity or light references of an area, grouped
+	into leaf blocks of four that have their own bounds. The view culls whole
+	blocks first, then the boxes of the remaining blocks, four at a time with
+	idSIMDProcessor::CullBoxes. New boxes go into the block they enlarge the
+	least, so nearby references end up in the same block.
+
+===============================================================================
+*/
+
+class idAreaCullBoxes {
+public:
+	int						AddBounds( const idBounds &bounds );
+	void					RemoveBounds( int slot );
+
+							// afterwards IsCulled tells if a box is completely outside the planes
+	void					CullToPlanes( int numPlanes, const idPlane *planes );
+	bool					IsCulled( int slot ) const { return cullBits[slot] != 0; }
+
+	int						NumBlocks( void ) const { return blockUsed.Num(); }
+
+private:
+	idList<float>			boxes;			// leaf blocks in the layout of idSIMDProcessor::CullBoxes
+	idList<float>			blockBounds;	// bounds of the leaf blocks in the same layout
+	idList<int>				blockUsed;		// number of boxes in each leaf block
+	idList<byte>			cullBits;
+	idList<byte>			blockCullBits;
+
+	void					SetBox( float *block, int index, const idBounds &bounds );
+	void					UpdateBlockBounds( int blockNum );
+};
+
 typedef struct portalArea_s {
 	int				areaNum;
 	int				connectedAreaNum[NUM_PORTAL_ATTRIBUTES];	// if two areas have matching connectedAreaNum, they are
@@ -55,6 +89,8 @@ typedef struct portalArea_s {
 	portal_t *		portals;		// never changes after load
 	areaReference_t	entityRefs;		// head/tail of doubly linked list, may change
 	areaReference_t	lightRefs;		// head/tail of doubly linked list, may change
+	idAreaCullBoxes *	entityCull;		// bounds of the entityRefs
+	idAreaCullBoxes *	lightCull;		// bounds of the lightRefs
 } portalArea_t;
 
 
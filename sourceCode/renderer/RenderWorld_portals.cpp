@@ -544,6 +544,187 @@ areaNumRef_t *idRenderWorldLocal::FloodFrustumAreas( const idFrustum &frustum, a
 }
 
 
+/*
+=======================================================================
+
+idAreaCullBoxes
+
+=======================================================================
+*/
+
+const int AREA_CULL_BLOCK_FLOATS = 24;		// four boxes of mins and maxs
+
+/*
+================
+idAreaCullBoxes::SetBox
+
+Cleared bounds are inverted, so they are culled by any plane.
+================
+*/
+void idAreaCullBoxes::SetBox( float *block, int index, const idBounds &bounds ) {
+	for ( int j = 0; j < 3; j++ ) {
+		block[j * 4 + index] = bounds[0][j];
+		block[j * 4 + index + 12] = bounds[1][j];
+	}
+}
+
+/*
+================
+idAreaCullBoxes::UpdateBlockBounds
+================
+*/
+void idAreaCullBoxes::UpdateBlockBounds( int blockNum ) {
+	const float *block = &boxes[ blockNum * AREA_CULL_BLOCK_FLOATS ];
+	idBounds bounds;
+
+	bounds.Clear();
+	for ( int i = 0; i < 4; i++ ) {
+		if ( block[i] > block[i + 12] ) {
+			continue;	// free slot
+		}
+		bounds.AddPoint( idVec3( block[i], block[i + 4], block[i + 8] ) );
+		bounds.AddPoint( idVec3( block[i + 12], block[i + 16], block[i + 20] ) );
+	}
+
+	SetBox( &blockBounds[ ( blockNum >> 2 ) * AREA_CULL_BLOCK_FLOATS ], blockNum & 3, bounds );
+}
+
+/*
+================
+AreaCullMargin
+
+Sum of the edge lengths, unlike the volume it doesn't vanish for flat bounds.
+================
+*/
+static float AreaCullMargin( const idBounds &bounds ) {
+	if ( bounds.IsCleared() ) {
+		return 0.0f;
+	}
+	return ( bounds[1][0] - bounds[0][0] ) + ( bounds[1][1] - bounds[0][1] ) + ( bounds[1][2] - bounds[0][2] );
+}
+
+/*
+================
+idAreaCullBoxes::AddBounds
+
+Returns the slot of the bounds.
+================
+*/
+int idAreaCullBoxes::AddBounds( const idBounds &inBounds ) {
+	int bestBlock = -1;
+	float bestGrowth = idMath::INFINITY;
+	idBounds bounds = inBounds;
+
+	// inside out bounds would look like a free slot, never cull them here
+	if ( bounds[0][0] > bounds[1][0] || bounds[0][1] > bounds[1][1] || bounds[0][2] > bounds[1][2] ) {
+		bounds[0].Set( -idMath::INFINITY, -idMath::INFINITY, -idMath::INFINITY );
+		bounds[1].Set( idMath::INFINITY, idMath::INFINITY, idMath::INFINITY );
+	}
+	const float margin = AreaCullMargin( bounds );
+
+	// find the block that grows least, preferring the most used ones
+	for ( int i = 0; i < blockUsed.Num(); i++ ) {
+		if ( blockUsed[i] >= 4 ) {
+			continue;
+		}
+		const float *b = &blockBounds[ ( i >> 2 ) * AREA_CULL_BLOCK_FLOATS + ( i & 3 ) ];
+		idBounds blockBound( idVec3( b[0], b[4], b[8] ), idVec3( b[12], b[16], b[20] ) );
+		const float oldMargin = AreaCullMargin( blockBound );
+
+		blockBound.AddBounds( bounds );
+		const float growth = AreaCullMargin( blockBound ) - oldMargin;
+
+		if ( bestBlock == -1 || growth < bestGrowth || ( growth == bestGrowth && blockUsed[i] > blockUsed[bestBlock] ) ) {
+			bestGrowth = growth;
+			bestBlock = i;
+		}
+	}
+
+	// start a new block if none has room, or a new one doesn't grow any more than the best
+	if ( bestBlock == -1 || bestGrowth > margin ) {
+		idBounds cleared;
+		cleared.Clear();
+
+		bestBlock = blockUsed.Append( 0 );
+		boxes.SetNum( boxes.Num() + AREA_CULL_BLOCK_FLOATS, false );
+		cullBits.SetNum( cullBits.Num() + 4, false );
+		for ( int i = 0; i < 4; i++ ) {
+			SetBox( &boxes[ bestBlock * AREA_CULL_BLOCK_FLOATS ], i, cleared );
+		}
+		if ( ( bestBlock & 3 ) == 0 ) {
+			blockBounds.SetNum( blockBounds.Num() + AREA_CULL_BLOCK_FLOATS, false );
+			blockCullBits.SetNum( blockCullBits.Num() + 4, false );
+			for ( int i = 0; i < 4; i++ ) {
+				SetBox( &blockBounds[ ( bestBlock >> 2 ) * AREA_CULL_BLOCK_FLOATS ], i, cleared );
+			}
+		}
+	}
+
+	float *block = &boxes[ bestBlock * AREA_CULL_BLOCK_FLOATS ];
+	int index;
+	for ( index = 0; index < 4; index++ ) {
+		if ( block[index] > block[index + 12] ) {
+			break;
+		}
+	}
+	assert( index < 4 );
+
+	SetBox( block, index, bounds );
+	blockUsed[bestBlock]++;
+	UpdateBlockBounds( bestBlock );
+
+	return bestBlock * 4 + index;
+}
+
+/*
+================
+idAreaCullBoxes::RemoveBounds
+================
+*/
+void idAreaCullBoxes::RemoveBounds( int slot ) {
+	const int blockNum = slot >> 2;
+	idBounds cleared;
+
+	assert( blockUsed[blockNum] > 0 );
+
+	cleared.Clear();
+	SetBox( &boxes[ blockNum * AREA_CULL_BLOCK_FLOATS ], slot & 3, cleared );
+	blockUsed[blockNum]--;
+	UpdateBlockBounds( blockNum );
+}
+
+/*
+================
+idAreaCullBoxes::CullToPlanes
+
+The positive sides of the planes are outside.
+================
+*/
+void idAreaCullBoxes::CullToPlanes( int numPlanes, const idPlane *planes ) {
+	const int numBlocks = blockUsed.Num();
+
+	if ( numBlocks == 0 ) {
+		return;
+	}
+
+	SIMDProcessor->CullBoxes( blockCullBits.Ptr(), blockBounds.Ptr(), ( numBlocks + 3 ) & ~3, planes, numPlanes );
+
+	// cull the boxes of consecutive blocks that are not culled as a whole in one go
+	for ( int first = 0; first < numBlocks; ) {
+		if ( blockCullBits[first] ) {
+			memset( &cullBits[ first * 4 ], 1, 4 );
+			first++;
+			continue;
+		}
+		int last = first + 1;
+		while ( last < numBlocks && !blockCullBits[last] ) {
+			last++;
+		}
+		SIMDProcessor->CullBoxes( &cullBits[ first * 4 ], &boxes[ first * AREA_CULL_BLOCK_FLOATS ], ( last - first ) * 4, planes, numPlanes );
+		first = last;
+	}
+}
+
 /*
 =======================================================================
 
@@ -594,6 +775,13 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 	idBounds			b;
 
 	area = &portalAreas[ areaNum ];
+
+	// cull the world bounds of all references first, only the ones
+	// that remain need the exact test of their reference bounds
+	const bool areaCulling = r_useAreaCulling.GetBool() && r_useEntityCulling.GetBool() && r_useCulling.GetInteger() != 0;
+	if ( areaCulling ) {
+		area->entityCull->CullToPlanes( ps->numPortalPlanes, ps->portalPlanes );
+	}
 	
 	for ( ref = area->entityRefs.areaNext ; ref != &area->entityRefs ; ref = ref->areaNext ) {
 		entity = ref->entity;
@@ -621,6 +809,10 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 		}
 
 		// cull reference bounds
+		if ( areaCulling && area->entityCull->IsCulled( ref->cullSlot ) ) {
+			tr.pc.c_area_cull_out++;
+			continue;
+		}
 		if ( CullEntityByPortals( entity, ps ) ) {
 			// we are culled out through this portal chain, but it might
 			// still be visible through others
@@ -728,6 +920,12 @@ void idRenderWorldLocal::AddAreaLightRefs( int areaNum, const portalStack_t *ps
 
 	area = &portalAreas[ areaNum ];
 
+	// the last stack plane is not used because lights are not near clipped
+	const bool areaCulling = r_useAreaCulling.GetBool() && r_useLightCulling.GetInteger() != 0;
+	if ( areaCulling ) {
+		area->lightCull->CullToPlanes( ps->numPortalPlanes - 1, ps->portalPlanes );
+	}
+
 	for ( lref = area->lightRefs.areaNext ; lref != &area->lightRefs ; lref = lref->areaNext ) {
 		light = lref->light;
 
@@ -745,6 +943,10 @@ void idRenderWorldLocal::AddAreaLightRefs( int areaNum, const portalStack_t *ps
 		}
 
 		// cull frustum
+		if ( areaCulling && area->lightCull->IsCulled( lref->cullSlot ) ) {
+			tr.pc.c_area_cull_out++;
+			continue;
+		}
 		if ( CullLightByPortals( light, ps ) ) {
 			// we are culled out through this portal chain, but it might
 			// still be visible through others
@@ -39,6 +39,15 @@ static void R_ListVertexCache_f( const idCmdArgs &args ) {
 	vertexCache.List();
 }
 
+/*
+==============
+R_TestVertexCache_f
+==============
+*/
+static void R_TestVertexCache_f( const idCmdArgs &args ) {
+	vertexCache.Test();
+}
+
 /*
 ==============
 idVertexCache::ActuallyFree
@@ -108,8 +117,13 @@ void *idVertexCache::Position( vertCache_t *buffer ) {
 		common->FatalError( "idVertexCache::Position: bad vertCache_t" );
 	}
 
+	// temp data allocated while the back end is drawing
+	if ( buffer->tag == TAG_TEMP && buffer->offset + buffer->size > listNum * FRAME_MEMORY_BYTES + dynamicUploaded ) {
+		UploadFrameTemp();
+	}
+
 	// the ARB vertex object just uses an offset
-	else if ( buffer->vbo ) {
+	if ( buffer->vbo ) {
 		if ( r_showVertexCache.GetInteger() == 2 ) {
 			if ( buffer->tag == TAG_TEMP ) {
 				common->Printf( "GL_ARRAY_BUFFER_ARB = %i + %i (%i bytes)\n", buffer->vbo, buffer->offset, buffer->size ); 
@@ -143,6 +157,7 @@ idVertexCache::Init
 */
 void idVertexCache::Init() {
 	cmdSystem->AddCommand( "listVertexCache", R_ListVertexCache_f, CMD_FL_RENDERER, "lists vertex cache" );
+	cmdSystem->AddCommand( "testVertexCache", R_TestVertexCache_f, CMD_FL_RENDERER|CMD_FL_CHEAT, "tests the frame temp staging and upload accounting" );
 
 	if ( r_vertexBufferMegs.GetInteger() < 8 ) {
 		r_vertexBufferMegs.SetInteger( 8 );
@@ -162,24 +177,24 @@ void idVertexCache::Init() {
 	// initialize the cache memory blocks
 	freeStaticHeaders.next = freeStaticHeaders.prev = &freeStaticHeaders;
 	staticHeaders.next = staticHeaders.prev = &staticHeaders;
-	freeDynamicHeaders.next = freeDynamicHeaders.prev = &freeDynamicHeaders;
-	dynamicHeaders.next = dynamicHeaders.prev = &dynamicHeaders;
 	deferredFreeList.next = deferredFreeList.prev = &deferredFreeList;
 
-	// set up the dynamic frame memory
+	// set up the dynamic frame memory ring
 	staticAllocTotal = 0;
-	byte	*junk = (byte *)Mem_Alloc( FRAME_MEMORY_BYTES );
-	for ( int i = 0 ; i < NUM_VERTEX_FRAMES ; i++ ) {
-		allocatingTempBuffer = true;	// force the alloc to use GL_STREAM_DRAW_ARB
-		Alloc( junk, FRAME_MEMORY_BYTES, &tempBuffers[i] );
-		allocatingTempBuffer = false;
-		tempBuffers[i]->tag = TAG_FIXED;
-		// unlink these from the static list, so they won't ever get purged
-		tempBuffers[i]->next->prev = tempBuffers[i]->prev;
-		tempBuffers[i]->prev->next = tempBuffers[i]->next;
-	}
+	byte	*junk = (byte *)Mem_ClearedAlloc( NUM_VERTEX_FRAMES * FRAME_MEMORY_BYTES );
+	allocatingTempBuffer = true;	// force the alloc to use GL_STREAM_DRAW_ARB
+	Alloc( junk, NUM_VERTEX_FRAMES * FRAME_MEMORY_BYTES, &dynamicBuffer );
+	allocatingTempBuffer = false;
+	dynamicBuffer->tag = TAG_FIXED;
+	// unlink it from the static list, so it won't ever get purged
+	dynamicBuffer->next->prev = dynamicBuffer->prev;
+	dynamicBuffer->prev->next = dynamicBuffer->next;
 	Mem_Free( junk );
 
+	// virtual memory is written directly
+	dynamicStaging = virtualMemory ? NULL : (byte *)Mem_Alloc16( FRAME_MEMORY_BYTES );
+	dynamicUploaded = 0;
+
 	EndFrame();
 }
 
@@ -205,6 +220,13 @@ idVertexCache::Shutdown
 void idVertexCache::Shutdown() {
 //	PurgeAll();	// !@#: also purge the temp buffers
 
+	if ( dynamicStaging ) {
+		Mem_Free16( dynamicStaging );
+		dynamicStaging = NULL;
+	}
+	for ( int i = 0 ; i < NUM_VERTEX_FRAMES ; i++ ) {
+		tempHeaders[i].Clear();
+	}
 	headerAllocator.Shutdown();
 }
 
@@ -374,50 +396,57 @@ vertCache_t	*idVertexCache::AllocFrameTemp( void *data, int size ) {
 
 	// this data is just going on the shared dynamic list
 
-	// if we don't have any remaining unused headers, allocate some more
-	if ( freeDynamicHeaders.next == &freeDynamicHeaders ) {
-
-		for ( int i = 0; i < EXPAND_HEADERS; i++ ) {
-			block = headerAllocator.Alloc();
-			block->next = freeDynamicHeaders.next;
-			block->prev = &freeDynamicHeaders;
-			block->next->prev = block;
-			block->prev->next = block;
-		}
+	// the headers of this region are reused, only get new ones when the frame needs more than ever before
+	idList<vertCache_t *> &headers = tempHeaders[listNum];
+	if ( dynamicCountThisFrame == headers.Num() ) {
+		headers.SetGranularity( EXPAND_HEADERS );
+		headers.Append( headerAllocator.Alloc() );
 	}
-
-	// move it from the freeDynamicHeaders list to the dynamicHeaders list
-	block = freeDynamicHeaders.next;
-	block->next->prev = block->prev;
-	block->prev->next = block->next;
-	block->next = dynamicHeaders.next;
-	block->prev = &dynamicHeaders;
-	block->next->prev = block;
-	block->prev->next = block;
+	block = headers[dynamicCountThisFrame];
 
 	block->size = size;
 	block->tag = TAG_TEMP;
 	block->indexBuffer = false;
-	block->offset = dynamicAllocThisFrame;
-	dynamicAllocThisFrame += block->size;
-	dynamicCountThisFrame++;
+	block->offset = listNum * FRAME_MEMORY_BYTES + dynamicAllocThisFrame;
+	block->next = block->prev = NULL;
 	block->user = NULL;
 	block->frameUsed = 0;
+	block->virtMem = dynamicBuffer->virtMem;
+	block->vbo = dynamicBuffer->vbo;
 
-	// copy the data
-	block->virtMem = tempBuffers[listNum]->virtMem;
-	block->vbo = tempBuffers[listNum]->vbo;
-
+	// copy the data, a vertex buffer gets it with the next upload
 	if ( block->vbo ) {
-		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, block->vbo );
-		qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, block->offset, (GLsizeiptrARB)size, data );
+		SIMDProcessor->Memcpy( dynamicStaging + dynamicAllocThisFrame, data, size );
 	} else {
 		SIMDProcessor->Memcpy( (byte *)block->virtMem + block->offset, data, size );
 	}
 
+	// keep the vertexes aligned
+	dynamicAllocThisFrame += ( size + 15 ) & ~15;
+	dynamicCountThisFrame++;
+
 	return block;
 }
 
+/*
+===========
+idVertexCache::UploadFrameTemp
+===========
+*/
+void idVertexCache::UploadFrameTemp() {
+	const int uploadEnd = Min( dynamicAllocThisFrame, FRAME_MEMORY_BYTES );
+	if ( uploadEnd <= dynamicUploaded ) {
+		return;
+	}
+
+	if ( dynamicBuffer->vbo ) {
+		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, dynamicBuffer->vbo );
+		qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, listNum * FRAME_MEMORY_BYTES + dynamicUploaded, (GLsizeiptrARB)( uploadEnd - dynamicUploaded ), dynamicStaging + dynamicUploaded );
+		dynamicUploadsThisFrame++;
+	}
+	dynamicUploaded = uploadEnd;
+}
+
 /*
 ===========
 idVertexCache::EndFrame
@@ -438,8 +467,8 @@ void idVertexCache::EndFrame() {
 
 		const char *frameOverflow = tempOverflow ? "(OVERFLOW)" : "";
 
-		common->Printf( "vertex dynamic:%i=%ik%s, static alloc:%i=%ik used:%i=%ik total:%i=%ik\n",
-			dynamicCountThisFrame, dynamicAllocThisFrame/1024, frameOverflow,
+		common->Printf( "vertex dynamic:%i=%ik%s in %i uploads, static alloc:%i=%ik used:%i=%ik total:%i=%ik\n",
+			dynamicCountThisFrame, dynamicAllocThisFrame/1024, frameOverflow, dynamicUploadsThisFrame,
 			staticCountThisFrame, staticAllocThisFrame/1024,
 			staticUseCount, staticUseSize/1024,
 			staticCountTotal, staticAllocTotal/1024 );
@@ -467,6 +496,8 @@ void idVertexCache::EndFrame() {
 	staticCountThisFrame = 0;
 	dynamicAllocThisFrame = 0;
 	dynamicCountThisFrame = 0;
+	dynamicUploaded = 0;
+	dynamicUploadsThisFrame = 0;
 	tempOverflow = false;
 
 	// free all the deferred free headers
@@ -474,16 +505,7 @@ void idVertexCache::EndFrame() {
 		ActuallyFree( deferredFreeList.next );
 	}
 
-	// free all the frame temp headers
-	vertCache_t	*block = dynamicHeaders.next;
-	if ( block != &dynamicHeaders ) {
-		block->prev = &freeDynamicHeaders;
-		dynamicHeaders.prev->next = freeDynamicHeaders.next;
-		freeDynamicHeaders.next->prev = dynamicHeaders.prev;
-		freeDynamicHeaders.next = block;
-
-		dynamicHeaders.next = dynamicHeaders.prev = &dynamicHeaders;
-	}
+	// the frame temp headers of the new region are reused as they are
 }
 
 /*
@@ -496,7 +518,7 @@ void idVertexCache::List( void ) {
 	int frameStatic = 0;
 	int	totalStatic = 0;
 	int	numFreeStaticHeaders = 0;
-	int	numFreeDynamicHeaders = 0;
+	int	numDynamicHeaders = 0;
 
 	vertCache_t *block;
 	for ( block = staticHeaders.next ; block != &staticHeaders ; block = block->next) {
@@ -512,15 +534,15 @@ void idVertexCache::List( void ) {
 		numFreeStaticHeaders++;
 	}
 
-	for ( block = freeDynamicHeaders.next ; block != &freeDynamicHeaders ; block = block->next ) {
-		numFreeDynamicHeaders++;
+	for ( int i = 0 ; i < NUM_VERTEX_FRAMES ; i++ ) {
+		numDynamicHeaders += tempHeaders[i].Num();
 	}
 
 	common->Printf( "%i megs working set\n", r_vertexBufferMegs.GetInteger() );
-	common->Printf( "%i dynamic temp buffers of %ik\n", NUM_VERTEX_FRAMES, FRAME_MEMORY_BYTES / 1024 );
+	common->Printf( "%i dynamic temp regions of %ik in a ring buffer\n", NUM_VERTEX_FRAMES, FRAME_MEMORY_BYTES / 1024 );
 	common->Printf( "%5i active static headers\n", numActive );
 	common->Printf( "%5i free static headers\n", numFreeStaticHeaders );
-	common->Printf( "%5i free dynamic headers\n", numFreeDynamicHeaders );
+	common->Printf( "%5i dynamic headers\n", numDynamicHeaders );
 
 	if ( !virtualMemory  ) {
 		common->Printf( "Vertex cache is in ARB_vertex_buffer_object memory (FAST).\n");
@@ -534,3 +556,89 @@ void idVertexCache::List( void ) {
 		common->Printf( "Index buffers are not used.\n" );
 	}
 }
+
+/*
+=============
+idVertexCache::Test
+
+Checks the staging and upload accounting of the frame temp data, run
+between frames from the console with testVertexCache
+=============
+*/
+void idVertexCache::Test( void ) {
+	const char	*result;
+	vertCache_t	*block[4];
+	vertCache_t	*overflow;
+	void		*position;
+	bool		ok;
+
+	if ( virtualMemory ) {
+		common->Printf( "testVertexCache: frame temp data is only staged with vertex buffer objects\n" );
+		return;
+	}
+
+	byte *data = (byte *)Mem_Alloc( FRAME_MEMORY_BYTES );
+	for ( int i = 0; i < FRAME_MEMORY_BYTES; i++ ) {
+		data[i] = (byte)( i * 7 + ( i >> 8 ) );
+	}
+
+	// start from an empty region
+	EndFrame();
+	const int regionStart = listNum * FRAME_MEMORY_BYTES;
+
+	// allocations are only copied to the staging area, aligned to 16 bytes
+	block[0] = AllocFrameTemp( data, 100 );
+	block[1] = AllocFrameTemp( data + 100, 32 );
+	block[2] = AllocFrameTemp( data + 132, 4000 );
+	ok = dynamicCountThisFrame == 3 && dynamicAllocThisFrame == 112 + 32 + 4000 && dynamicUploaded == 0 && dynamicUploadsThisFrame == 0;
+	ok = ok && block[0]->offset == regionStart && block[1]->offset == regionStart + 112 && block[2]->offset == regionStart + 144;
+	ok = ok && memcmp( dynamicStaging, data, 100 ) == 0 && memcmp( dynamicStaging + 112, data + 100, 32 ) == 0 && memcmp( dynamicStaging + 144, data + 132, 4000 ) == 0;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "AllocFrameTemp staging %s\n", result );
+
+	// the first lookup of data that wasn't uploaded yet uploads everything staged and returns the offset
+	position = Position( block[2] );
+	ok = position == (void *)block[2]->offset && dynamicUploaded == 4144 && dynamicUploadsThisFrame == 1;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "Position upload %s\n", result );
+
+	// uploaded data doesn't upload again
+	position = Position( block[0] );
+	UploadFrameTemp();
+	ok = position == (void *)block[0]->offset && dynamicUploaded == 4144 && dynamicUploadsThisFrame == 1;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "Position uploaded %s\n", result );
+
+	// temp data allocated after an upload only uploads the new part
+	block[3] = AllocFrameTemp( data, 64 );
+	position = Position( block[3] );
+	ok = position == (void *)block[3]->offset && block[3]->offset == regionStart + 4144 && dynamicUploaded == 4208 && dynamicUploadsThisFrame == 2;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "Position append %s\n", result );
+
+	// an allocation that doesn't fit the region goes to static memory and doesn't touch the staging area
+	const int staticAlloc = staticAllocThisFrame;
+	overflow = AllocFrameTemp( data, FRAME_MEMORY_BYTES );
+	position = Position( overflow );
+	ok = tempOverflow && overflow->tag == TAG_USED && position == (void *)overflow->offset;
+	ok = ok && staticAllocThisFrame == staticAlloc + FRAME_MEMORY_BYTES && dynamicAllocThisFrame == 4208 && dynamicCountThisFrame == 4;
+	ok = ok && dynamicUploaded == 4208 && dynamicUploadsThisFrame == 2;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "AllocFrameTemp overflow %s\n", result );
+
+	// the rest of the region still fits and is uploaded up to its end
+	block[0] = AllocFrameTemp( data, FRAME_MEMORY_BYTES - 4208 );
+	UploadFrameTemp();
+	ok = block[0]->tag == TAG_TEMP && dynamicAllocThisFrame == FRAME_MEMORY_BYTES;
+	ok = ok && dynamicUploaded == FRAME_MEMORY_BYTES && dynamicUploadsThisFrame == 3;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "UploadFrameTemp full region %s\n", result );
+
+	// the next frame starts with nothing staged
+	EndFrame();
+	ok = dynamicAllocThisFrame == 0 && dynamicCountThisFrame == 0 && dynamicUploaded == 0 && dynamicUploadsThisFrame == 0 && !tempOverflow;
+	result = ok ? "ok" : S_COLOR_RED"X";
+	common->Printf( "EndFrame reset %s\n", result );
+
+	Mem_Free( data );
+}
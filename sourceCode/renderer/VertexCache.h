@@ -77,8 +77,14 @@ public:
 	// will change every frame.
 	// will return NULL if the vertex cache is completely full
 	// As with Position(), this may not actually be a pointer you can access.
+	// The data is only copied to the frame's region of the dynamic ring buffer,
+	// it reaches the GPU with the next UploadFrameTemp.
 	vertCache_t	*	AllocFrameTemp( void *data, int bytes );
 
+	// uploads the frame temp data that was added since the last upload with a
+	// single buffer update, called before the back end draws
+	void			UploadFrameTemp();
+
 	// notes that a buffer is used this frame, so it can't be purged
 	// out from under the GPU
 	void			Touch( vertCache_t *buffer );
@@ -96,6 +102,9 @@ public:
 	// listVertexCache calls this
 	void			List();
 
+	// testVertexCache calls this
+	void			Test();
+
 private:
 	bool			virtualMemory;			// not fast stuff
 
@@ -118,14 +127,20 @@ private:
 
 	bool			allocatingTempBuffer;	// force GL_STREAM_DRAW_ARB
 
-	vertCache_t		*tempBuffers[NUM_VERTEX_FRAMES];		// allocated at startup
+	// the frame temp data lives in a ring of NUM_VERTEX_FRAMES regions of FRAME_MEMORY_BYTES,
+	// a region is written again after the GPU had NUM_VERTEX_FRAMES frames to draw from it
+	vertCache_t		*dynamicBuffer;			// allocated at startup
+	byte			*dynamicStaging;		// the temp data of the current frame until it is uploaded
+	int				dynamicUploaded;		// bytes of the current frame that were uploaded
+	int				dynamicUploadsThisFrame;
 	bool			tempOverflow;			// had to alloc a temp in static memory
 
 	idBlockAlloc<vertCache_t,1024>	headerAllocator;
 
+	// the temp headers of a frame are reused by the frame that uses the same region
+	idList<vertCache_t *>	tempHeaders[NUM_VERTEX_FRAMES];
+
 	vertCache_t		freeStaticHeaders;		// head of doubly linked list
-	vertCache_t		freeDynamicHeaders;		// head of doubly linked list
-	vertCache_t		dynamicHeaders;			// head of doubly linked list
 	vertCache_t		deferredFreeList;		// head of doubly linked list
 	vertCache_t		staticHeaders;			// head of doubly linked list in MRU order,
 											// staticHeaders.next is most recently used
@@ -863,6 +863,8 @@ void R_AddLightSurfaces( void ) {
 	idRenderLightLocal *light;
 	viewLight_t		**ptr;
 
+	PROFILE_ZONE( R_AddLightSurfaces );
+
 	// go through each visible light, possibly removing some from the list
 	ptr = &tr.viewDef->viewLights;
 	while ( *ptr ) {
@@ -953,6 +955,17 @@ void R_AddLightSurfaces( void ) {
 			}
 		}
 
+		// skip the lights that are completely hidden behind the occluders of the view
+		if ( light->frustumTris && R_OcclusionCullBox( light->frustumTris->bounds, NULL ) ) {
+			if ( r_showSoftOcclusion.GetInteger() == 2 ) {
+				tr.viewDef->renderWorld->DebugBounds( colorOrange, light->frustumTris->bounds );
+			}
+			tr.pc.c_occludedLights++;
+			*ptr = vLight->next;
+			light->viewCount = -1;
+			continue;
+		}
+
 		// this one stays on the list
 		ptr = &vLight->next;
 
@@ -1063,6 +1076,60 @@ bool R_IssueEntityDefCallback( idRenderEntityLocal *def ) {
 	return update;
 }
 
+/*
+===================
+R_DynamicModelIsUnchanged
+
+True if the cached snapshot of an animated model was instantiated from the
+same model, skin and pose. The lightgem and subviews update and render the
+entities again in the same frame, which would otherwise skin them once more.
+===================
+*/
+static bool R_DynamicModelIsUnchanged( const idRenderEntityLocal *def, const idRenderModel *model ) {
+	const renderEntity_t &parms = def->parms;
+
+	if ( !def->cachedDynamicModel || !def->cachedModelJoints || !r_reuseDynamicModels.GetBool() || !r_useCachedDynamicModels.GetBool() ) {
+		return false;
+	}
+	if ( r_showSkel.GetInteger() ) {
+		return false;
+	}
+	if ( def->cachedModelSource != model || def->cachedModelSkin != parms.customSkin || def->cachedModelShader != parms.customShader ) {
+		return false;
+	}
+	if ( def->cachedModelSkinScale != parms.shaderParms[ SHADERPARM_MD5_SKINSCALE ] || def->cachedModelNumJoints != parms.numJoints ) {
+		return false;
+	}
+	return memcmp( def->cachedModelJoints, parms.joints, parms.numJoints * sizeof( parms.joints[0] ) ) == 0;
+}
+
+/*
+===================
+R_StoreDynamicModelSource
+===================
+*/
+static void R_StoreDynamicModelSource( idRenderEntityLocal *def, const idRenderModel *model ) {
+	const renderEntity_t &parms = def->parms;
+
+	// only the joints animated models depend on are tracked, everything else is rebuilt as before
+	if ( !def->cachedDynamicModel || model->IsDynamicModel() != DM_CACHED || !parms.joints || parms.numJoints <= 0 || !r_reuseDynamicModels.GetBool() ) {
+		R_InvalidateEntityDefDynamicModel( def );
+		return;
+	}
+
+	if ( def->cachedModelNumJoints != parms.numJoints ) {
+		R_InvalidateEntityDefDynamicModel( def );
+		def->cachedModelJoints = (idJointMat *)Mem_Alloc16( parms.numJoints * sizeof( parms.joints[0] ) );
+		def->cachedModelNumJoints = parms.numJoints;
+	}
+	SIMDProcessor->Memcpy( def->cachedModelJoints, parms.joints, parms.numJoints * sizeof( parms.joints[0] ) );
+
+	def->cachedModelSource = model;
+	def->cachedModelSkin = parms.customSkin;
+	def->cachedModelShader = parms.customShader;
+	def->cachedModelSkinScale = parms.shaderParms[ SHADERPARM_MD5_SKINSCALE ];
+}
+
 /*
 ===================
 R_EntityDefDynamicModel
@@ -1103,8 +1170,13 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 	// if we don't have a snapshot of the dynamic model, generate it now
 	if ( !def->dynamicModel ) {
 
-		// instantiate the snapshot of the dynamic model, possibly reusing memory from the cached snapshot
-		def->cachedDynamicModel = model->InstantiateDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
+		if ( R_DynamicModelIsUnchanged( def, model ) ) {
+			tr.pc.c_reusedDynamicModels++;
+		} else {
+			// instantiate the snapshot of the dynamic model, possibly reusing memory from the cached snapshot
+			def->cachedDynamicModel = model->InstantiateDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
+			R_StoreDynamicModelSource( def, model );
+		}
 
 		if ( def->cachedDynamicModel ) {
 
@@ -1444,6 +1516,64 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 	return R_ScreenRectFromViewFrustumBounds( bounds );
 }
 
+/*
+===================
+R_SkipViewEntity
+
+Entities that are not drawn in this view at all.
+===================
+*/
+static bool R_SkipViewEntity( const viewEntity_t *vEntity ) {
+	const renderEntity_t &parms = vEntity->entityDef->parms;
+
+	if ( tr.viewDef->isXraySubview && parms.xrayIndex == 1 ) {
+		return true;
+	} else if ( !tr.viewDef->isXraySubview && parms.xrayIndex == 2 ) {
+		return true;
+	}
+
+	// Don't let particle entities re-instantiate their dynamic model during non-visible 
+	// views (in TDM, the light gem render) -- SteveL #3970
+	if ( tr.viewDef->renderView.viewID < TR_SCREEN_VIEW_ID
+		&& dynamic_cast<const idRenderModelPrt*>( parms.hModel ) != NULL )
+	{
+		return true;
+	}
+
+	return false;
+}
+
+/*
+===================
+R_BeginEntityTimeGroup
+
+Switches the view time to the time group of an entity, R_EndEntityTimeGroup restores it.
+===================
+*/
+static void R_BeginEntityTimeGroup( int timeGroup, float &oldFloatTime, int &oldTime ) {
+	game->SelectTimeGroup( timeGroup );
+
+	if ( timeGroup ) {
+		oldFloatTime = tr.viewDef->floatTime;
+		oldTime = tr.viewDef->renderView.time;
+
+		tr.viewDef->floatTime = game->GetTimeGroupTime( timeGroup ) * 0.001;
+		tr.viewDef->renderView.time = game->GetTimeGroupTime( timeGroup );
+	}
+}
+
+/*
+===================
+R_EndEntityTimeGroup
+===================
+*/
+static void R_EndEntityTimeGroup( int timeGroup, float oldFloatTime, int oldTime ) {
+	if ( timeGroup ) {
+		tr.viewDef->floatTime = oldFloatTime;
+		tr.viewDef->renderView.time = oldTime;
+	}
+}
+
 /*
 ===================
 R_AddModelSurfaces
@@ -1453,19 +1583,36 @@ interactions get created.  This is all done on a sort-by-model basis
 to keep source data in cache (most likely L2) as any interactions and
 shadows are generated, since dynamic models will typically be lit by
 two or more lights.
+
+The dynamic models of the visible entities are instantiated in a first
+pass, so the vertexes of all their MD5 meshes can be skinned on the job
+threads at once.
+
+Interactions that have to be created are queued while walking the entities,
+their surfaces are built on the job threads and they are added at the end.
 ===================
 */
 void R_AddModelSurfaces( void ) {
 	viewEntity_t		*vEntity;
 	idInteraction		*inter, *next;
 	idRenderModel		*model;
+	float				oldFloatTime;
+	int					oldTime;
+
+	PROFILE_ZONE( R_AddModelSurfaces );
 
 	// clear the ambient surface list
 	tr.viewDef->numDrawSurfs = 0;
 	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
 
-	// go through each entity that is either visible to the view, or to
-	// any light that intersects the view (for shadows)
+	// overlays are built from the skinned vertexes and the bounds check needs them as well,
+	// so entities with either are instantiated in the second pass without batching
+	const bool batchSkinning = r_useParallelSkinning.GetBool() && parallelJobManager->GetNumThreads() > 0 && !r_checkBounds.GetBool();
+
+	if ( batchSkinning ) {
+		R_BeginMD5Skinning();
+	}
+
 	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
 
 		if ( r_useEntityScissors.GetBool() ) {
@@ -1479,49 +1626,54 @@ void R_AddModelSurfaces( void ) {
 			}
 		}
 
-		float oldFloatTime;
-		int oldTime;
-
-		game->SelectTimeGroup( vEntity->entityDef->parms.timeGroup );
-
-		if ( vEntity->entityDef->parms.timeGroup ) {
-			oldFloatTime = tr.viewDef->floatTime;
-			oldTime = tr.viewDef->renderView.time;
-
-			tr.viewDef->floatTime = game->GetTimeGroupTime( vEntity->entityDef->parms.timeGroup ) * 0.001;
-			tr.viewDef->renderView.time = game->GetTimeGroupTime( vEntity->entityDef->parms.timeGroup );
+		// entities hidden behind the occluders of the view are only kept for their shadows
+		if ( !vEntity->scissorRect.IsEmpty() && !vEntity->weaponDepthHack && vEntity->modelDepthHack == 0.0f ) {
+			const idRenderEntityLocal *def = vEntity->entityDef;
+			if ( R_OcclusionCullBox( def->referenceBounds, def->modelMatrix ) ) {
+				if ( r_showSoftOcclusion.GetInteger() == 2 ) {
+					idBox box( def->referenceBounds, def->parms.origin, def->parms.axis );
+					tr.viewDef->renderWorld->DebugBox( colorRed, box );
+				}
+				tr.pc.c_occludedEntities++;
+				vEntity->scissorRect.Clear();
+			}
 		}
 
-		if ( tr.viewDef->isXraySubview && vEntity->entityDef->parms.xrayIndex == 1 ) {
-			if ( vEntity->entityDef->parms.timeGroup ) {
-				tr.viewDef->floatTime = oldFloatTime;
-				tr.viewDef->renderView.time = oldTime;
-			}
+		if ( !batchSkinning || vEntity->scissorRect.IsEmpty() || R_SkipViewEntity( vEntity ) ) {
 			continue;
-		} else if ( !tr.viewDef->isXraySubview && vEntity->entityDef->parms.xrayIndex == 2 ) {
-			if ( vEntity->entityDef->parms.timeGroup ) {
-				tr.viewDef->floatTime = oldFloatTime;
-				tr.viewDef->renderView.time = oldTime;
-			}
+		}
+		if ( vEntity->entityDef->overlay && !r_skipOverlays.GetBool() ) {
 			continue;
 		}
 
-		// Don't let particle entities re-instantiate their dynamic model during non-visible 
-		// views (in TDM, the light gem render) -- SteveL #3970
-		if ( tr.viewDef->renderView.viewID < TR_SCREEN_VIEW_ID
-			&& dynamic_cast<const idRenderModelPrt*>( vEntity->entityDef->parms.hModel ) != NULL )
-		{
+		const int timeGroup = vEntity->entityDef->parms.timeGroup;
+		R_BeginEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
+		R_EntityDefDynamicModel( vEntity->entityDef );
+		R_EndEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
+	}
+
+	if ( batchSkinning ) {
+		R_FinishMD5Skinning();
+	}
+
+	R_QueueInteractions();
+
+	// go through each entity that is either visible to the view, or to
+	// any light that intersects the view (for shadows)
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+
+		if ( R_SkipViewEntity( vEntity ) ) {
 			continue;
 		}
 
+		const int timeGroup = vEntity->entityDef->parms.timeGroup;
+		R_BeginEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
+
 		// add the ambient surface if it has a visible rectangle
 		if ( !vEntity->scissorRect.IsEmpty() ) {
 			model = R_EntityDefDynamicModel( vEntity->entityDef );
 			if ( model == NULL || model->NumSurfaces() <= 0 ) {
-				if ( vEntity->entityDef->parms.timeGroup ) {
-					tr.viewDef->floatTime = oldFloatTime;
-					tr.viewDef->renderView.time = oldTime;
-				}
+				R_EndEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
 				continue;
 			}
 
@@ -1560,11 +1712,21 @@ void R_AddModelSurfaces( void ) {
 			}
 		}
 
-		if ( vEntity->entityDef->parms.timeGroup ) {
-			tr.viewDef->floatTime = oldFloatTime;
-			tr.viewDef->renderView.time = oldTime;
+		R_EndEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
+	}
+
+	// create the queued interactions on the job threads and add them now that they have surfaces
+	const int numQueued = R_CreateQueuedInteractions();
+	for ( int i = 0; i < numQueued; i++ ) {
+		inter = R_QueuedInteraction( i );
+		if ( inter->IsEmpty() ) {
+			continue;
 		}
 
+		const int timeGroup = inter->entityDef->parms.timeGroup;
+		R_BeginEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
+		inter->AddActiveInteraction();
+		R_EndEntityTimeGroup( timeGroup, oldFloatTime, oldTime );
 	}
 }
 
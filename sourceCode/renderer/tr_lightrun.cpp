@@ -576,6 +576,7 @@ void R_FreeLightDefDerivedData( idRenderLightLocal *ldef ) {
 		// unlink from the area
 		lref->areaNext->areaPrev = lref->areaPrev;
 		lref->areaPrev->areaNext = lref->areaNext;
+		lref->area->lightCull->RemoveBounds( lref->cullSlot );
 
 		// put it back on the free list for reuse
 		ldef->world->areaReferenceAllocator.Free( lref );
@@ -632,6 +633,10 @@ void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool
 		}
 	}
 
+	if ( !keepCachedDynamicModel ) {
+		R_InvalidateEntityDefDynamicModel( def );
+	}
+
 	if ( !keepDecals ) {
 		R_FreeEntityDefDecals( def );
 		R_FreeEntityDefOverlay( def );
@@ -643,6 +648,7 @@ void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool
 		// unlink from the area
 		ref->areaNext->areaPrev = ref->areaPrev;
 		ref->areaPrev->areaNext = ref->areaNext;
+		ref->area->entityCull->RemoveBounds( ref->cullSlot );
 
 		// put it back on the free list for reuse
 		def->world->areaReferenceAllocator.Free( ref );
@@ -677,6 +683,23 @@ void R_ClearEntityDefDynamicModel( idRenderEntityLocal *def ) {
 	}
 }
 
+/*
+==================
+R_InvalidateEntityDefDynamicModel
+
+Makes sure the next view instantiates the dynamic model again instead of
+reusing the cached snapshot for an unchanged pose.
+==================
+*/
+void R_InvalidateEntityDefDynamicModel( idRenderEntityLocal *def ) {
+	if ( def->cachedModelJoints ) {
+		Mem_Free16( def->cachedModelJoints );
+		def->cachedModelJoints = NULL;
+	}
+	def->cachedModelNumJoints = 0;
+	def->cachedModelSource = NULL;
+}
+
 /*
 ===================
 R_FreeEntityDefDecals
@@ -744,6 +767,9 @@ void R_FreeDerivedData( void ) {
 			R_FreeLightDefDerivedData( light );
 		}
 	}
+
+	// the models are about to be reloaded or the interactions regenerated
+	R_PurgeShadowCache();
 }
 
 /*
@@ -767,6 +793,9 @@ void R_CheckForEntityDefsUsingModel( idRenderModel *model ) {
 			}
 		}
 	}
+
+	// the surfaces of the model may be freed
+	R_PurgeShadowCache();
 }
 
 /*
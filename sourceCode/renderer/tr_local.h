@@ -145,6 +145,7 @@ typedef struct areaReference_s {
 	idRenderEntityLocal *	entity;					// only one of entity / light will be non-NULL
 	idRenderLightLocal *	light;					// only one of entity / light will be non-NULL
 	struct portalArea_s	*	area;					// so owners can find all the areas they are in
+	int						cullSlot;				// of the bounds in the entityCull or lightCull of the area
 } areaReference_t;
 
 
@@ -265,6 +266,15 @@ public:
 													// dynamicModel if this doesn't == tr.viewCount
 	idRenderModel *			cachedDynamicModel;
 
+	// what cachedDynamicModel was instantiated from, so later views that see the entity in
+	// the same pose can reuse it, even if the entity was updated in between
+	const idRenderModel *	cachedModelSource;
+	const idDeclSkin *		cachedModelSkin;
+	const idMaterial *		cachedModelShader;
+	float					cachedModelSkinScale;
+	int						cachedModelNumJoints;
+	idJointMat *			cachedModelJoints;		// NULL if the snapshot can't be reused
+
 	idBounds				referenceBounds;		// the local bounds used to place entityRefs, either from parms or a model
 
 	// a viewEntity_t is created whenever a idRenderEntityLocal is considered for inclusion
@@ -431,6 +441,9 @@ typedef struct viewDef_s {
 	// crossing a closed door.  This is used to avoid drawing interactions
 	// when the light is behind a closed door.
 
+	byte *				softOcclusionImage;		// r_showSoftOcclusion copy of the occlusion buffer
+	int					softOcclusionWidth;
+	int					softOcclusionHeight;
 } viewDef_t;
 
 
@@ -522,22 +535,34 @@ typedef struct frameMemoryBlock_s {
 	byte	base[4];	// dynamically allocated as [size]
 } frameMemoryBlock_t;
 
-// all of the information needed by the back end must be
-// contained in a frameData_t.  This entire structure is
-// duplicated so the front and back end can run in parallel
-// on an SMP machine (OBSOLETE: this capability has been removed)
+// each thread that allocates frame memory bumps through its own arena,
+// so the job threads of the front end don't need any locking
 typedef struct {
 	// one or more blocks of memory for all frame
-	// temporary allocations
+	// temporary allocations of the thread
 	frameMemoryBlock_t	*memory;
 
 	// alloc will point somewhere into the memory chain
 	frameMemoryBlock_t	*alloc;
 
+	int					memoryHighwater;	// max used on any frame
+} frameArena_t;
+
+// the main thread and every job thread
+const int MAX_FRAME_ARENAS = MAX_JOB_THREADS + 1;
+
+// all of the information needed by the back end must be
+// contained in a frameData_t.  This entire structure is
+// duplicated so the front and back end can run in parallel
+// on an SMP machine (OBSOLETE: this capability has been removed)
+typedef struct {
+	// indexed by idParallelJobManager::GetThreadIndex
+	frameArena_t		arenas[MAX_FRAME_ARENAS];
+
 	srfTriangles_t *	firstDeferredFreeTriSurf;
 	srfTriangles_t *	lastDeferredFreeTriSurf;
 
-	int					memoryHighwater;	// max used on any frame
+	int					memoryHighwater;	// max used on any frame by all arenas
 
 	// the currently building command list 
 	// commands can be inserted at the front if needed, as for required
@@ -574,10 +599,17 @@ const idMaterial *R_RemapShaderBySkin( const idMaterial *shader, const idDeclSki
 typedef struct {
 	int		c_sphere_cull_in, c_sphere_cull_clip, c_sphere_cull_out;
 	int		c_box_cull_in, c_box_cull_out;
+	int		c_area_cull_out;	// references culled by their area bounds
+	int		c_occluderTris;		// triangles rasterized into the software occlusion buffer
+	int		c_occludedEntities;	// visible entities hidden by the occlusion buffer
+	int		c_occludedLights;	// view lights hidden by the occlusion buffer
 	int		c_createInteractions;	// number of calls to idInteraction::CreateInteraction
+	int		c_parallelInteractions;	// interactions created on the job threads
 	int		c_createLightTris;
 	int		c_createShadowVolumes;
+	int		c_cachedShadowVolumes;	// shadow volumes taken from the shadow cache instead
 	int		c_generateMd5;
+	int		c_reusedDynamicModels;	// snapshots of unchanged poses used by another view
 	int		c_entityDefCallbacks;
 	int		c_alloc, c_free;	// counts for R_StaticAllc/R_StaticFree
 	int		c_visibleViewEntities;
@@ -869,6 +901,10 @@ extern idCVar r_useLightCulling;		// 0 = none, 1 = box, 2 = exact clip of polyhe
 extern idCVar r_useLightScissors;		// 1 = use custom scissor rectangle for each light
 extern idCVar r_useClippedLightScissors;// 0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always
 extern idCVar r_useEntityCulling;		// 0 = none, 1 = box
+extern idCVar r_useAreaCulling;		// 1 = cull the world bounds of all references of an area first
+extern idCVar r_useSoftOcclusion;		// 1 = skip entities and lights hidden behind the occluders of the view
+extern idCVar r_showSoftOcclusion;		// 1 = draw the occlusion buffer, 2 = also the bounds of the occluded entities and lights
+extern idCVar r_softOcclusionMinSize;	// occluder surfaces smaller than this fraction of their distance are skipped
 extern idCVar r_useEntityScissors;		// 1 = use custom scissor rectangle for each entity
 extern idCVar r_useInteractionCulling;	// 1 = cull interactions
 extern idCVar r_useInteractionScissors;	// 1 = use a custom scissor rectangle for each interaction
@@ -876,8 +912,13 @@ extern idCVar r_useFrustumFarDistance;	// if != 0 force the view frustum far dis
 extern idCVar r_useShadowCulling;		// try to cull shadows from partially visible lights
 extern idCVar r_usePreciseTriangleInteractions;	// 1 = do winding clipping to determine if each ambiguous tri should be lit
 extern idCVar r_useTurboShadow;			// 1 = use the infinite projection with W technique for dynamic shadows
+extern idCVar r_useParallelInteractions;	// 1 = create new interactions on the job threads
+extern idCVar r_useParallelSkinning;		// 1 = skin the MD5 meshes of the visible entities on the job threads
+extern idCVar r_reuseDynamicModels;		// 1 = reuse dynamic model snapshots of unchanged poses across views
 extern idCVar r_useExternalShadows;		// 1 = skip drawing caps when outside the light volume
 extern idCVar r_useOptimizedShadows;	// 1 = use the dmap generated static shadow volumes
+extern idCVar r_useShadowCache;		// 1 = keep the shadow volumes of static models when their interactions are freed
+extern idCVar r_shadowCacheSize;		// megabytes of freed shadow volumes kept around
 extern idCVar r_useShadowVertexProgram;	// 1 = do the shadow projection in the vertex program on capable cards
 extern idCVar r_useShadowProjectedCull;	// 1 = discard triangles outside light volume before shadowing
 extern idCVar r_useDeferredTangents;	// 1 = don't always calc tangents after deform
@@ -1189,6 +1230,11 @@ void R_ListRenderEntityDefs_f( const idCmdArgs &args );
 bool R_IssueEntityDefCallback( idRenderEntityLocal *def );
 idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def );
 
+// MD5 meshes instantiated between these calls are skinned on the job threads
+void R_BeginMD5Skinning( void );
+void R_FinishMD5Skinning( void );
+void R_BenchSkinning_f( const idCmdArgs &args );
+
 viewEntity_t *R_SetEntityDefViewEntity( idRenderEntityLocal *def );
 viewLight_t *R_SetLightDefViewLight( idRenderLightLocal *def );
 
@@ -1232,6 +1278,7 @@ void R_FreeLightDefDerivedData( idRenderLightLocal *light );
 void R_CheckForEntityDefsUsingModel( idRenderModel *model );
 
 void R_ClearEntityDefDynamicModel( idRenderEntityLocal *def );
+void R_InvalidateEntityDefDynamicModel( idRenderEntityLocal *def );
 void R_FreeEntityDefDerivedData( idRenderEntityLocal *def, bool keepDecals, bool keepCachedDynamicModel );
 void R_FreeEntityDefCachedDynamicModel( idRenderEntityLocal *def );
 void R_FreeEntityDefDecals( idRenderEntityLocal *def );
@@ -1253,6 +1300,18 @@ srfTriangles_t *R_PolytopeSurface( int numPlanes, const idPlane *planes, idWindi
 /*
 ============================================================
 
+OCCLUSION
+
+============================================================
+*/
+
+void R_RenderOcclusionBuffer( void );
+bool R_OcclusionCullBox( const idBounds &bounds, const float modelMatrix[16] );
+void R_ShutdownOcclusionBuffer( void );
+
+/*
+============================================================
+
 RENDER
 
 ============================================================
@@ -1424,9 +1483,25 @@ typedef enum {
 	SG_OFFLINE		// perform very time consuming optimizations
 } shadowGen_t;
 
+// counts are only needed for SG_DYNAMIC, without them the global counters are used
 srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 									 const srfTriangles_t *tri, const idRenderLightLocal *light,
-									 shadowGen_t optimize, srfCullInfo_t &cullInfo );
+									 shadowGen_t optimize, srfCullInfo_t &cullInfo,
+									 interactionCounts_t *counts = NULL );
+
+/*
+============================================================
+
+SHADOW CACHE
+
+============================================================
+*/
+
+int R_ShadowVolumeType( shadowGen_t shadowGen );
+srfTriangles_t *R_FindCachedShadowVolume( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idMaterial *shader, const idRenderLightLocal *light, int shadowType );
+bool R_CacheShadowVolume( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idMaterial *shader, const idRenderLightLocal *light, int shadowType, srfTriangles_t *shadowTris );
+void R_PurgeShadowCache( void );
+int R_ShadowCacheMemory( int *numVolumes );
 
 /*
 ============================================================
@@ -1447,7 +1522,10 @@ srfTriangles_t *R_CreateVertexProgramTurboShadowVolume( const idRenderEntityLoca
 
 srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 									 const srfTriangles_t *tri, const idRenderLightLocal *light,
-									 srfCullInfo_t &cullInfo );
+									 srfCullInfo_t &cullInfo, interactionCounts_t *counts );
+
+extern int	c_turboUsedVerts;
+extern int	c_turboUnusedVerts;
 
 /*
 ============================================================
@@ -1529,7 +1607,8 @@ srfTriangles_t *	R_MergeTriangles( const srfTriangles_t *tri1, const srfTriangle
 
 // if the deformed verts have significant enough texture coordinate changes to reverse the texture
 // polarity of a triangle, the tangents will be incorrect
-void				R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes = true );
+// the indexes are counted in tangentIndexes instead of tr.pc if given, for the job threads
+void				R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes = true, int *tangentIndexes = NULL );
 
 // deformable meshes precalculate as much as possible from a base frame, then generate
 // complete srfTriangles_t from just a new set of vertexes
@@ -169,6 +169,71 @@ void R_ShowColoredScreenRect( const idScreenRect &rect, int colorIndex ) {
 	}
 }
 
+//=====================================================
+
+#define	MEMORY_BLOCK_SIZE	0x100000
+#define	JOB_MEMORY_BLOCK_SIZE	0x40000		// job threads start with smaller arenas
+#define	MEMORY_BLOCK_ROUND	0x10000
+
+/*
+=====================
+R_AllocFrameMemoryBlock
+=====================
+*/
+static frameMemoryBlock_t *R_AllocFrameMemoryBlock( int size ) {
+	frameMemoryBlock_t *block;
+
+	block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
+	if ( !block ) {
+		common->FatalError( "R_AllocFrameMemoryBlock: Mem_Alloc() failed" );
+	}
+	block->size = size;
+	block->used = 0;
+	block->next = NULL;
+	return block;
+}
+
+/*
+=====================
+R_FreeFrameArena
+=====================
+*/
+static void R_FreeFrameArena( frameArena_t *arena ) {
+	frameMemoryBlock_t *block, *nextBlock;
+
+	for ( block = arena->memory ; block ; block = nextBlock ) {
+		nextBlock = block->next;
+		Mem_Free( block );
+	}
+	arena->memory = NULL;
+	arena->alloc = NULL;
+}
+
+/*
+=====================
+R_SizeFrameArena
+
+Replaces the block chain of an arena by a single block once its
+highwater mark doesn't fit the first block anymore.
+=====================
+*/
+static void R_SizeFrameArena( frameArena_t *arena ) {
+	if ( !arena->memory || !arena->memory->next ) {
+		return;
+	}
+	if ( arena->memoryHighwater <= arena->memory->size ) {
+		return;
+	}
+
+	// leave some room for growth
+	int size = arena->memoryHighwater + arena->memoryHighwater / 4;
+	size = ( size + MEMORY_BLOCK_ROUND - 1 ) & ~( MEMORY_BLOCK_ROUND - 1 );
+
+	R_FreeFrameArena( arena );
+	arena->memory = R_AllocFrameMemoryBlock( size );
+	arena->alloc = arena->memory;
+}
+
 /*
 ====================
 R_ToggleSmpFrame
@@ -189,22 +254,25 @@ void R_ToggleSmpFrame( void ) {
 
 	frame = frameData;
 
-	// reset the memory allocation to the first block
-	frame->alloc = frame->memory;
+	for ( int i = 0 ; i < MAX_FRAME_ARENAS ; i++ ) {
+		frameArena_t *arena = &frame->arenas[i];
+
+		// an arena that needed several blocks gets a single one
+		// that fits the largest frame so far
+		R_SizeFrameArena( arena );
+
+		// reset the memory allocation to the first block
+		arena->alloc = arena->memory;
 
-	// clear all the blocks
-	for ( block = frame->memory ; block ; block = block->next ) {
-		block->used = 0;
+		// clear all the blocks
+		for ( block = arena->memory ; block ; block = block->next ) {
+			block->used = 0;
+		}
 	}
 
 	R_ClearCommandChain();
 }
 
-
-//=====================================================
-
-#define	MEMORY_BLOCK_SIZE	0x100000
-
 /*
 =====================
 R_ShutdownFrameData
@@ -212,7 +280,6 @@ R_ShutdownFrameData
 */
 void R_ShutdownFrameData( void ) {
 	frameData_t *frame;
-	frameMemoryBlock_t *block;
 
 	// free any current data
 	frame = frameData;
@@ -222,10 +289,8 @@ void R_ShutdownFrameData( void ) {
 
 	R_FreeDeferredTriSurfs( frame );
 
-	frameMemoryBlock_t *nextBlock;
-	for ( block = frame->memory ; block ; block = nextBlock ) {
-		nextBlock = block->next;
-		Mem_Free( block );
+	for ( int i = 0 ; i < MAX_FRAME_ARENAS ; i++ ) {
+		R_FreeFrameArena( &frame->arenas[i] );
 	}
 	Mem_Free( frame );
 	frameData = NULL;
@@ -234,26 +299,19 @@ void R_ShutdownFrameData( void ) {
 /*
 =====================
 R_InitFrameData
+
+The arenas of the job threads are created when they first allocate.
 =====================
 */
 void R_InitFrameData( void ) {
-	int size;
 	frameData_t *frame;
-	frameMemoryBlock_t *block;
 
 	R_ShutdownFrameData();
 
 	frameData = (frameData_t *)Mem_ClearedAlloc( sizeof( *frameData ));
 	frame = frameData;
-	size = MEMORY_BLOCK_SIZE;
-	block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-	if ( !block ) {
-		common->FatalError( "R_InitFrameData: Mem_Alloc() failed" );
-	}
-	block->size = size;
-	block->used = 0;
-	block->next = NULL;
-	frame->memory = block;
+	frame->arenas[0].memory = R_AllocFrameMemoryBlock( MEMORY_BLOCK_SIZE );
+	frame->arenas[0].alloc = frame->arenas[0].memory;
 	frame->memoryHighwater = 0;
 
 	R_ToggleSmpFrame();
@@ -262,6 +320,8 @@ void R_InitFrameData( void ) {
 /*
 ================
 R_CountFrameData
+
+Returns the frame memory used by all arenas and updates the highwater marks.
 ================
 */
 int R_CountFrameData( void ) {
@@ -271,11 +331,20 @@ int R_CountFrameData( void ) {
 
 	count = 0;
 	frame = frameData;
-	for ( block = frame->memory ; block ; block=block->next ) {
-		count += block->used;
-		if ( block == frame->alloc ) {
-			break;
+	for ( int i = 0 ; i < MAX_FRAME_ARENAS ; i++ ) {
+		frameArena_t *arena = &frame->arenas[i];
+		int arenaCount = 0;
+
+		for ( block = arena->memory ; block ; block=block->next ) {
+			arenaCount += block->used;
+			if ( block == arena->alloc ) {
+				break;
+			}
 		}
+		if ( arenaCount > arena->memoryHighwater ) {
+			arena->memoryHighwater = arenaCount;
+		}
+		count += arenaCount;
 	}
 
 	// note if this is a new highwater mark
@@ -293,6 +362,7 @@ R_StaticAlloc
 */
 void *R_StaticAlloc( int bytes ) {
 	void	*buf;
+	idScopedAllocatorLock lock;
 
 	tr.pc.c_alloc++;
 
@@ -326,6 +396,8 @@ R_StaticFree
 =================
 */
 void R_StaticFree( void *data ) {
+	idScopedAllocatorLock lock;
+
 	tr.pc.c_free++;
     Mem_Free( data );
 }
@@ -337,12 +409,10 @@ R_FrameAlloc
 This data will be automatically freed when the
 current frame's back end completes.
 
-This should only be called by the front end.  The
-back end shouldn't need to allocate memory.
-
-If we passed smpFrame in, the back end could
-alloc memory, because it will always be a
-different frameData than the front end is using.
+This should only be called by the front end, including
+its job threads.  Every thread allocates from its own
+arena, so no locking is needed.  The back end shouldn't
+need to allocate memory.
 
 All temporary data, like dynamic tesselations
 and local spaces are allocated here.
@@ -352,50 +422,46 @@ contiguous with previous allocations even
 from this frame.
 
 The memory is NOT zero filled.
-Should part of this be inlined in a macro?
 ================
 */
 void *R_FrameAlloc( int bytes ) {
-	frameData_t		*frame;
+	frameArena_t		*arena;
 	frameMemoryBlock_t	*block;
 	void			*buf;
     
 	bytes = (bytes+16)&~15;
 	// see if it can be satisfied in the current block
-	frame = frameData;
-	block = frame->alloc;
+	const int threadIndex = parallelJobManager->GetThreadIndex();
+	arena = &frameData->arenas[threadIndex];
+	block = arena->alloc;
 
-	if ( block->size - block->used >= bytes ) {
+	if ( block && block->size - block->used >= bytes ) {
 		buf = block->base + block->used;
 		block->used += bytes;
 		return buf;
 	}
 
 	// advance to the next memory block if available
-	block = block->next;
+	block = block ? block->next : arena->memory;
 	// create a new block if we are at the end of
-	// the chain
-	if ( !block ) {
-		int		size;
-
-		size = MEMORY_BLOCK_SIZE;
-		block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-		if ( !block ) {
-			common->FatalError( "R_FrameAlloc: Mem_Alloc() failed" );
+	// the chain, or the next one is too small
+	if ( !block || block->size < bytes ) {
+		int size = ( threadIndex == 0 ) ? MEMORY_BLOCK_SIZE : JOB_MEMORY_BLOCK_SIZE;
+		if ( bytes > size ) {
+			size = ( bytes + MEMORY_BLOCK_ROUND - 1 ) & ~( MEMORY_BLOCK_ROUND - 1 );
 		}
-		block->size = size;
-		block->used = 0;
-		block->next = NULL;
-		frame->alloc->next = block;
-	}
 
-	// we could fix this if we needed to...
-	if ( bytes > block->size ) {
-		common->FatalError( "R_FrameAlloc of %i exceeded MEMORY_BLOCK_SIZE",
-			bytes );
+		frameMemoryBlock_t *newBlock = R_AllocFrameMemoryBlock( size );
+		newBlock->next = block;
+		if ( arena->alloc ) {
+			arena->alloc->next = newBlock;
+		} else {
+			arena->memory = newBlock;
+		}
+		block = newBlock;
 	}
 
-	frame->alloc = block;
+	arena->alloc = block;
 
 	block->used = bytes;
 
@@ -1092,6 +1158,8 @@ void R_RenderView( viewDef_t *parms ) {
 		return;
 	}
 
+	PROFILE_ZONE( R_RenderView );
+
 	tr.viewCount++;
 
 	// save view in case we are a subview
@@ -1119,6 +1187,10 @@ void R_RenderView( viewDef_t *parms ) {
 	// constrain the view frustum to the view lights and entities
 	R_ConstrainViewFrustum();
 
+	// rasterize the large opaque surfaces of the view so the lights
+	// and entities hidden behind them can be skipped
+	R_RenderOcclusionBuffer();
+
 	// make sure that interactions exist for all light / entity combinations
 	// that are visible
 	// add any pre-generated light shadows, and calculate the light shader values
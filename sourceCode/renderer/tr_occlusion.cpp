@@ -0,0 +1,439 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "tr_local.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#define OCCLUSION_SSE
+#include <xmmintrin.h>
+#endif
+
+/*
+===============================================================================
+
+	Software occlusion culling
+
+	After the portal pass found the visible entities and lights of a view, the
+	large opaque surfaces among them (the world areas and entities flagged as
+	occluders) are rasterized into a small depth buffer on the CPU. Entities
+	and lights whose screen bounds are completely behind it are dropped before
+	their interactions and shadow volumes are generated.
+
+	The buffer stores 1/w. A pixel is only covered if the whole pixel is inside
+	the triangle, and gets the farthest depth of the triangle inside the pixel,
+	so the buffer never claims more occlusion than there is.
+
+===============================================================================
+*/
+
+const int OCCLUSION_WIDTH		= 256;
+const int OCCLUSION_HEIGHT		= 128;
+
+static float *		occlusionBuffer;			// OCCLUSION_WIDTH * OCCLUSION_HEIGHT 1/w values, 0 is empty
+static bool			occlusionValid;				// the buffer belongs to tr.viewDef
+static const viewDef_t *occlusionView;
+static float		occlusionMVP[16];			// world to clip space of the view
+static idList<idVec4> occlusionVerts;			// clip space vertexes of the current occluder surface
+
+/*
+================
+R_OcclusionTransform
+================
+*/
+static ID_INLINE void R_OcclusionTransform( const float m[16], const idVec3 &in, idVec4 &out ) {
+	out[0] = in[0] * m[0] + in[1] * m[4] + in[2] * m[8] + m[12];
+	out[1] = in[0] * m[1] + in[1] * m[5] + in[2] * m[9] + m[13];
+	out[2] = in[0] * m[2] + in[1] * m[6] + in[2] * m[10] + m[14];
+	out[3] = in[0] * m[3] + in[1] * m[7] + in[2] * m[11] + m[15];
+}
+
+/*
+================
+R_RasterizeOccluderTriangle
+
+The vertexes are in clip space, in front of the near plane.
+================
+*/
+static void R_RasterizeOccluderTriangle( const idVec4 &v0, const idVec4 &v1, const idVec4 &v2 ) {
+	float x[3], y[3], iw[3];
+	const idVec4 *v[3] = { &v0, &v1, &v2 };
+
+	for ( int i = 0; i < 3; i++ ) {
+		iw[i] = 1.0f / (*v[i])[3];
+		x[i] = ( (*v[i])[0] * iw[i] * 0.5f + 0.5f ) * OCCLUSION_WIDTH;
+		y[i] = ( (*v[i])[1] * iw[i] * 0.5f + 0.5f ) * OCCLUSION_HEIGHT;
+	}
+
+	float area = ( x[1] - x[0] ) * ( y[2] - y[0] ) - ( x[2] - x[0] ) * ( y[1] - y[0] );
+	if ( idMath::Fabs( area ) < 0.25f ) {
+		return;		// can't fully cover any pixel
+	}
+	if ( area < 0.0f ) {
+		// occluders are two sided
+		idSwap( x[1], x[2] );
+		idSwap( y[1], y[2] );
+		idSwap( iw[1], iw[2] );
+		area = -area;
+	}
+
+	const int minX = idMath::ClampInt( 0, OCCLUSION_WIDTH, idMath::FtoiFast( idMath::Floor( Min3( x[0], x[1], x[2] ) ) ) );
+	const int maxX = idMath::ClampInt( 0, OCCLUSION_WIDTH, idMath::FtoiFast( idMath::Ceil( Max3( x[0], x[1], x[2] ) ) ) );
+	const int minY = idMath::ClampInt( 0, OCCLUSION_HEIGHT, idMath::FtoiFast( idMath::Floor( Min3( y[0], y[1], y[2] ) ) ) );
+	const int maxY = idMath::ClampInt( 0, OCCLUSION_HEIGHT, idMath::FtoiFast( idMath::Ceil( Max3( y[0], y[1], y[2] ) ) ) );
+	if ( minX >= maxX || minY >= maxY ) {
+		return;
+	}
+
+	// edge functions that are positive inside, moved in by half a pixel so
+	// testing a pixel center tells if the whole pixel is covered
+	float ea[3], eb[3], ec[3];
+	for ( int i = 0; i < 3; i++ ) {
+		const int j = ( i + 1 ) % 3;
+		ea[i] = y[i] - y[j];
+		eb[i] = x[j] - x[i];
+		ec[i] = -( ea[i] * x[i] + eb[i] * y[i] ) - 0.5f * ( idMath::Fabs( ea[i] ) + idMath::Fabs( eb[i] ) );
+	}
+
+	// 1/w is linear in screen space, take its smallest value inside each pixel
+	const float invArea = 1.0f / area;
+	const float ia = ( ( iw[1] - iw[0] ) * ( y[2] - y[0] ) - ( iw[2] - iw[0] ) * ( y[1] - y[0] ) ) * invArea;
+	const float ib = ( ( iw[2] - iw[0] ) * ( x[1] - x[0] ) - ( iw[1] - iw[0] ) * ( x[2] - x[0] ) ) * invArea;
+	const float ic = iw[0] - ia * x[0] - ib * y[0] - 0.5f * ( idMath::Fabs( ia ) + idMath::Fabs( ib ) );
+
+	tr.pc.c_occluderTris++;
+
+	const int startX = minX & ~3;
+
+#ifdef OCCLUSION_SSE
+	if ( SIMDProcessor->cpuid & CPUID_SSE ) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 offsets = _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f );
+		const __m128 step = _mm_set1_ps( 4.0f );
+		const __m128 ea0 = _mm_set1_ps( ea[0] ), ea1 = _mm_set1_ps( ea[1] ), ea2 = _mm_set1_ps( ea[2] );
+		const __m128 iaV = _mm_set1_ps( ia );
+
+		for ( int py = minY; py < maxY; py++ ) {
+			const float cy = py + 0.5f;
+			const __m128 c0 = _mm_set1_ps( eb[0] * cy + ec[0] );
+			const __m128 c1 = _mm_set1_ps( eb[1] * cy + ec[1] );
+			const __m128 c2 = _mm_set1_ps( eb[2] * cy + ec[2] );
+			const __m128 cw = _mm_set1_ps( ib * cy + ic );
+			float *row = occlusionBuffer + py * OCCLUSION_WIDTH;
+			__m128 cx = _mm_add_ps( _mm_set1_ps( (float)startX ), offsets );
+
+			for ( int px = startX; px < maxX; px += 4 ) {
+				__m128 inside = _mm_cmpge_ps( _mm_add_ps( _mm_mul_ps( ea0, cx ), c0 ), zero );
+				inside = _mm_and_ps( inside, _mm_cmpge_ps( _mm_add_ps( _mm_mul_ps( ea1, cx ), c1 ), zero ) );
+				inside = _mm_and_ps( inside, _mm_cmpge_ps( _mm_add_ps( _mm_mul_ps( ea2, cx ), c2 ), zero ) );
+
+				if ( _mm_movemask_ps( inside ) ) {
+					const __m128 depth = _mm_and_ps( inside, _mm_add_ps( _mm_mul_ps( iaV, cx ), cw ) );
+					_mm_store_ps( row + px, _mm_max_ps( _mm_load_ps( row + px ), depth ) );
+				}
+				cx = _mm_add_ps( cx, step );
+			}
+		}
+		return;
+	}
+#endif
+
+	for ( int py = minY; py < maxY; py++ ) {
+		const float cy = py + 0.5f;
+		float *row = occlusionBuffer + py * OCCLUSION_WIDTH;
+
+		for ( int px = startX; px < maxX; px++ ) {
+			const float cx = px + 0.5f;
+			if ( ea[0] * cx + eb[0] * cy + ec[0] < 0.0f || ea[1] * cx + eb[1] * cy + ec[1] < 0.0f || ea[2] * cx + eb[2] * cy + ec[2] < 0.0f ) {
+				continue;
+			}
+			const float depth = ia * cx + ib * cy + ic;
+			if ( depth > row[px] ) {
+				row[px] = depth;
+			}
+		}
+	}
+}
+
+/*
+================
+R_RasterizeOccluderSurface
+================
+*/
+static void R_RasterizeOccluderSurface( const srfTriangles_t *tri, const float mvp[16] ) {
+	const float zNear = r_znear.GetFloat();
+
+	occlusionVerts.SetNum( tri->numVerts, false );
+	for ( int i = 0; i < tri->numVerts; i++ ) {
+		R_OcclusionTransform( mvp, tri->verts[i].xyz, occlusionVerts[i] );
+	}
+
+	for ( int i = 0; i < tri->numIndexes; i += 3 ) {
+		const idVec4 *v[3] = { &occlusionVerts[ tri->indexes[i+0] ], &occlusionVerts[ tri->indexes[i+1] ], &occlusionVerts[ tri->indexes[i+2] ] };
+
+		const int numBehind = ( (*v[0])[3] < zNear ) + ( (*v[1])[3] < zNear ) + ( (*v[2])[3] < zNear );
+		if ( numBehind == 0 ) {
+			R_RasterizeOccluderTriangle( *v[0], *v[1], *v[2] );
+			continue;
+		}
+		if ( numBehind == 3 ) {
+			continue;
+		}
+
+		// clip to the near plane
+		idVec4 clipped[4];
+		int numClipped = 0;
+		for ( int j = 0; j < 3; j++ ) {
+			const idVec4 &a = *v[j];
+			const idVec4 &b = *v[( j + 1 ) % 3];
+			const float da = a[3] - zNear;
+			const float db = b[3] - zNear;
+
+			if ( da >= 0.0f ) {
+				clipped[numClipped++] = a;
+			}
+			if ( ( da >= 0.0f ) != ( db >= 0.0f ) ) {
+				const float f = da / ( da - db );
+				clipped[numClipped] = a + ( b - a ) * f;
+				clipped[numClipped][3] = zNear;
+				numClipped++;
+			}
+		}
+		for ( int j = 2; j < numClipped; j++ ) {
+			R_RasterizeOccluderTriangle( clipped[0], clipped[j-1], clipped[j] );
+		}
+	}
+}
+
+/*
+================
+R_IsOccluder
+================
+*/
+static bool R_IsOccluder( const viewEntity_t *vEntity ) {
+	const idRenderEntityLocal *def = vEntity->entityDef;
+
+	if ( vEntity->scissorRect.IsEmpty() ) {
+		return false;
+	}
+	if ( def->parms.hModel == NULL || def->parms.hModel->IsDynamicModel() != DM_STATIC ) {
+		return false;
+	}
+	// the world areas are the first entity defs
+	if ( def->index < def->world->numPortalAreas ) {
+		return true;
+	}
+	return def->parms.occluder && !def->parms.weaponDepthHack && def->parms.modelDepthHack == 0.0f;
+}
+
+/*
+================
+R_RenderOcclusionBuffer
+
+Rasterizes the occluders of the view, called after the visible entities and lights are known.
+================
+*/
+void R_RenderOcclusionBuffer( void ) {
+	occlusionValid = false;
+
+	if ( !r_useSoftOcclusion.GetBool() || tr.viewDef->isXraySubview || tr.viewDef->isEditor ) {
+		return;
+	}
+	// geometry in front of a mirror plane is clipped away
+	if ( tr.viewDef->numClipPlanes != 0 ) {
+		return;
+	}
+
+	if ( occlusionBuffer == NULL ) {
+		occlusionBuffer = (float *)Mem_Alloc16( OCCLUSION_WIDTH * OCCLUSION_HEIGHT * sizeof( float ) );
+	}
+	memset( occlusionBuffer, 0, OCCLUSION_WIDTH * OCCLUSION_HEIGHT * sizeof( float ) );
+
+	myGlMultMatrix( tr.viewDef->worldSpace.modelViewMatrix, tr.viewDef->projectionMatrix, occlusionMVP );
+
+	const float minSize = r_softOcclusionMinSize.GetFloat();
+
+	for ( const viewEntity_t *vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		if ( !R_IsOccluder( vEntity ) ) {
+			continue;
+		}
+		const idRenderEntityLocal *def = vEntity->entityDef;
+		const idRenderModel *model = def->parms.hModel;
+		float mvp[16];
+
+		myGlMultMatrix( def->modelMatrix, occlusionMVP, mvp );
+
+		for ( int i = 0; i < model->NumSurfaces(); i++ ) {
+			const modelSurface_t *surf = model->Surface( i );
+			const srfTriangles_t *tri = surf->geometry;
+			const idMaterial *shader = R_RemapShaderBySkin( surf->shader, def->parms.customSkin, def->parms.customShader );
+
+			if ( !tri || !tri->verts || !tri->numIndexes || !shader ) {
+				continue;
+			}
+			if ( !shader->IsDrawn() || shader->Coverage() != MC_OPAQUE || shader->Deform() != DFRM_NONE ) {
+				continue;
+			}
+
+			// skip the surfaces that are small on screen
+			idVec3 center;
+			R_LocalPointToGlobal( def->modelMatrix, tri->bounds.GetCenter(), center );
+			const float radius = tri->bounds.GetRadius( tri->bounds.GetCenter() );
+			if ( radius < ( center - tr.viewDef->renderView.vieworg ).LengthFast() * minSize ) {
+				continue;
+			}
+			if ( R_CullLocalBox( tri->bounds, def->modelMatrix, 5, tr.viewDef->frustum ) ) {
+				continue;
+			}
+
+			R_RasterizeOccluderSurface( tri, mvp );
+		}
+	}
+
+	occlusionValid = true;
+	occlusionView = tr.viewDef;
+
+	// keep a copy for the debug view of the main view
+	if ( r_showSoftOcclusion.GetBool() && !tr.viewDef->isSubview ) {
+		byte *image = (byte *)R_FrameAlloc( OCCLUSION_WIDTH * OCCLUSION_HEIGHT * 4 );
+		for ( int i = 0; i < OCCLUSION_WIDTH * OCCLUSION_HEIGHT; i++ ) {
+			// near is bright
+			const float w = occlusionBuffer[i] > 0.0f ? 1.0f / occlusionBuffer[i] : idMath::INFINITY;
+			const byte b = ( occlusionBuffer[i] > 0.0f ) ? (byte)idMath::ClampInt( 32, 255, idMath::FtoiFast( 255.0f - w * 0.1f ) ) : 0;
+			image[i*4+0] = b;
+			image[i*4+1] = b;
+			image[i*4+2] = b;
+			image[i*4+3] = 255;
+		}
+		tr.viewDef->softOcclusionImage = image;
+		tr.viewDef->softOcclusionWidth = OCCLUSION_WIDTH;
+		tr.viewDef->softOcclusionHeight = OCCLUSION_HEIGHT;
+	}
+}
+
+/*
+================
+R_OcclusionCullBox
+
+Returns true if the box is completely hidden behind the occluders of the view.
+A NULL modelMatrix means the bounds are in world space.
+================
+*/
+bool R_OcclusionCullBox( const idBounds &bounds, const float modelMatrix[16] ) {
+	if ( !occlusionValid || occlusionView != tr.viewDef ) {
+		return false;
+	}
+
+	float mvp[16];
+	const float *m = occlusionMVP;
+	if ( modelMatrix ) {
+		myGlMultMatrix( modelMatrix, occlusionMVP, mvp );
+		m = mvp;
+	}
+
+	// screen rectangle and nearest depth of the corners
+	const float zNear = r_znear.GetFloat();
+	float minX = idMath::INFINITY, minY = idMath::INFINITY, maxX = -idMath::INFINITY, maxY = -idMath::INFINITY;
+	float minW = idMath::INFINITY;
+
+	for ( int i = 0; i < 8; i++ ) {
+		idVec3 corner( bounds[i&1][0], bounds[(i>>1)&1][1], bounds[(i>>2)&1][2] );
+		idVec4 clip;
+
+		R_OcclusionTransform( m, corner, clip );
+		if ( clip[3] < zNear ) {
+			return false;	// reaches the near plane
+		}
+		const float iw = 1.0f / clip[3];
+		const float x = ( clip[0] * iw * 0.5f + 0.5f ) * OCCLUSION_WIDTH;
+		const float y = ( clip[1] * iw * 0.5f + 0.5f ) * OCCLUSION_HEIGHT;
+		minX = Min( minX, x );
+		maxX = Max( maxX, x );
+		minY = Min( minY, y );
+		maxY = Max( maxY, y );
+		minW = Min( minW, clip[3] );
+	}
+
+	const int x1 = idMath::ClampInt( 0, OCCLUSION_WIDTH, idMath::FtoiFast( idMath::Floor( minX ) ) );
+	const int x2 = idMath::ClampInt( 0, OCCLUSION_WIDTH, idMath::FtoiFast( idMath::Ceil( maxX ) ) );
+	const int y1 = idMath::ClampInt( 0, OCCLUSION_HEIGHT, idMath::FtoiFast( idMath::Floor( minY ) ) );
+	const int y2 = idMath::ClampInt( 0, OCCLUSION_HEIGHT, idMath::FtoiFast( idMath::Ceil( maxY ) ) );
+	if ( x1 >= x2 || y1 >= y2 ) {
+		return false;	// off screen, left to the frustum culling
+	}
+
+	// every pixel has to have an occluder in front of the nearest point
+	const float depth = ( 1.0f / minW ) * 1.0001f;
+
+#ifdef OCCLUSION_SSE
+	if ( SIMDProcessor->cpuid & CPUID_SSE ) {
+		const __m128 depthV = _mm_set1_ps( depth );
+		const int startX = x1 & ~3;
+		const int endX = ( x2 + 3 ) & ~3;
+		const int firstMask = 0xF << ( x1 - startX ) & 0xF;
+		const int lastMask = 0xF >> ( endX - x2 );
+
+		for ( int py = y1; py < y2; py++ ) {
+			const float *row = occlusionBuffer + py * OCCLUSION_WIDTH;
+			for ( int px = startX; px < endX; px += 4 ) {
+				int mask = 0xF;
+				if ( px == startX ) {
+					mask &= firstMask;
+				}
+				if ( px + 4 == endX ) {
+					mask &= lastMask;
+				}
+				// any pixel that isn't nearer than the box makes it visible
+				if ( _mm_movemask_ps( _mm_cmple_ps( _mm_load_ps( row + px ), depthV ) ) & mask ) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+#endif
+
+	for ( int py = y1; py < y2; py++ ) {
+		const float *row = occlusionBuffer + py * OCCLUSION_WIDTH;
+		for ( int px = x1; px < x2; px++ ) {
+			if ( row[px] <= depth ) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+================
+R_ShutdownOcclusionBuffer
+================
+*/
+void R_ShutdownOcclusionBuffer( void ) {
+	if ( occlusionBuffer ) {
+		Mem_Free16( occlusionBuffer );
+		occlusionBuffer = NULL;
+	}
+	occlusionVerts.Clear();
+	occlusionValid = false;
+}
@@ -467,6 +467,38 @@ void RB_ShowDepthBuffer( void ) {
 	R_StaticFree( depthReadback );
 }
 
+/*
+===================
+RB_ShowSoftOcclusion
+
+Draw the software occlusion buffer of the view in the lower left corner
+===================
+*/
+void RB_ShowSoftOcclusion( void ) {
+	if ( !r_showSoftOcclusion.GetBool() || !backEnd.viewDef->softOcclusionImage ) {
+		return;
+	}
+
+	qglPushMatrix();
+	qglLoadIdentity();
+	qglMatrixMode( GL_PROJECTION );
+	qglPushMatrix();
+	qglLoadIdentity(); 
+	qglOrtho( 0, 1, 0, 1, -1, 1 );
+	qglRasterPos2f( 0, 0 );
+	qglPopMatrix();
+	qglMatrixMode( GL_MODELVIEW );
+	qglPopMatrix();
+
+	GL_State( GLS_DEPTHFUNC_ALWAYS );
+	qglColor3f( 1, 1, 1 );
+	globalImages->BindNull();
+
+	qglPixelZoom( 2, 2 );
+	qglDrawPixels( backEnd.viewDef->softOcclusionWidth, backEnd.viewDef->softOcclusionHeight, GL_RGBA, GL_UNSIGNED_BYTE, backEnd.viewDef->softOcclusionImage );
+	qglPixelZoom( 1, 1 );
+}
+
 /*
 =================
 RB_ShowLightCount
@@ -2359,6 +2391,7 @@ void RB_RenderDebugTools( drawSurf_t **drawSurfs, int numDrawSurfs ) {
 	RB_ShowPortals();
 	RB_ShowSilhouette();
 	RB_ShowDepthBuffer();
+	RB_ShowSoftOcclusion();
 	RB_ShowIntensity();
 	RB_ShowDebugLines();
 	RB_ShowDebugText();
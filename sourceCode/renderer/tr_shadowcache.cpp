@@ -0,0 +1,269 @@
+/*****************************************************************************
+                    The Dark Mod GPL Source Code
+
+ This file is part of the The Dark Mod Source Code, originally based
+ on the Doom 3 GPL Source Code as published in 2011.
+
+ The Dark Mod Source Code is free software: you can redistribute it
+ and/or modify it under the terms of the GNU General Public License as
+ published by the Free Software Foundation, either version 3 of the License,
+ or (at your option) any later version. For details, see LICENSE.TXT.
+
+ Project: The Dark Mod (http://www.thedarkmod.com/)
+
+ $Revision$ (Revision of last commit)
+ $Date$ (Date of last commit)
+ $Author$ (Author of last commit)
+
+******************************************************************************/
+
+#include "precompiled_engine.h"
+#pragma hdrstop
+
+static bool versioned = RegisterVersionedFile("$Id$");
+
+#include "tr_local.h"
+
+/*
+===============================================================================
+
+	Shadow volume cache
+
+	Interactions are freed whenever their entity or light is updated, even if
+	only a shader parm changed, and their shadow volumes have to be built again
+	the next time the pair is in view. The shadow volumes of static models are
+	handed to this cache when an interaction frees its surfaces, and taken back
+	when an interaction for the same surface, entity transform, light shape and
+	shadow volume type is created again.
+
+	A shadow volume is owned either by one interaction or by the cache, never
+	by both. The cached volumes are kept in an LRU list, the least recently
+	stored volumes are freed when the cache grows beyond r_shadowCacheSize.
+
+===============================================================================
+*/
+
+#define SHADOW_CACHE_HASH_SIZE	1024
+
+typedef struct {
+	const srfTriangles_t *	tri;				// surface of a static model
+	int						numIndexes;
+	int						shadowType;			// R_ShadowVolumeType when the volume was created
+	float					modelMatrix[16];
+	idVec3					lightOrigin;
+	idPlane					lightFrustum[6];
+	idVec3					lightCenter;
+	bool					pointLight;
+	bool					parallel;
+	bool					allCaps;			// the external shadow optimizations can't be used
+} shadowCacheKey_t;
+
+typedef struct shadowCacheEntry_s {
+	shadowCacheKey_t		key;
+	srfTriangles_t *		shadowTris;
+	int						memory;
+	int						hash;
+	struct shadowCacheEntry_s *hashNext;		// for hash chains to speed lookup
+	struct shadowCacheEntry_s *next, *prev;		// LRU list, shadowCacheEntries.next is the most recently stored
+} shadowCacheEntry_t;
+
+static idBlockAlloc<shadowCacheEntry_t, 256>	shadowCacheAllocator;
+static shadowCacheEntry_t *		shadowCacheHashTable[SHADOW_CACHE_HASH_SIZE];
+static shadowCacheEntry_t		shadowCacheEntries;		// head of doubly linked list, linked when the first volume is stored
+static int						shadowCacheMemory;
+static int						shadowCacheNumVolumes;
+
+/*
+================
+R_ShadowVolumeType
+
+The kind of shadow volume R_CreateShadowVolume builds for the shadow generation
+with the current shadow cvars. Volumes of a different type must not be reused.
+================
+*/
+int R_ShadowVolumeType( shadowGen_t shadowGen ) {
+	int type = shadowGen;
+
+	if ( shadowGen == SG_DYNAMIC && r_useTurboShadow.GetBool() ) {
+		type |= BIT( 2 );
+		if ( tr.backEndRendererHasVertexPrograms && r_useShadowVertexProgram.GetBool() ) {
+			type |= BIT( 3 );
+		}
+	}
+	if ( r_useShadowProjectedCull.GetBool() ) {
+		type |= BIT( 4 );
+	}
+	return type;
+}
+
+/*
+================
+R_ShadowCacheKey
+================
+*/
+static void R_ShadowCacheKey( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idMaterial *shader, const idRenderLightLocal *light, int shadowType, shadowCacheKey_t &key ) {
+	// cleared so padding doesn't break the memcmp
+	memset( &key, 0, sizeof( key ) );
+
+	key.tri = tri;
+	key.numIndexes = tri->numIndexes;
+	key.shadowType = shadowType;
+	memcpy( key.modelMatrix, ent->modelMatrix, sizeof( key.modelMatrix ) );
+	key.lightOrigin = light->globalLightOrigin;
+	for ( int i = 0; i < 6; i++ ) {
+		key.lightFrustum[i] = light->frustum[i];
+	}
+	key.lightCenter = light->parms.lightCenter;
+	key.pointLight = light->parms.pointLight;
+	key.parallel = light->parms.parallel;
+	key.allCaps = ( shader->Coverage() != MC_OPAQUE || ( !r_skipSuppress.GetBool() && ent->parms.suppressSurfaceInViewID ) );
+}
+
+/*
+================
+R_ShadowCacheHash
+================
+*/
+static int R_ShadowCacheHash( const shadowCacheKey_t &key ) {
+	const int *origin = reinterpret_cast<const int *>( key.lightOrigin.ToFloatPtr() );
+	const int *matrix = reinterpret_cast<const int *>( key.modelMatrix );
+	const int hash = (int)( (intptr_t)key.tri >> 4 ) ^ origin[0] ^ ( origin[1] << 1 ) ^ ( origin[2] << 2 ) ^ matrix[12] ^ matrix[13] ^ matrix[14] ^ key.shadowType;
+	return ( hash ^ ( hash >> 10 ) ^ ( hash >> 20 ) ) & ( SHADOW_CACHE_HASH_SIZE - 1 );
+}
+
+/*
+================
+R_RemoveShadowCacheEntry
+
+Does not free the shadow volume of the entry.
+================
+*/
+static void R_RemoveShadowCacheEntry( shadowCacheEntry_t *entry ) {
+	shadowCacheEntry_t **link;
+
+	for ( link = &shadowCacheHashTable[entry->hash]; *link != entry; link = &(*link)->hashNext ) {
+	}
+	*link = entry->hashNext;
+
+	entry->next->prev = entry->prev;
+	entry->prev->next = entry->next;
+
+	shadowCacheMemory -= entry->memory;
+	shadowCacheNumVolumes--;
+
+	shadowCacheAllocator.Free( entry );
+}
+
+/*
+================
+R_FindCachedShadowVolume
+
+Returns a cached shadow volume of the given R_ShadowVolumeType for the surface of
+the entity and the light, which is then owned by the caller, or NULL.
+================
+*/
+srfTriangles_t *R_FindCachedShadowVolume( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idMaterial *shader, const idRenderLightLocal *light, int shadowType ) {
+	if ( shadowCacheNumVolumes == 0 || !r_useShadowCache.GetBool() ) {
+		return NULL;
+	}
+
+	shadowCacheKey_t key;
+	R_ShadowCacheKey( ent, tri, shader, light, shadowType, key );
+
+	for ( shadowCacheEntry_t *entry = shadowCacheHashTable[R_ShadowCacheHash( key )]; entry != NULL; entry = entry->hashNext ) {
+		if ( memcmp( &entry->key, &key, sizeof( key ) ) != 0 ) {
+			continue;
+		}
+		srfTriangles_t *shadowTris = entry->shadowTris;
+		R_RemoveShadowCacheEntry( entry );
+		tr.pc.c_cachedShadowVolumes++;
+		return shadowTris;
+	}
+	return NULL;
+}
+
+/*
+================
+R_CacheShadowVolume
+
+Called when an interaction frees its surfaces, shadowType is the R_ShadowVolumeType
+the volume was created with. Returns true if the cache took over the shadow volume,
+otherwise the caller has to free it.
+================
+*/
+bool R_CacheShadowVolume( const idRenderEntityLocal *ent, const srfTriangles_t *tri, const idMaterial *shader, const idRenderLightLocal *light, int shadowType, srfTriangles_t *shadowTris ) {
+	if ( !r_useShadowCache.GetBool() ) {
+		return false;
+	}
+	// only the surfaces of static models stay around
+	if ( tri == NULL || shader == NULL || ent->parms.hModel == NULL || ent->parms.hModel->IsDynamicModel() != DM_STATIC ) {
+		return false;
+	}
+	if ( ent->parms.callback ) {
+		return false;
+	}
+
+	const int maxMemory = r_shadowCacheSize.GetInteger() * 1024 * 1024;
+	const int memory = R_TriSurfMemory( shadowTris );
+	if ( memory > maxMemory ) {
+		return false;
+	}
+
+	// make room by freeing the least recently stored volumes at the end of the list
+	while ( shadowCacheNumVolumes > 0 && shadowCacheMemory + memory > maxMemory ) {
+		shadowCacheEntry_t *oldest = shadowCacheEntries.prev;
+		R_FreeStaticTriSurf( oldest->shadowTris );
+		R_RemoveShadowCacheEntry( oldest );
+	}
+
+	shadowCacheEntry_t *entry = shadowCacheAllocator.Alloc();
+	R_ShadowCacheKey( ent, tri, shader, light, shadowType, entry->key );
+	entry->shadowTris = shadowTris;
+	entry->memory = memory;
+
+	entry->hash = R_ShadowCacheHash( entry->key );
+	entry->hashNext = shadowCacheHashTable[entry->hash];
+	shadowCacheHashTable[entry->hash] = entry;
+
+	// link at the head of the LRU list
+	if ( shadowCacheEntries.next == NULL ) {
+		shadowCacheEntries.next = shadowCacheEntries.prev = &shadowCacheEntries;
+	}
+	entry->next = shadowCacheEntries.next;
+	entry->prev = &shadowCacheEntries;
+	shadowCacheEntries.next->prev = entry;
+	shadowCacheEntries.next = entry;
+
+	shadowCacheMemory += memory;
+	shadowCacheNumVolumes++;
+
+	return true;
+}
+
+/*
+================
+R_PurgeShadowCache
+
+Frees all cached shadow volumes, needed whenever models are freed or reloaded.
+================
+*/
+void R_PurgeShadowCache( void ) {
+	while ( shadowCacheNumVolumes > 0 ) {
+		shadowCacheEntry_t *entry = shadowCacheEntries.next;
+		R_FreeStaticTriSurf( entry->shadowTris );
+		R_RemoveShadowCacheEntry( entry );
+	}
+	shadowCacheAllocator.Shutdown();
+}
+
+/*
+================
+R_ShadowCacheMemory
+================
+*/
+int R_ShadowCacheMemory( int *numVolumes ) {
+	if ( numVolumes ) {
+		*numVolumes = shadowCacheNumVolumes;
+	}
+	return shadowCacheMemory;
+}
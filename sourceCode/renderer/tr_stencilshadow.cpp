@@ -1209,7 +1209,8 @@ generated by the triangle irregardless of if it actually was a sil edge.
 */
 srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 									 const srfTriangles_t *tri, const idRenderLightLocal *light,
-									 shadowGen_t optimize, srfCullInfo_t &cullInfo ) {
+									 shadowGen_t optimize, srfCullInfo_t &cullInfo,
+									 interactionCounts_t *counts ) {
 	int		i, j;
 	idVec3	lightOrigin;
 	srfTriangles_t	*newTri;
@@ -1231,8 +1232,6 @@ srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 		common->Error( "R_CreateShadowVolume: tri->numVerts = %i", tri->numVerts );
 	}
 
-	tr.pc.c_createShadowVolumes++;
-
 	// use the fast infinite projection in dynamic situations, which
 	// trades somewhat more overdraw and no cap optimizations for
 	// a very simple generation process
@@ -1240,7 +1239,7 @@ srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 		if ( tr.backEndRendererHasVertexPrograms && r_useShadowVertexProgram.GetBool() ) {
 			return R_CreateVertexProgramTurboShadowVolume( ent, tri, light, cullInfo );
 		} else {
-			return R_CreateTurboShadowVolume( ent, tri, light, cullInfo );
+			return R_CreateTurboShadowVolume( ent, tri, light, cullInfo, counts );
 		}
 	}
 
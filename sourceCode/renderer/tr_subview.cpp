@@ -216,6 +216,7 @@ static viewDef_t *R_MirrorViewBySurface( drawSurf_t *drawSurf ) {
 	parms->renderView.viewID = 0;	// clear to allow player bodies to show up, and suppress view weapons
 
 	parms->isSubview = true;
+	parms->softOcclusionImage = NULL;	// r_showSoftOcclusion only draws the buffer of the main view
 	parms->isMirror = true;
 
 	// create plane axis for the portal we are seeing
@@ -270,6 +271,7 @@ static viewDef_t *R_XrayViewBySurface( drawSurf_t *drawSurf ) {
 	parms->renderView.viewID = 0;	// clear to allow player bodies to show up, and suppress view weapons
 
 	parms->isSubview = true;
+	parms->softOcclusionImage = NULL;	// r_showSoftOcclusion only draws the buffer of the main view
 	parms->isXraySubview = true;
 
 	return parms;
@@ -298,6 +300,7 @@ static void R_RemoteRender( drawSurf_t *surf, textureStage_t *stage ) {
 	*parms = *tr.viewDef;
 
 	parms->isSubview = true;
+	parms->softOcclusionImage = NULL;	// r_showSoftOcclusion only draws the buffer of the main view
 	parms->isMirror = false;
 
 	parms->renderView = *surf->space->entityDef->parms.remoteRenderView;
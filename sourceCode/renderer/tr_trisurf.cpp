@@ -117,6 +117,8 @@ static silEdge_t *	silEdges;
 static idHashIndex	silEdgeHash( SILEDGE_HASH_SIZE, MAX_SIL_EDGES );
 static int			numPlanes;
 
+// the interaction jobs allocate light and shadow surfaces from several threads,
+// so the allocators below are serialized with idScopedAllocatorLock
 static idBlockAlloc<srfTriangles_t, 1<<8>				srfTrianglesAllocator;
 
 #ifdef USE_TRI_DATA_ALLOCATOR
@@ -365,6 +367,8 @@ This does the actual free
 ==============
 */
 void R_ReallyFreeStaticTriSurf( srfTriangles_t *tri ) {
+	idScopedAllocatorLock lock;
+
 	if ( !tri ) {
 		return;
 	}
@@ -480,6 +484,8 @@ This will defer the free until the current frame has run through the back end.
 ==============
 */
 void R_FreeStaticTriSurf( srfTriangles_t *tri ) {
+	idScopedAllocatorLock lock;
+
 	frameData_t		*frame;
 
 	if ( !tri ) {
@@ -514,6 +520,7 @@ R_AllocStaticTriSurf
 ==============
 */
 srfTriangles_t *R_AllocStaticTriSurf( void ) {
+	idScopedAllocatorLock lock;
 	srfTriangles_t *tris = srfTrianglesAllocator.Alloc();
 	memset( tris, 0, sizeof( srfTriangles_t ) );
 	return tris;
@@ -546,6 +553,7 @@ R_AllocStaticTriSurfVerts
 =================
 */
 void R_AllocStaticTriSurfVerts( srfTriangles_t *tri, int numVerts ) {
+	idScopedAllocatorLock lock;
 	assert( tri->verts == NULL );
 	tri->verts = triVertexAllocator.Alloc( numVerts );
 }
@@ -556,6 +564,7 @@ R_AllocStaticTriSurfIndexes
 =================
 */
 void R_AllocStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes ) {
+	idScopedAllocatorLock lock;
 	assert( tri->indexes == NULL );
 	tri->indexes = triIndexAllocator.Alloc( numIndexes );
 }
@@ -566,6 +575,7 @@ R_AllocStaticTriSurfShadowVerts
 =================
 */
 void R_AllocStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts ) {
+	idScopedAllocatorLock lock;
 	assert( tri->shadowVertexes == NULL );
 	tri->shadowVertexes = triShadowVertexAllocator.Alloc( numVerts );
 }
@@ -576,6 +586,7 @@ R_AllocStaticTriSurfPlanes
 =================
 */
 void R_AllocStaticTriSurfPlanes( srfTriangles_t *tri, int numIndexes ) {
+	idScopedAllocatorLock lock;
 	if ( tri->facePlanes ) {
 		triPlaneAllocator.Free( tri->facePlanes );
 	}
@@ -588,6 +599,7 @@ R_ResizeStaticTriSurfVerts
 =================
 */
 void R_ResizeStaticTriSurfVerts( srfTriangles_t *tri, int numVerts ) {
+	idScopedAllocatorLock lock;
 #ifdef USE_TRI_DATA_ALLOCATOR
 	tri->verts = triVertexAllocator.Resize( tri->verts, numVerts );
 #else
@@ -601,6 +613,7 @@ R_ResizeStaticTriSurfIndexes
 =================
 */
 void R_ResizeStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes ) {
+	idScopedAllocatorLock lock;
 #ifdef USE_TRI_DATA_ALLOCATOR
 	tri->indexes = triIndexAllocator.Resize( tri->indexes, numIndexes );
 #else
@@ -614,6 +627,7 @@ R_ResizeStaticTriSurfShadowVerts
 =================
 */
 void R_ResizeStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts ) {
+	idScopedAllocatorLock lock;
 #ifdef USE_TRI_DATA_ALLOCATOR
 	tri->shadowVertexes = triShadowVertexAllocator.Resize( tri->shadowVertexes, numVerts );
 #else
@@ -645,6 +659,7 @@ R_FreeStaticTriSurfSilIndexes
 =================
 */
 void R_FreeStaticTriSurfSilIndexes( srfTriangles_t *tri ) {
+	idScopedAllocatorLock lock;
 	triSilIndexAllocator.Free( tri->silIndexes );
 	tri->silIndexes = NULL;
 }
@@ -1637,7 +1652,7 @@ This is called once for static surfaces, and every frame for deforming surfaces
 Builds tangents, normals, and face planes
 ==================
 */
-void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
+void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes, int *tangentIndexes ) {
 	int				i;
 	idPlane			*planes;
 
@@ -1650,7 +1665,11 @@ void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
 		return;
 	}
 
-	tr.pc.c_tangentIndexes += tri->numIndexes;
+	if ( tangentIndexes ) {
+		*tangentIndexes += tri->numIndexes;
+	} else {
+		tr.pc.c_tangentIndexes += tri->numIndexes;
+	}
 
 	if ( !tri->facePlanes && allocFacePlanes ) {
 		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
@@ -179,7 +179,7 @@ R_CreateTurboShadowVolume
 */
 srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 											const srfTriangles_t *tri, const idRenderLightLocal *light,
-											srfCullInfo_t &cullInfo ) {
+											srfCullInfo_t &cullInfo, interactionCounts_t *counts ) {
 	int		i, j;
 	idVec3	localLightOrigin;
 	srfTriangles_t	*newTri;
@@ -258,8 +258,14 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 
 	newTri->numVerts = SIMDProcessor->CreateShadowCache( &shadowVerts->xyz, vertRemap, localLightOrigin, tri->verts, tri->numVerts );
 
-	c_turboUsedVerts += newTri->numVerts;
-	c_turboUnusedVerts += tri->numVerts * 2 - newTri->numVerts;
+	// the interaction jobs count per job, see R_CreateQueuedInteractions
+	if ( counts ) {
+		counts->turboUsedVerts += newTri->numVerts;
+		counts->turboUnusedVerts += tri->numVerts * 2 - newTri->numVerts;
+	} else {
+		c_turboUsedVerts += newTri->numVerts;
+		c_turboUnusedVerts += tri->numVerts * 2 - newTri->numVerts;
+	}
 
 #ifdef USE_TRI_DATA_ALLOCATOR
 	R_ResizeStaticTriSurfShadowVerts( newTri, newTri->numVerts );
@@ -625,6 +625,8 @@ idSoundSample::PurgeSoundSample
 void idSoundSample::PurgeSoundSample() {
 	purged = true;
 
+	idSampleDecoder::PurgeSample( this );
+
 	if ( hardwareBuffer && idSoundSystemLocal::useOpenAL ) {
 		alGetError();
 		alDeleteBuffers( 1, &openalBuffer );
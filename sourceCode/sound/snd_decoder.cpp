@@ -26,6 +26,11 @@ static bool versioned = RegisterVersionedFile("$Id: snd_decoder.cpp 5171 2012-01
 #include "OggVorbis/vorbis/codec.h"
 #include "OggVorbis/vorbis/vorbisfile.h"
 
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
 
 /*
 ===================================================================================
@@ -264,6 +269,235 @@ int idWaveFile::CloseOGG( void ) {
 }
 
 
+/*
+===================================================================================
+
+  Decoded block cache.
+
+  Short OGG sounds are often retriggered while they are still in memory
+  compressed. Their decoded 44kHz data is kept in fixed size blocks which
+  are reused in least recently used order.
+
+  All access happens inside CRITICAL_SECTION_ONE.
+
+===================================================================================
+*/
+
+const int DECODED_BLOCK_SAMPLES				= 4096;		// 44kHz samples, all channels interleaved
+
+typedef struct decodedBlock_s {
+	idSoundSample *			sample;
+	int						block;
+	struct decodedBlock_s *	prev;				// least recently used list
+	struct decodedBlock_s *	next;
+} decodedBlock_t;
+
+class idDecodedBlockCache {
+public:
+							idDecodedBlockCache( void );
+
+	void					Init( int memorySize );
+	void					Shutdown( void );
+	bool					IsEnabled( void ) const { return numBlocks > 0; }
+
+	const float *			Find( const idSoundSample *sample, int block );
+	float *					Alloc( idSoundSample *sample, int block );
+	void					Free( const idSoundSample *sample, int block );
+	void					Purge( const idSoundSample *sample );
+
+	int						numHits;
+	int						numMisses;
+	int						numEvicted;
+
+private:
+	float *					memory;
+	decodedBlock_t *		blocks;
+	int						numBlocks;
+	int						numUsed;
+	decodedBlock_t			lru;				// lru.next is the most recently used block
+	idHashIndex				hash;
+
+	int						Key( const idSoundSample *sample, int block ) const { return (int)( (intptr_t)sample >> 4 ) + block * 5003; }
+	void					Unlink( decodedBlock_t *b );
+	void					LinkFront( decodedBlock_t *b );
+	void					Remove( decodedBlock_t *b );
+};
+
+/*
+====================
+idDecodedBlockCache::idDecodedBlockCache
+====================
+*/
+idDecodedBlockCache::idDecodedBlockCache( void ) {
+	memory = NULL;
+	blocks = NULL;
+	numBlocks = 0;
+	numUsed = 0;
+	lru.prev = lru.next = &lru;
+	numHits = numMisses = numEvicted = 0;
+}
+
+/*
+====================
+idDecodedBlockCache::Init
+====================
+*/
+void idDecodedBlockCache::Init( int memorySize ) {
+	Shutdown();
+
+	numBlocks = memorySize / ( DECODED_BLOCK_SAMPLES * sizeof( float ) );
+	if ( numBlocks <= 0 ) {
+		numBlocks = 0;
+		return;
+	}
+
+	memory = (float *)Mem_Alloc16( numBlocks * DECODED_BLOCK_SAMPLES * sizeof( float ) );
+	blocks = new decodedBlock_t[numBlocks];
+	memset( blocks, 0, numBlocks * sizeof( blocks[0] ) );
+
+	// the first Add allocates the hash, do it here since the sound thread must not allocate from the heap
+	hash.Clear( 1024, numBlocks );
+	hash.Add( 0, 0 );
+	hash.Remove( 0, 0 );
+}
+
+/*
+====================
+idDecodedBlockCache::Shutdown
+====================
+*/
+void idDecodedBlockCache::Shutdown( void ) {
+	Mem_Free16( memory );
+	delete[] blocks;
+	memory = NULL;
+	blocks = NULL;
+	numBlocks = 0;
+	numUsed = 0;
+	lru.prev = lru.next = &lru;
+	hash.Free();
+	numHits = numMisses = numEvicted = 0;
+}
+
+/*
+====================
+idDecodedBlockCache::Unlink
+====================
+*/
+void idDecodedBlockCache::Unlink( decodedBlock_t *b ) {
+	b->prev->next = b->next;
+	b->next->prev = b->prev;
+}
+
+/*
+====================
+idDecodedBlockCache::LinkFront
+====================
+*/
+void idDecodedBlockCache::LinkFront( decodedBlock_t *b ) {
+	b->prev = &lru;
+	b->next = lru.next;
+	lru.next->prev = b;
+	lru.next = b;
+}
+
+/*
+====================
+idDecodedBlockCache::Remove
+
+Moves the block to the back of the list so it is reused first
+====================
+*/
+void idDecodedBlockCache::Remove( decodedBlock_t *b ) {
+	const int index = b - blocks;
+	hash.Remove( Key( b->sample, b->block ), index );
+	b->sample = NULL;
+	Unlink( b );
+	b->prev = lru.prev;
+	b->next = &lru;
+	lru.prev->next = b;
+	lru.prev = b;
+}
+
+/*
+====================
+idDecodedBlockCache::Find
+====================
+*/
+const float *idDecodedBlockCache::Find( const idSoundSample *sample, int block ) {
+	if ( numBlocks == 0 ) {
+		return NULL;
+	}
+	for ( int i = hash.First( Key( sample, block ) ); i != -1; i = hash.Next( i ) ) {
+		decodedBlock_t *b = &blocks[i];
+		if ( b->sample == sample && b->block == block ) {
+			Unlink( b );
+			LinkFront( b );
+			numHits++;
+			return memory + i * DECODED_BLOCK_SAMPLES;
+		}
+	}
+	numMisses++;
+	return NULL;
+}
+
+/*
+====================
+idDecodedBlockCache::Alloc
+====================
+*/
+float *idDecodedBlockCache::Alloc( idSoundSample *sample, int block ) {
+	decodedBlock_t *b;
+
+	if ( numUsed < numBlocks ) {
+		b = &blocks[numUsed++];
+	} else {
+		b = lru.prev;
+		if ( b->sample != NULL ) {
+			hash.Remove( Key( b->sample, b->block ), b - blocks );
+			numEvicted++;
+		}
+		Unlink( b );
+	}
+
+	b->sample = sample;
+	b->block = block;
+	LinkFront( b );
+
+	const int index = b - blocks;
+	hash.Add( Key( sample, block ), index );
+	return memory + index * DECODED_BLOCK_SAMPLES;
+}
+
+/*
+====================
+idDecodedBlockCache::Free
+====================
+*/
+void idDecodedBlockCache::Free( const idSoundSample *sample, int block ) {
+	for ( int i = hash.First( Key( sample, block ) ); i != -1; i = hash.Next( i ) ) {
+		if ( blocks[i].sample == sample && blocks[i].block == block ) {
+			Remove( &blocks[i] );
+			return;
+		}
+	}
+}
+
+/*
+====================
+idDecodedBlockCache::Purge
+====================
+*/
+void idDecodedBlockCache::Purge( const idSoundSample *sample ) {
+	for ( int i = 0; i < numUsed; i++ ) {
+		if ( blocks[i].sample == sample ) {
+			Remove( &blocks[i] );
+		}
+	}
+}
+
+idDecodedBlockCache		decodedBlockCache;
+
+
 /*
 ===================================================================================
 
@@ -272,8 +506,14 @@ int idWaveFile::CloseOGG( void ) {
 ===================================================================================
 */
 
+const int DECODE_AHEAD_SAMPLES				= 16384;	// 44kHz samples decoded ahead for streamed sounds
+const int DECODE_AHEAD_CHUNK				= 2048;		// samples decoded at once by the decoder thread
+const int MAX_DECODE_AHEAD_DECODERS			= 32;		// further streams are decoded by the mixer
+
 class idSampleDecoderLocal : public idSampleDecoder {
 public:
+							idSampleDecoderLocal( void ) : ahead( NULL ) {}
+
 	virtual void			Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	virtual void			ClearDecoder( void );
 	virtual idSoundSample *	GetSample( void ) const;
@@ -282,6 +522,10 @@ public:
 	void					Clear( void );
 	int						DecodePCM( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	int						DecodeOGG( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
+	int						DecodeOGGCached( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
+	int						DecodeOGGAhead( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
+	bool					DecodeAhead( void );
+	void					StopDecodeAhead( void );
 
 private:
 	bool					failed;				// set if decoding failed
@@ -292,10 +536,91 @@ private:
 	idFile_Memory			file;				// encoded file in memory
 
 	OggVorbis_File			ogg;				// OggVorbis file
+
+	bool					decodingAhead;		// registered with the decoder thread
+	int						aheadOffset;		// 44kHz sample offset of the first decoded ahead sample
+	int						aheadCount;
+	int						aheadStart;			// first sample in the ring buffer
+	float *					ahead;				// DECODE_AHEAD_SAMPLES ring buffer from decodeAheadBuffers, only set while decoding ahead
 };
 
 idBlockAlloc<idSampleDecoderLocal, 64>		sampleDecoderAllocator;
 
+/*
+===================================================================================
+
+  Decoder thread.
+
+  Streamed OGG sounds are decoded ahead of the mixer into the ring buffer
+  of their decoder, the mixer only decodes itself if it gets ahead.
+
+===================================================================================
+*/
+
+static idStaticList<idSampleDecoderLocal *, MAX_DECODE_AHEAD_DECODERS>	decodeAheadDecoders;	// in CRITICAL_SECTION_ONE
+// the ring buffers have their own memory, so they never take decoder memory needed to open OggVorbis streams
+static float *						decodeAheadMemory = NULL;
+static idStaticList<float *, MAX_DECODE_AHEAD_DECODERS>	decodeAheadBuffers;		// free ring buffers, in CRITICAL_SECTION_ONE
+static boost::thread *				decodeThread = NULL;
+static boost::mutex					decodeThreadMutex;
+static boost::condition_variable	decodeThreadWork;
+static bool							decodeThreadSignaled = false;
+static bool							decodeThreadShutdown = false;
+
+static int							numAheadSamples = 0;		// samples handed out from the ring buffers
+static int							numDirectSamples = 0;		// samples of streamed sounds decoded by the mixer
+
+/*
+====================
+SignalDecodeThread
+====================
+*/
+static void SignalDecodeThread( void ) {
+	{
+		boost::mutex::scoped_lock lock( decodeThreadMutex );
+		decodeThreadSignaled = true;
+	}
+	decodeThreadWork.notify_one();
+}
+
+/*
+====================
+DecodeThread
+====================
+*/
+static void DecodeThread( void ) {
+	while( true ) {
+		{
+			boost::mutex::scoped_lock lock( decodeThreadMutex );
+			while( !decodeThreadSignaled && !decodeThreadShutdown ) {
+				decodeThreadWork.wait( lock );
+			}
+			if ( decodeThreadShutdown ) {
+				break;
+			}
+			decodeThreadSignaled = false;
+		}
+
+		// keep going while any ring buffer has room, the critical section is
+		// released after each chunk so the mixer is never held up for long
+		bool decoded = true;
+		while( decoded ) {
+			decoded = false;
+			for ( int i = 0; ; i++ ) {
+				Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+				if ( i >= decodeAheadDecoders.Num() ) {
+					Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+					break;
+				}
+				if ( decodeAheadDecoders[i]->DecodeAhead() ) {
+					decoded = true;
+				}
+				Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+			}
+		}
+	}
+}
+
 /*
 ====================
 idSampleDecoder::Init
@@ -305,6 +630,22 @@ void idSampleDecoder::Init( void ) {
 	decoderMemoryAllocator.Init();
 	decoderMemoryAllocator.SetLockMemory( true );
 	decoderMemoryAllocator.SetFixedBlocks( idSoundSystemLocal::s_realTimeDecoding.GetBool() ? 10 : 1 );
+
+	if ( idSoundSystemLocal::s_realTimeDecoding.GetBool() ) {
+		decodedBlockCache.Init( idSoundSystemLocal::s_decodeCacheSize.GetInteger() * 1024 * 1024 );
+
+		if ( idSoundSystemLocal::s_decodeAhead.GetBool() ) {
+			decodeAheadMemory = (float *)Mem_Alloc16( MAX_DECODE_AHEAD_DECODERS * DECODE_AHEAD_SAMPLES * sizeof( float ) );
+			decodeAheadBuffers.Clear();
+			for ( int i = 0; i < MAX_DECODE_AHEAD_DECODERS; i++ ) {
+				decodeAheadBuffers.Append( decodeAheadMemory + i * DECODE_AHEAD_SAMPLES );
+			}
+			decodeThreadSignaled = false;
+			decodeThreadShutdown = false;
+			decodeThread = new boost::thread( DecodeThread );
+		}
+	}
+	numAheadSamples = numDirectSamples = 0;
 }
 
 /*
@@ -313,6 +654,24 @@ idSampleDecoder::Shutdown
 ====================
 */
 void idSampleDecoder::Shutdown( void ) {
+	if ( decodeThread != NULL ) {
+		{
+			boost::mutex::scoped_lock lock( decodeThreadMutex );
+			decodeThreadShutdown = true;
+		}
+		decodeThreadWork.notify_one();
+		decodeThread->join();
+		delete decodeThread;
+		decodeThread = NULL;
+	}
+	decodeAheadDecoders.Clear();
+	decodeAheadBuffers.Clear();
+	if ( decodeAheadMemory != NULL ) {
+		Mem_Free16( decodeAheadMemory );
+		decodeAheadMemory = NULL;
+	}
+	decodedBlockCache.Shutdown();
+
 	decoderMemoryAllocator.Shutdown();
 	sampleDecoderAllocator.Shutdown();
 }
@@ -357,6 +716,44 @@ int idSampleDecoder::GetUsedBlockMemory( void ) {
 	return decoderMemoryAllocator.GetUsedBlockMemory();
 }
 
+/*
+====================
+idSampleDecoder::PurgeSample
+====================
+*/
+void idSampleDecoder::PurgeSample( idSoundSample *sample ) {
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+
+	decodedBlockCache.Purge( sample );
+
+	for ( int i = decodeAheadDecoders.Num() - 1; i >= 0; i-- ) {
+		if ( decodeAheadDecoders[i]->GetSample() == sample ) {
+			decodeAheadDecoders[i]->StopDecodeAhead();
+		}
+	}
+
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+}
+
+/*
+====================
+idSampleDecoder::PrintStats
+====================
+*/
+void idSampleDecoder::PrintStats( void ) {
+	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+
+	const int numBlocks = decodedBlockCache.numHits + decodedBlockCache.numMisses;
+	common->Printf( "decoded block cache: %d hits, %d misses (%d%%), %d evicted\n", decodedBlockCache.numHits, decodedBlockCache.numMisses,
+					numBlocks ? decodedBlockCache.numHits * 100 / numBlocks : 0, decodedBlockCache.numEvicted );
+
+	const int numSamples = numAheadSamples + numDirectSamples;
+	common->Printf( "%d streams decoded ahead: %d kSamples ahead, %d kSamples by the mixer (%d%%)\n", decodeAheadDecoders.Num(), numAheadSamples >> 10, numDirectSamples >> 10,
+					numSamples ? (int)( (float)numDirectSamples * 100.0f / numSamples ) : 0 );
+
+	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+}
+
 /*
 ====================
 idSampleDecoderLocal::Clear
@@ -368,6 +765,14 @@ void idSampleDecoderLocal::Clear( void ) {
 	lastSample = NULL;
 	lastSampleOffset = 0;
 	lastDecodeTime = 0;
+	decodingAhead = false;
+	aheadOffset = 0;
+	aheadCount = 0;
+	aheadStart = 0;
+	if ( ahead != NULL ) {
+		decodeAheadBuffers.Append( ahead );
+		ahead = NULL;
+	}
 }
 
 /*
@@ -378,6 +783,8 @@ idSampleDecoderLocal::ClearDecoder
 void idSampleDecoderLocal::ClearDecoder( void ) {
 	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
 
+	StopDecodeAhead();
+
 	switch( lastFormat ) {
 		case WAVE_FORMAT_TAG_PCM: {
 			break;
@@ -440,7 +847,14 @@ void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, i
 			break;
 		}
 		case WAVE_FORMAT_TAG_OGG: {
-			readSamples44k = DecodeOGG( sample, sampleOffset44k, sampleCount44k, dest );
+			if ( sampleCount44k >= sample->LengthIn44kHzSamples() ) {
+				// decoded in one go at load time
+				readSamples44k = DecodeOGG( sample, sampleOffset44k, sampleCount44k, dest );
+			} else if ( decodedBlockCache.IsEnabled() && sample->LengthIn44kHzSamples() <= idSoundSystemLocal::s_decodeCacheMaxLength.GetFloat() * PRIMARYFREQ * sample->objectInfo.nChannels ) {
+				readSamples44k = DecodeOGGCached( sample, sampleOffset44k, sampleCount44k, dest );
+			} else {
+				readSamples44k = DecodeOGGAhead( sample, sampleOffset44k, sampleCount44k, dest );
+			}
 			break;
 		}
 		default: {
@@ -563,3 +977,149 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 
 	return ( readSamples << shift );
 }
+
+/*
+====================
+idSampleDecoderLocal::DecodeOGGCached
+
+Copies the samples from the decoded block cache, missing blocks are decoded as a whole
+====================
+*/
+int idSampleDecoderLocal::DecodeOGGCached( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) {
+	const int length44k = sample->LengthIn44kHzSamples();
+	int readSamples44k = 0;
+
+	while( readSamples44k < sampleCount44k ) {
+		const int offset44k = sampleOffset44k + readSamples44k;
+		const int block = offset44k / DECODED_BLOCK_SAMPLES;
+		const int blockStart = block * DECODED_BLOCK_SAMPLES;
+		const int blockLength = Min( DECODED_BLOCK_SAMPLES, length44k - blockStart );
+		if ( blockLength <= 0 ) {
+			break;
+		}
+
+		const float *data = decodedBlockCache.Find( sample, block );
+		if ( data == NULL ) {
+			float *blockData = decodedBlockCache.Alloc( sample, block );
+			if ( DecodeOGG( sample, blockStart, blockLength, blockData ) < blockLength ) {
+				decodedBlockCache.Free( sample, block );
+				break;
+			}
+			data = blockData;
+		}
+
+		const int start = offset44k - blockStart;
+		const int num = Min( blockLength - start, sampleCount44k - readSamples44k );
+		SIMDProcessor->Memcpy( dest + readSamples44k, data + start, num * sizeof( float ) );
+		readSamples44k += num;
+	}
+
+	return readSamples44k;
+}
+
+/*
+====================
+idSampleDecoderLocal::DecodeOGGAhead
+
+Uses the samples decoded ahead by the decoder thread if they continue where the mixer left off
+====================
+*/
+int idSampleDecoderLocal::DecodeOGGAhead( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) {
+	int readSamples44k = 0;
+
+	if ( aheadCount > 0 && sample == lastSample && sampleOffset44k == aheadOffset ) {
+		readSamples44k = Min( sampleCount44k, aheadCount );
+		const int first = Min( readSamples44k, DECODE_AHEAD_SAMPLES - aheadStart );
+		SIMDProcessor->Memcpy( dest, ahead + aheadStart, first * sizeof( float ) );
+		if ( first < readSamples44k ) {
+			SIMDProcessor->Memcpy( dest + first, ahead, ( readSamples44k - first ) * sizeof( float ) );
+		}
+		aheadStart = ( aheadStart + readSamples44k ) % DECODE_AHEAD_SAMPLES;
+		aheadCount -= readSamples44k;
+		aheadOffset += readSamples44k;
+		numAheadSamples += readSamples44k;
+	}
+
+	if ( readSamples44k < sampleCount44k ) {
+		const int decoded = DecodeOGG( sample, sampleOffset44k + readSamples44k, sampleCount44k - readSamples44k, dest + readSamples44k );
+		readSamples44k += decoded;
+		numDirectSamples += decoded;
+		aheadOffset = sampleOffset44k + readSamples44k;
+		aheadCount = 0;
+		aheadStart = 0;
+	}
+
+	// the stream was opened by DecodeOGG, it is only decoded ahead if a ring buffer is free
+	if ( !decodingAhead && decodeThread != NULL && lastSample == sample && !failed && decodeAheadBuffers.Num() > 0 && decodeAheadDecoders.Num() < decodeAheadDecoders.Max() ) {
+		ahead = decodeAheadBuffers[decodeAheadBuffers.Num() - 1];
+		decodeAheadBuffers.RemoveIndex( decodeAheadBuffers.Num() - 1 );
+		decodeAheadDecoders.Append( this );
+		decodingAhead = true;
+	}
+
+	if ( decodingAhead && aheadCount < DECODE_AHEAD_SAMPLES - DECODE_AHEAD_CHUNK ) {
+		SignalDecodeThread();
+	}
+
+	return readSamples44k;
+}
+
+/*
+====================
+idSampleDecoderLocal::DecodeAhead
+
+Called by the decoder thread inside CRITICAL_SECTION_ONE, returns true if anything was decoded
+====================
+*/
+bool idSampleDecoderLocal::DecodeAhead( void ) {
+	float buffer[DECODE_AHEAD_CHUNK];
+
+	if ( failed || lastSample == NULL || lastFormat != WAVE_FORMAT_TAG_OGG ) {
+		return false;
+	}
+
+	// only continue the stream where it is, seeking is left to the mixer
+	const int end = aheadOffset + aheadCount;
+	const int shift = 22050 / lastSample->objectInfo.nSamplesPerSec;
+	if ( ( end >> shift ) != lastSampleOffset ) {
+		return false;
+	}
+
+	const int num = Min( Min( DECODE_AHEAD_CHUNK, DECODE_AHEAD_SAMPLES - aheadCount ), lastSample->LengthIn44kHzSamples() - end );
+	if ( num < DECODE_AHEAD_CHUNK && end + num < lastSample->LengthIn44kHzSamples() ) {
+		return false;
+	}
+	if ( num <= 0 ) {
+		return false;
+	}
+
+	const int decoded = DecodeOGG( lastSample, end, num, buffer );
+
+	const int tail = ( aheadStart + aheadCount ) % DECODE_AHEAD_SAMPLES;
+	const int first = Min( decoded, DECODE_AHEAD_SAMPLES - tail );
+	SIMDProcessor->Memcpy( ahead + tail, buffer, first * sizeof( float ) );
+	if ( first < decoded ) {
+		SIMDProcessor->Memcpy( ahead, buffer + first, ( decoded - first ) * sizeof( float ) );
+	}
+	aheadCount += decoded;
+
+	return ( decoded > 0 );
+}
+
+/*
+====================
+idSampleDecoderLocal::StopDecodeAhead
+====================
+*/
+void idSampleDecoderLocal::StopDecodeAhead( void ) {
+	if ( decodingAhead ) {
+		decodeAheadDecoders.Remove( this );
+		decodingAhead = false;
+	}
+	if ( ahead != NULL ) {
+		decodeAheadBuffers.Append( ahead );
+		ahead = NULL;
+	}
+	aheadCount = 0;
+	aheadStart = 0;
+}
@@ -175,6 +175,7 @@ void idSoundChannel::Clear( void ) {
 	for( j = 0; j < 6; j++ ) {
 		lastV[j] = 0.0f;
 	}
+	virtualVoice = false;
 	memset( &parms, 0, sizeof(parms) );
 
 	triggered = false;
@@ -53,6 +53,7 @@ typedef enum {
 } soundDemoCommand_t;
 
 const int SOUND_MAX_CHANNELS		= 8;
+const int SOUND_MAX_VOICES			= 2048;			// channels ranked per mix, any further channels are always mixed
 const int SOUND_DECODER_FREE_DELAY	= 1000 * MIXBUFFER_SAMPLES / USERCMD_MSEC;		// four seconds
 
 const int PRIMARYFREQ				= 44100;			// samples per second
@@ -411,6 +412,7 @@ public:
 	float				diversity;
 	float				lastVolume;				// last calculated volume based on distance
 	float				lastV[6];				// last calculated volume for each speaker, so we can smoothly fade
+	bool				virtualVoice;			// beyond the voice budget, the time advances but nothing is decoded or mixed
 	idSoundFade			channelFade;
 	bool				triggered;
 	ALuint				openalSource;
@@ -533,6 +535,7 @@ public:
 		missedWindow = 0;
 		missedUpdateWindow = 0;
 		activeSounds = 0;
+		virtualSounds = 0;
 	}
 	int		rinuse;
 	int		runs;
@@ -540,8 +543,20 @@ public:
 	int		missedWindow;
 	int		missedUpdateWindow;
 	int		activeSounds;
+	int		virtualSounds;		// channels skipped by the last mix because of s_maxVoices
 };
 
+typedef struct soundVoice_s {
+	idSoundEmitterLocal *	sound;
+	idSoundChannel *		chan;
+	float					rank;		// estimated loudness at the listener with the bonus for audible channels
+	// ChannelVolume results, reused when the channel is mixed
+	float					volume;
+	bool					global;
+	float					spatialize;
+	idVec3					spatializedOriginInMeters;
+} soundVoice_t;
+
 typedef struct soundPortalTrace_s {
 	int		portalArea;
 	const struct soundPortalTrace_s	*prevStack;
@@ -618,8 +633,11 @@ public:
 
 	idSoundEmitterLocal *	AllocLocalSoundEmitter();
 	void					CalcEars( int numSpeakers, idVec3 realOrigin, idVec3 listenerPos, idMat3 listenerAxis, float ears[6], float spatialize );
+	float					ChannelVolume( idSoundEmitterLocal *sound, idSoundChannel *chan, int current44kHz,
+												bool &global, float &spatialize, idVec3 &spatializedOriginInMeters );
 	void					AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
-												int current44kHz, int numSpeakers, float *finalMixBuffer );
+												int current44kHz, int numSpeakers, float *finalMixBuffer, bool fadeOut = false, const soundVoice_t *voice = NULL );
+	void					MixVoices( int current44kHz, int numSpeakers, float *finalMixBuffer );
 	void					MixLoop( int current44kHz, int numSpeakers, float *finalMixBuffer );
 	void					AVIUpdate( void );
 	bool					ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const float loss, const idVec3& soundOrigin, idSoundEmitterLocal *def , SoundChainResults *results); // grayman #3042
@@ -645,6 +663,8 @@ public:
 
 	idList<idSoundEmitterLocal *>emitters;
 
+	idStaticList<soundVoice_t, SOUND_MAX_VOICES> voices;	// playing channels of the current mix, loudest first
+
 	idSoundFade				soundClassFade[SOUND_MAX_CLASSES];	// for global sound fading
 
 	// avi stuff
@@ -806,6 +826,10 @@ public:
 	static idCVar			s_force22kHz;
 	static idCVar			s_clipVolumes;
 	static idCVar			s_realTimeDecoding;
+	static idCVar			s_decodeAhead;
+	static idCVar			s_decodeCacheSize;
+	static idCVar			s_decodeCacheMaxLength;
+	static idCVar			s_maxVoices;
 	static idCVar			s_libOpenAL;
 	static idCVar			s_useOpenAL;
 	static idCVar			s_useEAXReverb;
@@ -885,6 +909,9 @@ public:
 	static void				Free( idSampleDecoder *decoder );
 	static int				GetNumUsedBlocks( void );
 	static int				GetUsedBlockMemory( void );
+							// drops the cached blocks and the read ahead of a sample that is purged
+	static void				PurgeSample( idSoundSample *sample );
+	static void				PrintStats( void );
 
 	virtual					~idSampleDecoder( void ) {}
 	virtual void			Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) = 0;
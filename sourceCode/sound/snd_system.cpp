@@ -53,6 +53,10 @@ idCVar idSoundSystemLocal::s_numberOfSpeakers( "s_numberOfSpeakers", "2", CVAR_S
 idCVar idSoundSystemLocal::s_force22kHz( "s_force22kHz", "0", CVAR_SOUND | CVAR_BOOL, ""  );
 idCVar idSoundSystemLocal::s_clipVolumes( "s_clipVolumes", "1", CVAR_SOUND | CVAR_BOOL, ""  );
 idCVar idSoundSystemLocal::s_realTimeDecoding( "s_realTimeDecoding", "1", CVAR_SOUND | CVAR_BOOL | CVAR_INIT, "" );
+idCVar idSoundSystemLocal::s_decodeAhead( "s_decodeAhead", "1", CVAR_SOUND | CVAR_BOOL | CVAR_INIT, "decode streamed OGG sounds ahead of the mixer on a separate thread" );
+idCVar idSoundSystemLocal::s_decodeCacheSize( "s_decodeCacheSize", "8", CVAR_SOUND | CVAR_INTEGER | CVAR_INIT, "megabytes of decoded OGG blocks kept for short sounds, 0 = disabled", 0, 256 );
+idCVar idSoundSystemLocal::s_decodeCacheMaxLength( "s_decodeCacheMaxLength", "4", CVAR_SOUND | CVAR_FLOAT, "OGG sounds up to this many seconds long keep their decoded blocks in the cache, longer ones are decoded ahead" );
+idCVar idSoundSystemLocal::s_maxVoices( "s_maxVoices", "64", CVAR_SOUND | CVAR_ARCHIVE | CVAR_INTEGER, "number of channels the software mixer mixes, quieter channels keep playing silently until they are among the loudest again, 0 = no limit", 0, SOUND_MAX_VOICES );
 
 idCVar idSoundSystemLocal::s_slowAttenuate( "s_slowAttenuate", "1", CVAR_SOUND | CVAR_BOOL, "slowmo sounds attenuate over shorted distance" );
 idCVar idSoundSystemLocal::s_enviroSuitCutoffFreq( "s_enviroSuitCutoffFreq", "2000", CVAR_SOUND | CVAR_FLOAT, "" );
@@ -243,6 +247,8 @@ void ListSoundDecoders_f( const idCmdArgs &args ) {
 	common->Printf( "%d waiting decoders\n", numWaitingDecoders );
 	common->Printf( "%d active decoders\n", numActiveDecoders );
 	common->Printf( "%d kB decoder memory in %d blocks\n", idSampleDecoder::GetUsedBlockMemory() >> 10, idSampleDecoder::GetNumUsedBlocks() );
+	common->Printf( "%d channels mixed, %d virtual\n", soundSystemLocal.soundStats.activeSounds, soundSystemLocal.soundStats.virtualSounds );
+	idSampleDecoder::PrintStats();
 }
 
 /*
@@ -262,6 +268,105 @@ void TestSound_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+===============
+SoundBenchMix_f
+
+Times the software mixing path over a synthetic set of emitters without touching the sound
+hardware: every channel gathers a block of its samples into an aligned buffer and mixes it
+with ramped volumes into the speaker buffer, the buffer is then converted to 16 bit samples.
+Set com_forceGenericSIMD to compare against the generic code.
+
+  this is called from the main thread
+===============
+*/
+void SoundBenchMix_f( const idCmdArgs &args ) {
+	const int SOURCE_BLOCKS = 8;
+	int numEmitters, numSpeakers, numBlocks;
+	idRandom random;
+	idTimer timer;
+
+	if ( args.Argc() > 4 ) {
+		common->Printf( "Usage: s_benchMix [numEmitters] [numSpeakers] [numBlocks]\n" );
+		return;
+	}
+	numEmitters = ( args.Argc() > 1 ) ? idMath::ClampInt( 1, 1024, atoi( args.Argv( 1 ) ) ) : 64;
+	numSpeakers = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 2;
+	numBlocks = ( args.Argc() > 3 ) ? idMath::ClampInt( 1, 10000, atoi( args.Argv( 3 ) ) ) : 200;
+	if ( numSpeakers != 2 && numSpeakers != 6 ) {
+		common->Printf( "numSpeakers must be 2 or 6\n" );
+		return;
+	}
+
+	// every other emitter plays a stereo sample, the sources are a few blocks long so they don't sit in the cache
+	float *sources = (float *)Mem_Alloc16( SOURCE_BLOCKS * MIXBUFFER_SAMPLES * 2 * sizeof( float ) );
+	float *inputSamples = (float *)Mem_Alloc16( MIXBUFFER_SAMPLES * 2 * sizeof( float ) );
+	float *mixBuffer = (float *)Mem_Alloc16( MIXBUFFER_SAMPLES * 6 * sizeof( float ) );
+	short *outputSamples = (short *)Mem_Alloc16( MIXBUFFER_SAMPLES * 6 * sizeof( short ) );
+	float *volumes = (float *)Mem_Alloc( numEmitters * 6 * sizeof( float ) );
+
+	for ( int i = 0; i < SOURCE_BLOCKS * MIXBUFFER_SAMPLES * 2; i++ ) {
+		sources[i] = random.CRandomFloat() * 32767.0f;
+	}
+	for ( int i = 0; i < numEmitters * 6; i++ ) {
+		volumes[i] = random.RandomFloat();
+	}
+
+	timer.Start();
+	for ( int block = 0; block < numBlocks; block++ ) {
+		SIMDProcessor->Memset( mixBuffer, 0, MIXBUFFER_SAMPLES * numSpeakers * sizeof( float ) );
+
+		for ( int e = 0; e < numEmitters; e++ ) {
+			const bool stereo = ( e & 1 ) != 0;
+			const int numChannels = stereo ? 2 : 1;
+			const int sourceBlock = ( block + e ) % SOURCE_BLOCKS;
+			float *lastV = volumes + e * 6;
+			float currentV[6];
+
+			SIMDProcessor->Memcpy( inputSamples, sources + sourceBlock * MIXBUFFER_SAMPLES * 2, MIXBUFFER_SAMPLES * numChannels * sizeof( float ) );
+
+			for ( int i = 0; i < numSpeakers; i++ ) {
+				currentV[i] = idMath::ClampFloat( 0.0f, 1.0f, lastV[i] + random.CRandomFloat() * 0.1f );
+			}
+
+			if ( numSpeakers == 2 ) {
+				if ( stereo ) {
+					SIMDProcessor->MixSoundTwoSpeakerStereo( mixBuffer, inputSamples, MIXBUFFER_SAMPLES, lastV, currentV );
+				} else {
+					SIMDProcessor->MixSoundTwoSpeakerMono( mixBuffer, inputSamples, MIXBUFFER_SAMPLES, lastV, currentV );
+				}
+			} else {
+				if ( stereo ) {
+					SIMDProcessor->MixSoundSixSpeakerStereo( mixBuffer, inputSamples, MIXBUFFER_SAMPLES, lastV, currentV );
+				} else {
+					SIMDProcessor->MixSoundSixSpeakerMono( mixBuffer, inputSamples, MIXBUFFER_SAMPLES, lastV, currentV );
+				}
+			}
+
+			for ( int i = 0; i < numSpeakers; i++ ) {
+				lastV[i] = currentV[i];
+			}
+		}
+
+		SIMDProcessor->MixedSoundToSamples( outputSamples, mixBuffer, MIXBUFFER_SAMPLES * numSpeakers );
+	}
+	timer.Stop();
+
+	const double ms = timer.Milliseconds();
+	const double numFrames = (double)numBlocks * MIXBUFFER_SAMPLES;
+	const double audioMs = numFrames * 1000.0 / PRIMARYFREQ;
+
+	common->Printf( "%s: %d emitters, %d speakers, %d blocks\n", SIMDProcessor->GetName(), numEmitters, numSpeakers, numBlocks );
+	common->Printf( "%8.2f ms for %.0f ms of sound (%.2f%% of real time)\n", ms, audioMs, ms * 100.0 / audioMs );
+	common->Printf( "%8.2f ns per output sample, %.2f ns per channel sample\n", ms * 1e6 / numFrames, ms * 1e6 / ( numFrames * numEmitters ) );
+
+	Mem_Free( volumes );
+	Mem_Free16( outputSamples );
+	Mem_Free16( mixBuffer );
+	Mem_Free16( inputSamples );
+	Mem_Free16( sources );
+}
+
 /*
 ===============
 SoundSystemRestart_f
@@ -413,6 +518,7 @@ void idSoundSystemLocal::Init() {
 	cmdSystem->AddCommand( "reloadSounds", SoundReloadSounds_f, CMD_FL_SOUND|CMD_FL_CHEAT, "reloads all sounds" );
 	cmdSystem->AddCommand( "testSound", TestSound_f, CMD_FL_SOUND | CMD_FL_CHEAT, "tests a sound", idCmdSystem::ArgCompletion_SoundName );
 	cmdSystem->AddCommand( "s_restart", SoundSystemRestart_f, CMD_FL_SOUND, "restarts the sound system" );
+	cmdSystem->AddCommand( "s_benchMix", SoundBenchMix_f, CMD_FL_SOUND, "times the software sound mixing over synthetic emitters" );
 
 	common->Printf( "sound system initialized.\n" );
 	common->Printf( "--------------------------------------\n" );
@@ -594,6 +700,8 @@ int idSoundSystemLocal::AsyncMix( int soundTime, float *mixBuffer ) {
 		return 0;
 	}
 
+	PROFILE_ZONE( Sound_AsyncMix );
+
 	inTime = Sys_Milliseconds();
 	numSpeakers = snd_audio_hw->GetNumberOfSpeakers();
 	
@@ -619,6 +727,8 @@ int idSoundSystemLocal::AsyncUpdate( int inTime ) {
 		return 0;
 	}
 
+	PROFILE_ZONE( Sound_AsyncUpdate );
+
 	ulong dwCurrentWritePos;
 	dword dwCurrentBlock;
 
@@ -741,6 +851,8 @@ int idSoundSystemLocal::AsyncUpdateWrite( int inTime ) {
 		return 0;
 	}
 
+	PROFILE_ZONE( Sound_AsyncUpdateWrite );
+
 	if ( !useOpenAL ) {
 		snd_audio_hw->Flush();
 	}
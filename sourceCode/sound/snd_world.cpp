@@ -499,33 +499,143 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 		return;
 	}
 
-	for ( i = 1; i < emitters.Num(); i++ ) {
-		sound = emitters[i];
+	// OpenAL manages its own sources, the voice budget only applies to the software mixer
+	if ( !idSoundSystemLocal::useOpenAL && idSoundSystemLocal::s_maxVoices.GetInteger() > 0 ) {
+		MixVoices( current44kHz, numSpeakers, finalMixBuffer );
+	} else {
+		soundSystemLocal.soundStats.virtualSounds = 0;
 
-		if ( !sound ) {
-			continue;
+		for ( i = 1; i < emitters.Num(); i++ ) {
+			sound = emitters[i];
+
+			if ( !sound ) {
+				continue;
+			}
+			// if no channels are active, do nothing
+			if ( !sound->playing ) {
+				continue;
+			}
+			// run through all the channels
+			for ( j = 0; j < SOUND_MAX_CHANNELS ; j++ ) {
+				idSoundChannel	*chan = &sound->channels[j];
+
+				// see if we have a sound triggered on this channel
+				if ( !chan->triggerState ) {
+					chan->ALStop();
+					continue;
+				}
+
+				chan->virtualVoice = false;
+				AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+			}
 		}
-		// if no channels are active, do nothing
-		if ( !sound->playing ) {
+	}
+
+	if ( !idSoundSystemLocal::useOpenAL && enviroSuitActive ) {
+		soundSystemLocal.DoEnviroSuit( finalMixBuffer, MIXBUFFER_SAMPLES, numSpeakers );
+	}
+}
+
+/*
+===================
+SortVoicesByVolume
+===================
+*/
+static int SortVoicesByVolume( const void *a, const void *b ) {
+	const float volumeA = static_cast<const soundVoice_t *>( a )->rank;
+	const float volumeB = static_cast<const soundVoice_t *>( b )->rank;
+
+	if ( volumeA > volumeB ) {
+		return -1;
+	}
+	if ( volumeA < volumeB ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+===================
+idSoundWorldLocal::MixVoices
+
+Ranks all playing channels by their estimated loudness at the listener and only mixes the
+s_maxVoices loudest ones. The others become virtual: their play position keeps advancing
+with the sound time, but they are neither decoded nor mixed until they rank high enough
+again. Channels fade out over one block when they become virtual and fade back in when
+they resume, and currently mixed channels get a small bonus so that channels of similar
+loudness don't flip back and forth.
+
+this is called from the async thread
+===================
+*/
+void idSoundWorldLocal::MixVoices( int current44kHz, int numSpeakers, float *finalMixBuffer ) {
+	const float AUDIBLE_BONUS = 1.25f;		// about 2 dB
+	int i, j;
+
+	voices.Clear();
+
+	for ( i = 1; i < emitters.Num(); i++ ) {
+		idSoundEmitterLocal *sound = emitters[i];
+
+		if ( !sound || !sound->playing ) {
 			continue;
 		}
-		// run through all the channels
-		for ( j = 0; j < SOUND_MAX_CHANNELS ; j++ ) {
-			idSoundChannel	*chan = &sound->channels[j];
+		for ( j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			idSoundChannel *chan = &sound->channels[j];
 
-			// see if we have a sound triggered on this channel
 			if ( !chan->triggerState ) {
 				chan->ALStop();
 				continue;
 			}
 
-			AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+			// rank what fits, anything beyond that is mixed as before
+			if ( voices.Num() == voices.Max() ) {
+				chan->virtualVoice = false;
+				AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+				continue;
+			}
+
+			soundVoice_t *voice = voices.Alloc();
+			voice->sound = sound;
+			voice->chan = chan;
+			voice->volume = ChannelVolume( sound, chan, current44kHz, voice->global, voice->spatialize, voice->spatializedOriginInMeters );
+			voice->rank = voice->volume;
+			if ( !chan->virtualVoice ) {
+				voice->rank *= AUDIBLE_BONUS;
+			}
 		}
 	}
 
-	if ( !idSoundSystemLocal::useOpenAL && enviroSuitActive ) {
-		soundSystemLocal.DoEnviroSuit( finalMixBuffer, MIXBUFFER_SAMPLES, numSpeakers );
+	const int maxVoices = idSoundSystemLocal::s_maxVoices.GetInteger();
+	if ( voices.Num() > maxVoices ) {
+		qsort( voices.Ptr(), voices.Num(), sizeof( soundVoice_t ), SortVoicesByVolume );
 	}
+
+	int numVirtual = 0;
+	for ( i = 0; i < voices.Num(); i++ ) {
+		idSoundChannel *chan = voices[i].chan;
+
+		if ( i < maxVoices ) {
+			if ( chan->virtualVoice ) {
+				// resume from silence, the ramp of this block fades it back in
+				chan->virtualVoice = false;
+				chan->lastVolume = 0.0f;
+				for ( j = 0; j < 6; j++ ) {
+					chan->lastV[j] = 0.0f;
+				}
+			}
+			AddChannelContribution( voices[i].sound, chan, current44kHz, numSpeakers, finalMixBuffer, false, &voices[i] );
+		} else {
+			if ( !chan->virtualVoice ) {
+				// ramp down to zero over this block before going silent
+				AddChannelContribution( voices[i].sound, chan, current44kHz, numSpeakers, finalMixBuffer, true, &voices[i] );
+				chan->virtualVoice = true;
+			}
+			numVirtual++;
+		}
+	}
+
+	soundSystemLocal.soundStats.virtualSounds = numVirtual;
 }
 
 //==============================================================================
@@ -1687,19 +1797,15 @@ void idSoundWorldLocal::CalcEars( int numSpeakers, idVec3 spatializedOrigin, idV
 
 /*
 ===============
-idSoundWorldLocal::AddChannelContribution
+idSoundWorldLocal::ChannelVolume
 
-Adds the contribution of a single sound channel to finalMixBuffer
+Returns the volume of a channel at the listener before spatialization, including the
+distance falloff and the portal occlusion computed for the listener.
 this is called from the async thread
-
-Mixes MIXBUFFER_SAMPLES samples starting at current44kHz sample time into
-finalMixBuffer
 ===============
 */
-
-void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
-				   int current44kHz, int numSpeakers, float *finalMixBuffer ) {
-	int j;
+float idSoundWorldLocal::ChannelVolume( idSoundEmitterLocal *sound, idSoundChannel *chan, int current44kHz,
+				   bool &global, float &spatialize, idVec3 &spatializedOriginInMeters ) {
 	float volume;
 
 	//
@@ -1707,18 +1813,15 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 	//
 	soundShaderParms_t *parms = &chan->parms;
 
-	// assume we have a sound triggered on this channel
-	assert( chan->triggerState );
-
 	// fetch the actual wave file and see if it's valid
 	idSoundSample *sample = chan->leadinSample;
 	if ( sample == NULL ) {
-		return;
+		return 0.0f;
 	}
 
 	// if you don't want to hear all the beeps from missing sounds
 	if ( sample->defaultSound && !idSoundSystemLocal::s_playDefaultSound.GetBool() ) {
-		return;
+		return 0.0f;
 	}
 
 	// get the actual shader
@@ -1726,16 +1829,13 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 
 	// this might happen if the foreground thread just deleted the sound emitter
 	if ( !shader ) {
-		return;
+		return 0.0f;
 	}
 
 	float maxd = parms->maxDistance;
 	float mind = parms->minDistance;
 	
-	int  mask = shader->speakerMask;
-	bool omni = ( parms->soundShaderFlags & SSF_OMNIDIRECTIONAL) != 0;
-	bool looping = ( parms->soundShaderFlags & SSF_LOOPING ) != 0;
-	bool global = ( parms->soundShaderFlags & SSF_GLOBAL ) != 0;
+	global = ( parms->soundShaderFlags & SSF_GLOBAL ) != 0;
 	bool noOcclusion = ( parms->soundShaderFlags & SSF_NO_OCCLUSION ) || !idSoundSystemLocal::s_useOcclusion.GetBool();
 
 	// speed goes from 1 to 0.2
@@ -1743,11 +1843,6 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 		maxd *= slowmoSpeed;
 	}
 
-	// stereo samples are always omni
-	if ( sample->objectInfo.nChannels == 2 ) {
-		omni = true;
-	}
-
 	// if the sound is playing from the current listener, it will not be spatialized at all
 	if ( sound->listenerId == listenerPrivateId ) {
 		global = true;
@@ -1795,8 +1890,8 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 	// if it's a global sound then
 	// it's not affected by distance or occlusion
 	//
-	float	spatialize = 1;
-	idVec3 spatializedOriginInMeters;
+	spatialize = 1;
+	spatializedOriginInMeters.Zero();
 	if ( !global )
 	{
 		float dlen;
@@ -1850,6 +1945,88 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 		}
 	}
 
+	return volume;
+}
+
+/*
+===============
+idSoundWorldLocal::AddChannelContribution
+
+Adds the contribution of a single sound channel to finalMixBuffer
+this is called from the async thread
+
+Mixes MIXBUFFER_SAMPLES samples starting at current44kHz sample time into
+finalMixBuffer. With fadeOut the volume ramps down to zero over the block.
+A voice ranked by MixVoices passes its ChannelVolume results along.
+===============
+*/
+
+void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
+				   int current44kHz, int numSpeakers, float *finalMixBuffer, bool fadeOut, const soundVoice_t *voice ) {
+	int j;
+	float volume;
+
+	//
+	// get the sound definition and parameters from the entity
+	//
+	soundShaderParms_t *parms = &chan->parms;
+
+	// assume we have a sound triggered on this channel
+	assert( chan->triggerState );
+
+	// fetch the actual wave file and see if it's valid
+	idSoundSample *sample = chan->leadinSample;
+	if ( sample == NULL ) {
+		return;
+	}
+
+	// if you don't want to hear all the beeps from missing sounds
+	if ( sample->defaultSound && !idSoundSystemLocal::s_playDefaultSound.GetBool() ) {
+		return;
+	}
+
+	// get the actual shader
+	const idSoundShader *shader = chan->soundShader;
+
+	// this might happen if the foreground thread just deleted the sound emitter
+	if ( !shader ) {
+		return;
+	}
+
+	float maxd = parms->maxDistance;
+	float mind = parms->minDistance;
+	
+	int  mask = shader->speakerMask;
+	bool omni = ( parms->soundShaderFlags & SSF_OMNIDIRECTIONAL) != 0;
+	bool looping = ( parms->soundShaderFlags & SSF_LOOPING ) != 0;
+
+	// speed goes from 1 to 0.2
+	if ( idSoundSystemLocal::s_slowAttenuate.GetBool() && slowmoActive && !chan->disallowSlow ) {
+		maxd *= slowmoSpeed;
+	}
+
+	// stereo samples are always omni
+	if ( sample->objectInfo.nChannels == 2 ) {
+		omni = true;
+	}
+
+	bool global;
+	float spatialize;
+	idVec3 spatializedOriginInMeters;
+
+	// MixVoices already computed the volume for ranking
+	if ( voice ) {
+		volume = voice->volume;
+		global = voice->global;
+		spatialize = voice->spatialize;
+		spatializedOriginInMeters = voice->spatializedOriginInMeters;
+	} else {
+		volume = ChannelVolume( sound, chan, current44kHz, global, spatialize, spatializedOriginInMeters );
+	}
+	if ( fadeOut ) {
+		volume = 0.0f;
+	}
+
 	//
 	// do we have anything to add?
 	//